@@ -43,6 +43,13 @@
 #include <errno.h>
 #include <arpa/inet.h>
 #include <net/if.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <stdatomic.h>
+
+#ifdef __linux__
+#include <sys/timerfd.h>
+#endif
 
 netadr_t net_local_adr;
 
@@ -68,6 +75,44 @@ int ip6_sockets[2];
 int ipx_sockets[2];
 char *multicast_interface = NULL;
 
+/* Arrival time of the last packet returned by NET_GetPacket() */
+static int net_packettime;
+
+/* The optional I/O thread drains the server sockets as soon
+   as packets arrive and queues them into a single producer,
+   single consumer ring. The main thread pulls them out in
+   NET_GetPacket(). Bursts during long server frames end up
+   in the ring and not in the (small) kernel buffer and each
+   packet carries its real arrival time. */
+#define NET_IOQUEUE_SIZE 128 /* must be a power of two */
+
+typedef struct
+{
+	netadr_t from;
+	int time;
+	int datalen;
+	byte data[MAX_MSGLEN];
+} ioqueued_t;
+
+typedef struct
+{
+	ioqueued_t *packets;
+	atomic_uint head;           /* next slot written by the I/O thread */
+	atomic_uint tail;           /* next slot read by the main thread */
+	atomic_uint dropped;        /* packets lost due to a full ring */
+	atomic_int running;
+	sys_thread_t *thread;
+	int wakeup[2];              /* pipe, wakes NET_Sleep() */
+} ioqueue_t;
+
+static ioqueue_t net_ioqueue;
+static cvar_t *net_iothread;
+
+#ifdef __linux__
+/* deadline for NET_SleepUsec() */
+static int net_timerfd = -1;
+#endif
+
 static int NET_Socket(char *net_interface, int port, netsrc_t type, int family);
 static const char *NET_ErrorString(void);
 
@@ -512,6 +557,225 @@ NET_SendLoopPacket(netsrc_t sock, int length, void *data, netadr_t to)
 	loop->msgs[i].datalen = length;
 }
 
+/*
+ * Runs in the I/O thread. Must not call into the engine,
+ * errors are silently ignored since they're reported by
+ * the next NET_SendPacket() anyways.
+ */
+static void
+NET_IOThread(void *data)
+{
+	ioqueue_t *q = data;
+	struct pollfd fds[2];
+	struct sockaddr_storage from;
+	socklen_t fromlen;
+	byte discard[MAX_MSGLEN];
+	ioqueued_t *p;
+	unsigned head;
+	int i, ret, nfds, queued;
+
+	nfds = 0;
+
+	if (ip_sockets[NS_SERVER])
+	{
+		fds[nfds].fd = ip_sockets[NS_SERVER];
+		fds[nfds].events = POLLIN;
+		nfds++;
+	}
+
+	if (ip6_sockets[NS_SERVER])
+	{
+		fds[nfds].fd = ip6_sockets[NS_SERVER];
+		fds[nfds].events = POLLIN;
+		nfds++;
+	}
+
+	while (atomic_load_explicit(&q->running, memory_order_relaxed))
+	{
+		/* The timeout is only there to notice shutdowns */
+		if (poll(fds, nfds, 100) <= 0)
+		{
+			continue;
+		}
+
+		queued = 0;
+
+		for (i = 0; i < nfds; i++)
+		{
+			if (!(fds[i].revents & POLLIN))
+			{
+				continue;
+			}
+
+			while (1)
+			{
+				head = atomic_load_explicit(&q->head, memory_order_relaxed);
+
+				if (head - atomic_load_explicit(&q->tail, memory_order_acquire)
+						>= NET_IOQUEUE_SIZE)
+				{
+					/* Ring is full, drop the packet but keep
+					   draining the socket. */
+					if (recv(fds[i].fd, discard, sizeof(discard), 0) == -1)
+					{
+						break;
+					}
+
+					atomic_fetch_add_explicit(&q->dropped, 1, memory_order_relaxed);
+					continue;
+				}
+
+				p = &q->packets[head & (NET_IOQUEUE_SIZE - 1)];
+
+				fromlen = sizeof(from);
+				ret = recvfrom(fds[i].fd, p->data, sizeof(p->data), 0,
+						(struct sockaddr *)&from, &fromlen);
+
+				if (ret == -1)
+				{
+					break;
+				}
+
+				if (ret == sizeof(p->data))
+				{
+					continue; /* oversize */
+				}
+
+				SockadrToNetadr(&from, &p->from);
+				p->datalen = ret;
+				p->time = Sys_Milliseconds();
+
+				atomic_store_explicit(&q->head, head + 1, memory_order_release);
+				queued++;
+			}
+		}
+
+		if (queued)
+		{
+			/* Nonblocking, a full pipe is a pending wakeup anyways */
+			if (write(q->wakeup[1], "", 1) == -1)
+			{
+			}
+		}
+	}
+}
+
+static qboolean
+NET_IOThreadGetPacket(netadr_t *net_from, sizebuf_t *net_message)
+{
+	ioqueue_t *q = &net_ioqueue;
+	ioqueued_t *p;
+	unsigned tail;
+
+	tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+
+	if (tail == atomic_load_explicit(&q->head, memory_order_acquire))
+	{
+		return false;
+	}
+
+	p = &q->packets[tail & (NET_IOQUEUE_SIZE - 1)];
+
+	if (p->datalen > net_message->maxsize)
+	{
+		Com_Printf("Oversize packet from %s\n", NET_AdrToString(p->from));
+		atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+		return false;
+	}
+
+	memcpy(net_message->data, p->data, p->datalen);
+	net_message->cursize = p->datalen;
+	*net_from = p->from;
+	net_packettime = p->time;
+
+	atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+
+	return true;
+}
+
+static void
+NET_StopIOThread(void)
+{
+	ioqueue_t *q = &net_ioqueue;
+	unsigned dropped;
+
+	if (!q->thread)
+	{
+		return;
+	}
+
+	atomic_store(&q->running, 0);
+	Sys_WaitThread(q->thread);
+	q->thread = NULL;
+
+	close(q->wakeup[0]);
+	close(q->wakeup[1]);
+
+	dropped = atomic_load(&q->dropped);
+
+	if (dropped)
+	{
+		Com_Printf("I/O thread dropped %u packets\n", dropped);
+	}
+
+	free(q->packets);
+	q->packets = NULL;
+}
+
+static void
+NET_StartIOThread(void)
+{
+	ioqueue_t *q = &net_ioqueue;
+
+	if (q->thread || (!ip_sockets[NS_SERVER] && !ip6_sockets[NS_SERVER]))
+	{
+		return;
+	}
+
+	q->packets = malloc(NET_IOQUEUE_SIZE * sizeof(ioqueued_t));
+
+	if (!q->packets)
+	{
+		Com_Printf("%s: couldn't allocate packet queue\n", __func__);
+		return;
+	}
+
+	if (pipe(q->wakeup) == -1)
+	{
+		Com_Printf("%s: pipe: %s\n", __func__, NET_ErrorString());
+		free(q->packets);
+		q->packets = NULL;
+		return;
+	}
+
+	fcntl(q->wakeup[0], F_SETFL, fcntl(q->wakeup[0], F_GETFL, 0) | O_NONBLOCK);
+	fcntl(q->wakeup[1], F_SETFL, fcntl(q->wakeup[1], F_GETFL, 0) | O_NONBLOCK);
+
+	atomic_store(&q->head, 0);
+	atomic_store(&q->tail, 0);
+	atomic_store(&q->dropped, 0);
+	atomic_store(&q->running, 1);
+
+	q->thread = Sys_CreateThread(NET_IOThread, q);
+
+	if (!q->thread)
+	{
+		close(q->wakeup[0]);
+		close(q->wakeup[1]);
+		free(q->packets);
+		q->packets = NULL;
+		return;
+	}
+
+	Com_Printf("Network I/O thread started.\n");
+}
+
+int
+NET_PacketTime(void)
+{
+	return net_packettime;
+}
+
 qboolean
 NET_GetPacket(netsrc_t sock, netadr_t *net_from, sizebuf_t *net_message)
 {
@@ -522,11 +786,18 @@ NET_GetPacket(netsrc_t sock, netadr_t *net_from, sizebuf_t *net_message)
 	int protocol;
 	int err;
 
+	net_packettime = Sys_Milliseconds();
+
 	if (NET_GetLoopPacket(sock, net_from, net_message))
 	{
 		return true;
 	}
 
+	if ((sock == NS_SERVER) && net_ioqueue.thread)
+	{
+		return NET_IOThreadGetPacket(net_from, net_message);
+	}
+
 	for (protocol = 0; protocol < 3; protocol++)
 	{
 		if (protocol == 0)
@@ -765,6 +1036,13 @@ NET_OpenIP(void)
 		ip_sockets[NS_CLIENT] = NET_Socket(ip->string, PORT_ANY,
 				NS_CLIENT, AF_INET);
 	}
+
+	net_iothread = Cvar_Get("net_iothread", "0", CVAR_NOSET);
+
+	if (net_iothread->value)
+	{
+		NET_StartIOThread();
+	}
 }
 
 /*
@@ -777,6 +1055,9 @@ NET_Config(qboolean multiplayer)
 	{
 		int i;
 
+		/* the I/O thread polls the server sockets */
+		NET_StopIOThread();
+
 		/* shut down any existing sockets */
 		for (i = 0; i < 2; i++)
 		{
@@ -1015,11 +1296,134 @@ NET_Sleep(int msec)
 		FD_SET(0, &fdset); /* stdin is processed too */
 	}
 
-	FD_SET(ip_sockets[NS_SERVER], &fdset); /* IPv4 network socket */
-	FD_SET(ip6_sockets[NS_SERVER], &fdset); /* IPv6 network socket */
 	timeout.tv_sec = msec / 1000;
 	timeout.tv_usec = (msec % 1000) * 1000;
+
+	if (net_ioqueue.thread)
+	{
+		char buf[64];
+
+		/* the sockets belong to the I/O thread,
+		   it signals new packets through the pipe */
+		if (atomic_load(&net_ioqueue.head) != atomic_load(&net_ioqueue.tail))
+		{
+			return;
+		}
+
+		FD_SET(net_ioqueue.wakeup[0], &fdset);
+		select(net_ioqueue.wakeup[0] + 1, &fdset, NULL, NULL, &timeout);
+
+		while (read(net_ioqueue.wakeup[0], buf, sizeof(buf)) > 0)
+		{
+		}
+
+		return;
+	}
+
+	FD_SET(ip_sockets[NS_SERVER], &fdset); /* IPv4 network socket */
+	FD_SET(ip6_sockets[NS_SERVER], &fdset); /* IPv6 network socket */
 	select(MAX(ip_sockets[NS_SERVER],
 					ip6_sockets[NS_SERVER]) + 1, &fdset, NULL, NULL, &timeout);
 }
 
+/*
+ * Blocks until a packet arrives or usec microseconds are over.
+ * Used by the paced dedicated server loop, so the wakeup must be
+ * precise: on Linux the deadline is a timerfd, elsewhere the poll
+ * timeout is rounded up to the next millisecond. Returns false if
+ * there's nothing to wait for.
+ */
+qboolean
+NET_SleepUsec(int usec)
+{
+	struct pollfd fds[4];
+	int nfds, timeout;
+	char buf[64];
+	extern cvar_t *dedicated;
+	extern qboolean stdin_active;
+
+	if ((!ip_sockets[NS_SERVER] &&
+		 !ip6_sockets[NS_SERVER]) || (dedicated && !dedicated->value))
+	{
+		return false;
+	}
+
+	if (usec <= 0)
+	{
+		return true;
+	}
+
+	nfds = 0;
+
+	if (stdin_active)
+	{
+		fds[nfds].fd = 0; /* stdin is processed too */
+		fds[nfds++].events = POLLIN;
+	}
+
+	if (net_ioqueue.thread)
+	{
+		/* the sockets belong to the I/O thread,
+		   it signals new packets through the pipe */
+		if (atomic_load(&net_ioqueue.head) != atomic_load(&net_ioqueue.tail))
+		{
+			return true;
+		}
+
+		fds[nfds].fd = net_ioqueue.wakeup[0];
+		fds[nfds++].events = POLLIN;
+	}
+	else
+	{
+		if (ip_sockets[NS_SERVER])
+		{
+			fds[nfds].fd = ip_sockets[NS_SERVER];
+			fds[nfds++].events = POLLIN;
+		}
+
+		if (ip6_sockets[NS_SERVER])
+		{
+			fds[nfds].fd = ip6_sockets[NS_SERVER];
+			fds[nfds++].events = POLLIN;
+		}
+	}
+
+	timeout = (usec + 999) / 1000;
+
+#ifdef __linux__
+	if (net_timerfd == -1)
+	{
+		net_timerfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	}
+
+	if (net_timerfd != -1)
+	{
+		struct itimerspec deadline;
+
+		/* arming resets a pending expiration from the
+		   last call, if a packet was faster than it */
+		memset(&deadline, 0, sizeof(deadline));
+		deadline.it_value.tv_sec = usec / 1000000;
+		deadline.it_value.tv_nsec = (usec % 1000000) * 1000;
+
+		if (timerfd_settime(net_timerfd, 0, &deadline, NULL) == 0)
+		{
+			fds[nfds].fd = net_timerfd;
+			fds[nfds++].events = POLLIN;
+			timeout = -1;
+		}
+	}
+#endif
+
+	poll(fds, nfds, timeout);
+
+	if (net_ioqueue.thread)
+	{
+		while (read(net_ioqueue.wakeup[0], buf, sizeof(buf)) > 0)
+		{
+		}
+	}
+
+	return true;
+}
+
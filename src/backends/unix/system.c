@@ -34,6 +34,7 @@
 #include <time.h>
 #include <unistd.h>
 #include <errno.h>
+#include <pthread.h>
 #include <sys/stat.h>
 #include <sys/select.h> /* for fd_set */
 #ifndef FNDELAY
@@ -303,6 +304,154 @@ Sys_Nanosleep(int nanosec)
 
 /* ================================================================ */
 
+struct sys_thread_s
+{
+	pthread_t thread;
+	void (*func)(void *);
+	void *data;
+};
+
+static void *
+Sys_ThreadMain(void *arg)
+{
+	sys_thread_t *thread = arg;
+
+	thread->func(thread->data);
+
+	return NULL;
+}
+
+sys_thread_t *
+Sys_CreateThread(void (*func)(void *), void *data)
+{
+	sys_thread_t *thread;
+
+	thread = malloc(sizeof(*thread));
+
+	if (!thread)
+	{
+		return NULL;
+	}
+
+	thread->func = func;
+	thread->data = data;
+
+	if (pthread_create(&thread->thread, NULL, Sys_ThreadMain, thread))
+	{
+		Com_Printf("%s: pthread_create: %s\n", __func__, strerror(errno));
+		free(thread);
+		return NULL;
+	}
+
+	return thread;
+}
+
+void
+Sys_WaitThread(sys_thread_t *thread)
+{
+	if (!thread)
+	{
+		return;
+	}
+
+	pthread_join(thread->thread, NULL);
+	free(thread);
+}
+
+struct sys_mutex_s
+{
+	pthread_mutex_t mutex;
+};
+
+struct sys_cond_s
+{
+	pthread_cond_t cond;
+};
+
+sys_mutex_t *
+Sys_CreateMutex(void)
+{
+	sys_mutex_t *mutex;
+
+	mutex = malloc(sizeof(*mutex));
+
+	if (!mutex)
+	{
+		return NULL;
+	}
+
+	pthread_mutex_init(&mutex->mutex, NULL);
+
+	return mutex;
+}
+
+void
+Sys_DestroyMutex(sys_mutex_t *mutex)
+{
+	if (!mutex)
+	{
+		return;
+	}
+
+	pthread_mutex_destroy(&mutex->mutex);
+	free(mutex);
+}
+
+void
+Sys_LockMutex(sys_mutex_t *mutex)
+{
+	pthread_mutex_lock(&mutex->mutex);
+}
+
+void
+Sys_UnlockMutex(sys_mutex_t *mutex)
+{
+	pthread_mutex_unlock(&mutex->mutex);
+}
+
+sys_cond_t *
+Sys_CreateCond(void)
+{
+	sys_cond_t *cond;
+
+	cond = malloc(sizeof(*cond));
+
+	if (!cond)
+	{
+		return NULL;
+	}
+
+	pthread_cond_init(&cond->cond, NULL);
+
+	return cond;
+}
+
+void
+Sys_DestroyCond(sys_cond_t *cond)
+{
+	if (!cond)
+	{
+		return;
+	}
+
+	pthread_cond_destroy(&cond->cond);
+	free(cond);
+}
+
+void
+Sys_WaitCond(sys_cond_t *cond, sys_mutex_t *mutex)
+{
+	pthread_cond_wait(&cond->cond, &mutex->mutex);
+}
+
+void
+Sys_SignalCond(sys_cond_t *cond)
+{
+	pthread_cond_broadcast(&cond->cond);
+}
+
+/* ================================================================ */
+
 /* The musthave and canhave arguments are unused in YQ2. We
    can't remove them since Sys_FindFirst() and Sys_FindNext()
    are defined in shared.h and may be used in custom game DLLs. */
@@ -537,6 +537,15 @@ NET_SendLoopPacket(netsrc_t sock, int length, void *data, netadr_t to)
 
 /* ============================================================================= */
 
+/* Arrival time of the last packet returned by NET_GetPacket() */
+static int net_packettime;
+
+int
+NET_PacketTime(void)
+{
+	return net_packettime;
+}
+
 qboolean
 NET_GetPacket(netsrc_t sock, netadr_t *net_from, sizebuf_t *net_message)
 {
@@ -547,6 +556,8 @@ NET_GetPacket(netsrc_t sock, netadr_t *net_from, sizebuf_t *net_message)
 	int protocol;
 	int err;
 
+	net_packettime = Sys_Milliseconds();
+
 	if (NET_GetLoopPacket(sock, net_from, net_message))
 	{
 		return true;
@@ -1217,19 +1228,12 @@ NET_Config(qboolean multiplayer)
  * sleeps msec or until
  * net socket is ready
  */
-void
-NET_Sleep(int msec)
+static void
+NET_SleepTimeout(struct timeval *timeout)
 {
-	struct timeval timeout;
 	fd_set fdset;
-	extern cvar_t *dedicated;
 	int i;
 
-	if (!dedicated || !dedicated->value)
-	{
-		return; /* we're not a server, just run full speed */
-	}
-
 	FD_ZERO(&fdset);
 	i = 0;
 
@@ -1255,11 +1259,50 @@ NET_Sleep(int msec)
 		}
 	}
 
-	timeout.tv_sec = msec / 1000;
-	timeout.tv_usec = (msec % 1000) * 1000;
 	i = Q_max(ip_sockets[NS_SERVER], ip6_sockets[NS_SERVER]);
 	i = Q_max(i, ipx_sockets[NS_SERVER]);
-	select(i + 1, &fdset, NULL, NULL, &timeout);
+	select(i + 1, &fdset, NULL, NULL, timeout);
+}
+
+void
+NET_Sleep(int msec)
+{
+	struct timeval timeout;
+	extern cvar_t *dedicated;
+
+	if (!dedicated || !dedicated->value)
+	{
+		return; /* we're not a server, just run full speed */
+	}
+
+	timeout.tv_sec = msec / 1000;
+	timeout.tv_usec = (msec % 1000) * 1000;
+	NET_SleepTimeout(&timeout);
+}
+
+/*
+ * Like NET_Sleep(), but with microsecond precision. Returns
+ * false if it didn't block because there's nothing to wait for.
+ */
+qboolean
+NET_SleepUsec(int usec)
+{
+	struct timeval timeout;
+	extern cvar_t *dedicated;
+
+	if (!dedicated || !dedicated->value)
+	{
+		return false;
+	}
+
+	if (usec > 0)
+	{
+		timeout.tv_sec = usec / 1000000;
+		timeout.tv_usec = usec % 1000000;
+		NET_SleepTimeout(&timeout);
+	}
+
+	return true;
 }
 
 /* =================================================================== */
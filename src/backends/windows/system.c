@@ -318,6 +318,150 @@ Sys_Nanosleep(int nanosec)
 
 /* ================================================================ */
 
+struct sys_thread_s
+{
+	HANDLE thread;
+	void (*func)(void *);
+	void *data;
+};
+
+static DWORD WINAPI
+Sys_ThreadMain(LPVOID arg)
+{
+	sys_thread_t *thread = arg;
+
+	thread->func(thread->data);
+
+	return 0;
+}
+
+sys_thread_t *
+Sys_CreateThread(void (*func)(void *), void *data)
+{
+	sys_thread_t *thread;
+
+	thread = malloc(sizeof(*thread));
+
+	if (!thread)
+	{
+		return NULL;
+	}
+
+	thread->func = func;
+	thread->data = data;
+	thread->thread = CreateThread(NULL, 0, Sys_ThreadMain, thread, 0, NULL);
+
+	if (!thread->thread)
+	{
+		Com_Printf("%s: CreateThread failed: %lu\n", __func__, GetLastError());
+		free(thread);
+		return NULL;
+	}
+
+	return thread;
+}
+
+void
+Sys_WaitThread(sys_thread_t *thread)
+{
+	if (!thread)
+	{
+		return;
+	}
+
+	WaitForSingleObject(thread->thread, INFINITE);
+	CloseHandle(thread->thread);
+	free(thread);
+}
+
+struct sys_mutex_s
+{
+	CRITICAL_SECTION cs;
+};
+
+struct sys_cond_s
+{
+	CONDITION_VARIABLE cond;
+};
+
+sys_mutex_t *
+Sys_CreateMutex(void)
+{
+	sys_mutex_t *mutex;
+
+	mutex = malloc(sizeof(*mutex));
+
+	if (!mutex)
+	{
+		return NULL;
+	}
+
+	InitializeCriticalSection(&mutex->cs);
+
+	return mutex;
+}
+
+void
+Sys_DestroyMutex(sys_mutex_t *mutex)
+{
+	if (!mutex)
+	{
+		return;
+	}
+
+	DeleteCriticalSection(&mutex->cs);
+	free(mutex);
+}
+
+void
+Sys_LockMutex(sys_mutex_t *mutex)
+{
+	EnterCriticalSection(&mutex->cs);
+}
+
+void
+Sys_UnlockMutex(sys_mutex_t *mutex)
+{
+	LeaveCriticalSection(&mutex->cs);
+}
+
+sys_cond_t *
+Sys_CreateCond(void)
+{
+	sys_cond_t *cond;
+
+	cond = malloc(sizeof(*cond));
+
+	if (!cond)
+	{
+		return NULL;
+	}
+
+	InitializeConditionVariable(&cond->cond);
+
+	return cond;
+}
+
+void
+Sys_DestroyCond(sys_cond_t *cond)
+{
+	free(cond);
+}
+
+void
+Sys_WaitCond(sys_cond_t *cond, sys_mutex_t *mutex)
+{
+	SleepConditionVariableCS(&cond->cond, &mutex->cs, INFINITE);
+}
+
+void
+Sys_SignalCond(sys_cond_t *cond)
+{
+	WakeAllConditionVariable(&cond->cond);
+}
+
+/* ================================================================ */
+
 /* The musthave and canhave arguments are unused in YQ2. We
    can't remove them since Sys_FindFirst() and Sys_FindNext()
    are defined in shared.h and may be used in custom game DLLs. */
@@ -56,6 +56,7 @@ cvar_t *cl_laseralpha;
 cvar_t *cl_nodownload_list;
 
 cvar_t *cl_shownet;
+cvar_t *cl_compressframes;
 cvar_t *cl_showmiss;
 cvar_t *cl_showclamp;
 
@@ -165,19 +166,61 @@ CL_MaxClients(void)
 	return i <= 0 ? 1 : i;
 }
 
+static void
+CL_WriteDemoChunk(const byte *data, int len)
+{
+	int swlen;
+
+	if (len <= 0)
+	{
+		return;
+	}
+
+	swlen = LittleLong(len);
+	fwrite(&swlen, 4, 1, cls.demofile);
+	fwrite(data, len, 1, cls.demofile);
+}
+
 /*
- * Dumps the current net message, prefixed by the length
+ * Dumps the current net message, prefixed by the length.
+ * A compressed frame is written inflated, demos are
+ * played back without the dictionaries it needs.
  */
 void
 CL_WriteDemoMessage(void)
 {
-	int len, swlen;
+	int len, swlen, before, after;
 
 	/* the first eight bytes are just packet sequencing stuff */
-	len = net_message.cursize - 8;
+	if (!cls.demozframe)
+	{
+		len = net_message.cursize - 8;
+		swlen = LittleLong(len);
+		fwrite(&swlen, 4, 1, cls.demofile);
+		fwrite(net_message.data + 8, len, 1, cls.demofile);
+		return;
+	}
+
+	before = cls.demozframestart - 8;
+	after = net_message.cursize - cls.demozframeend;
+	len = before + cls.demozframesize + after;
+
+	/* playback sends each demo message as one packet, split
+	   it up between the commands if it doesn't fit. Each part
+	   fits, the frame is at most MAX_ZFRAME_SIZE. */
+	if (len > MAX_MSGLEN - PACKET_HEADER)
+	{
+		CL_WriteDemoChunk(net_message.data + 8, before);
+		CL_WriteDemoChunk(cls.demozframe, cls.demozframesize);
+		CL_WriteDemoChunk(net_message.data + cls.demozframeend, after);
+		return;
+	}
+
 	swlen = LittleLong(len);
 	fwrite(&swlen, 4, 1, cls.demofile);
-	fwrite(net_message.data + 8, len, 1, cls.demofile);
+	fwrite(net_message.data + 8, before, 1, cls.demofile);
+	fwrite(cls.demozframe, cls.demozframesize, 1, cls.demofile);
+	fwrite(net_message.data + cls.demozframeend, after, 1, cls.demofile);
 }
 
 /*
@@ -440,6 +483,11 @@ CL_ClearState(void)
 	memset(&cl, 0, sizeof(cl));
 	CL_ClearEntities();
 
+	/* a compressed frame that failed to
+	   parse leaves net_message pointing to it */
+	net_message.data = net_message_buffer;
+	net_message.maxsize = sizeof(net_message_buffer);
+
 	SZ_Clear(&cls.netchan.message);
 }
 
@@ -628,6 +676,7 @@ CL_InitLocal(void)
 	cl_run = Cvar_Get("cl_run", "0", CVAR_ARCHIVE);
 
 	cl_shownet = Cvar_Get("cl_shownet", "0", 0);
+	cl_compressframes = Cvar_Get("cl_compressframes", "1", CVAR_ARCHIVE);
 	cl_showmiss = Cvar_Get("cl_showmiss", "0", 0);
 	cl_showclamp = Cvar_Get("showclamp", "0", 0);
 	cl_timeout = Cvar_Get("cl_timeout", "120", 0);
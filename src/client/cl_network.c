@@ -131,8 +131,9 @@ CL_SendConnectPacket(void)
 
 	userinfo_modified = false;
 
-	Netchan_OutOfBandPrint(NS_CLIENT, adr, "connect %i %i %i \"%s\"\n",
-			PROTOCOL_VERSION, port, cls.challenge, Cvar_Userinfo());
+	Netchan_OutOfBandPrint(NS_CLIENT, adr, "connect %i %i %i \"%s\"%s fragments\n",
+			PROTOCOL_VERSION, port, cls.challenge, Cvar_Userinfo(),
+			cl_compressframes->value ? " zframe" : "");
 }
 
 /*
@@ -618,6 +619,14 @@ CL_ConnectionlessPacket(void)
 				Com_Printf("HTTP downloading supported by server but not the client.\n");
 #endif
 			}
+			else if (!strcmp(p, "zframe"))
+			{
+				Com_Printf("Server sends compressed frames.\n");
+			}
+			else if (!strcmp(p, "fragments"))
+			{
+				cls.netchan.fragments = true;
+			}
 		}
 
 		/* Put client into pause mode when connecting to a local server.
@@ -26,6 +26,7 @@
 
 #include "header/client.h"
 #include "input/header/input.h"
+#include "../common/unzip/miniz/miniz.h"
 
 static int bitcounts[32]; /* just for protocol profiling */
 
@@ -54,6 +55,7 @@ static const char *svc_strings[] = {
 	"svc_deltapacketentities",
 	"svc_frame",
 	"svc_fog",
+	"svc_zframe",
 };
 
 void
@@ -1037,6 +1039,99 @@ CL_ParseFrame(void)
 	}
 }
 
+/*
+ * Inflates a compressed frame and parses it like a plain
+ * one. The server may have primed the compressor with the
+ * tail of an older compressed frame, we keep them around.
+ */
+static void
+CL_ParseZFrame(void)
+{
+	static byte data[ZFRAME_DICT_SIZE + MAX_ZFRAME_SIZE];
+	static tinfl_decompressor inflator;
+	int dictframe, size, csize, dictlen, slot, cmd, len;
+	size_t inlen, outlen;
+	tinfl_status status;
+	sizebuf_t saved;
+	byte *in, *out;
+
+	/* the command byte was read already */
+	cls.demozframestart = net_message.readcount - 1;
+
+	dictframe = MSG_ReadLong(&net_message);
+	size = MSG_ReadLong(&net_message);
+	csize = MSG_ReadShort(&net_message);
+
+	if ((size <= 0) || (size > MAX_ZFRAME_SIZE) || (csize <= 0) ||
+		(net_message.readcount + csize > net_message.cursize))
+	{
+		Com_Error(ERR_DROP, "%s: bad compressed frame", __func__);
+		return;
+	}
+
+	in = net_message.data + net_message.readcount;
+	net_message.readcount += csize;
+
+	dictlen = 0;
+
+	if (dictframe > 0)
+	{
+		slot = dictframe & UPDATE_MASK;
+
+		if (cl.zframe_dictframe[slot] != dictframe)
+		{
+			/* we acknowledged it, so this shouldn't happen */
+			Com_Printf("Compressed frame dictionary too old.\n");
+			return;
+		}
+
+		dictlen = cl.zframe_dictlen[slot];
+		memcpy(data, cl.zframe_dict[slot], dictlen);
+	}
+
+	/* the dictionary is in front of the output,
+	   so back references can reach it */
+	tinfl_init(&inflator);
+	out = data + dictlen;
+	inlen = csize;
+	outlen = sizeof(data) - dictlen;
+
+	status = tinfl_decompress(&inflator, in, &inlen, data, out,
+			&outlen, TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF);
+
+	if ((status != TINFL_STATUS_DONE) || (outlen != size))
+	{
+		Com_Printf("Couldn't inflate compressed frame.\n");
+		return;
+	}
+
+	saved = net_message;
+	SZ_Init(&net_message, out, size);
+	net_message.cursize = size;
+
+	cmd = MSG_ReadByte(&net_message);
+	CL_ShowNetCmd(cmd);
+
+	if (cmd != svc_frame)
+	{
+		Com_Error(ERR_DROP, "%s: 0x%X not frame", __func__, cmd);
+		return;
+	}
+
+	CL_ParseFrame();
+	net_message = saved;
+
+	cls.demozframe = out;
+	cls.demozframesize = size;
+	cls.demozframeend = net_message.readcount;
+
+	slot = cl.frame.serverframe & UPDATE_MASK;
+	len = size < ZFRAME_DICT_SIZE ? size : ZFRAME_DICT_SIZE;
+	memcpy(cl.zframe_dict[slot], out + size - len, len);
+	cl.zframe_dictlen[slot] = len;
+	cl.zframe_dictframe[slot] = cl.frame.serverframe;
+}
+
 static const char *
 CL_GetProtocolName(int protocol)
 {
@@ -1566,6 +1661,8 @@ CL_ParseServerMessage(void)
 	char *s;
 	int i;
 
+	cls.demozframe = NULL;
+
 	/* if recording demos, copy the message out */
 	if (cl_shownet->value == 1)
 	{
@@ -1690,6 +1787,10 @@ CL_ParseServerMessage(void)
 				CL_ParseFrame();
 				break;
 
+			case svc_zframe:
+				CL_ParseZFrame();
+				break;
+
 			case svc_inventory:
 				CL_ParseInventory();
 				break;
@@ -135,6 +135,12 @@ typedef struct
 	int			surpressCount; /* number of messages rate supressed */
 	frame_t		frames[UPDATE_BACKUP];
 
+	/* tails of the compressed frames, the server
+	   may use them as dictionary for the next ones */
+	byte		zframe_dict[UPDATE_BACKUP][ZFRAME_DICT_SIZE];
+	int			zframe_dictlen[UPDATE_BACKUP];
+	int			zframe_dictframe[UPDATE_BACKUP];
+
 	/* the client maintains its own idea of view angles, which are
 	   sent to the server each frame.  It is cleared to 0 upon entering each level.
 	   the server sends a delta each frame which is added to the locally
@@ -250,6 +256,12 @@ typedef struct
 	qboolean	demowaiting; /* don't record until a non-delta message is received */
 	FILE		*demofile;
 
+	/* the svc_zframe of the current message, demos get the
+	   inflated svc_frame in place of net_message[start, end) */
+	byte		*demozframe;
+	int			demozframesize;
+	int			demozframestart, demozframeend;
+
 #ifdef USE_CURL
 	/* http downloading */
 	dlqueue_t  downloadQueue; /* queues with files to download. */
@@ -292,6 +304,7 @@ extern	cvar_t	*cl_pitchspeed;
 extern	cvar_t	*cl_run;
 extern	cvar_t	*cl_anglespeedkey;
 extern	cvar_t	*cl_shownet;
+extern	cvar_t	*cl_compressframes;
 extern	cvar_t	*cl_showmiss;
 extern	cvar_t	*cl_showclamp;
 extern	cvar_t	*lookstrafe;
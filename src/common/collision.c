@@ -140,14 +140,30 @@ static cvar_t *r_game;
 static int box_headnode;
 static int checkcount;
 static int floodvalid;
-static int leaf_topnode;
-static int trace_contents;
 static mapsurface_t nullsurface;
-static qboolean trace_ispoint; /* optimized case */
-static trace_t trace_trace;
-static vec3_t trace_start, trace_end;
-static vec3_t trace_mins, trace_maxs;
-static vec3_t trace_extents;
+
+/* brushes a reentrant trace remembers as checked,
+   it checks them again if there are more */
+#define TRACE_CHECKED_SIZE 128 /* power of two */
+#define TRACE_CHECKED_MAX 96
+
+/* State of one trace. It lives on the stack, so
+   CM_BoxTraceReentrant() can run on several threads. */
+typedef struct
+{
+	vec3_t start, end;
+	vec3_t mins, maxs;
+	vec3_t extents;
+	trace_t trace;
+	int contents;
+	qboolean ispoint; /* optimized case */
+
+	/* reentrant traces can't mark the brushes with
+	   checkcount, they keep the checked ones here */
+	qboolean reentrant;
+	int numchecked;
+	int checked[TRACE_CHECKED_SIZE];
+} tracework_t;
 
 #ifndef DEDICATED_ONLY
 int		c_pointcontents;
@@ -529,7 +545,7 @@ CM_PointLeafnum(vec3_t p)
  */
 static void
 CM_BoxLeafnums_r(int nodenum, vec3_t leaf_mins, vec3_t leaf_maxs,
-	int *leaf_list, int *leaf_count, int leaf_maxcount)
+	int *leaf_list, int *leaf_count, int leaf_maxcount, int *leaf_topnode)
 {
 	while (1)
 	{
@@ -568,13 +584,13 @@ CM_BoxLeafnums_r(int nodenum, vec3_t leaf_mins, vec3_t leaf_maxs,
 		else
 		{
 			/* go down both */
-			if (leaf_topnode == -1)
+			if (*leaf_topnode == -1)
 			{
-				leaf_topnode = nodenum;
+				*leaf_topnode = nodenum;
 			}
 
 			CM_BoxLeafnums_r(node->children[0], leaf_mins, leaf_maxs, leaf_list,
-				leaf_count, leaf_maxcount);
+				leaf_count, leaf_maxcount, leaf_topnode);
 			nodenum = node->children[1];
 		}
 	}
@@ -585,11 +601,10 @@ CM_BoxLeafnums_headnode(vec3_t leaf_mins, vec3_t leaf_maxs, int *leaf_list,
 		int leaf_maxcount, int headnode, int *topnode)
 {
 	int leaf_count = 0;
-
-	leaf_topnode = -1;
+	int leaf_topnode = -1;
 
 	CM_BoxLeafnums_r(headnode, leaf_mins, leaf_maxs, leaf_list,
-		&leaf_count, leaf_maxcount);
+		&leaf_count, leaf_maxcount, &leaf_topnode);
 
 	if (topnode)
 	{
@@ -666,7 +681,7 @@ CM_TransformedPointContents(vec3_t p, int headnode,
 
 static void
 CM_ClipBoxToBrush(vec3_t mins, vec3_t maxs, vec3_t p1,
-		vec3_t p2, trace_t *trace, const cbrush_t *brush)
+		vec3_t p2, trace_t *trace, const cbrush_t *brush, qboolean ispoint)
 {
 	cbrushside_t *side, *leadside;
 	float enterfrac, leavefrac;
@@ -688,10 +703,6 @@ CM_ClipBoxToBrush(vec3_t mins, vec3_t maxs, vec3_t p1,
 		return;
 	}
 
-#ifndef DEDICATED_ONLY
-	c_brush_traces++;
-#endif
-
 	getout = false;
 	startout = false;
 	leadside = NULL;
@@ -708,7 +719,7 @@ CM_ClipBoxToBrush(vec3_t mins, vec3_t maxs, vec3_t p1,
 		side = &cmod->map_brushsides[brush->firstbrushside + i];
 		plane = side->plane;
 
-		if (!trace_ispoint)
+		if (!ispoint)
 		{
 			/* general box case
 			   push the plane out
@@ -883,8 +894,51 @@ CM_TestBoxInBrush(vec3_t mins, vec3_t maxs, vec3_t p1,
 	trace->contents = brush->contents;
 }
 
+/*
+ * Returns true if the brush was checked by this
+ * trace already, otherwise it's marked as checked.
+ */
+static qboolean
+CM_BrushChecked(tracework_t *tw, int brushnum, cbrush_t *b)
+{
+	int i;
+
+	if (!tw->reentrant)
+	{
+		if (b->checkcount == checkcount)
+		{
+			return true;
+		}
+
+		b->checkcount = checkcount;
+		return false;
+	}
+
+	i = brushnum & (TRACE_CHECKED_SIZE - 1);
+
+	while (tw->checked[i] != -1)
+	{
+		if (tw->checked[i] == brushnum)
+		{
+			return true;
+		}
+
+		i = (i + 1) & (TRACE_CHECKED_SIZE - 1);
+	}
+
+	/* when it's full, brushes are just checked again,
+	   that doesn't change the result */
+	if (tw->numchecked < TRACE_CHECKED_MAX)
+	{
+		tw->checked[i] = brushnum;
+		tw->numchecked++;
+	}
+
+	return false;
+}
+
 static void
-CM_TraceToLeaf(int leafnum)
+CM_TraceToLeaf(tracework_t *tw, int leafnum)
 {
 	const cleaf_t *leaf;
 	int k, maxleaf;
@@ -896,7 +950,7 @@ CM_TraceToLeaf(int leafnum)
 
 	leaf = &cmod->map_leafs[leafnum];
 
-	if (!(leaf->contents & trace_contents) || !cmod->numleafbrushes)
+	if (!(leaf->contents & tw->contents) || !cmod->numleafbrushes)
 	{
 		return;
 	}
@@ -925,22 +979,27 @@ CM_TraceToLeaf(int leafnum)
 
 		b = &cmod->map_brushes[brushnum];
 
-		if (b->checkcount == checkcount)
+		if (CM_BrushChecked(tw, brushnum, b))
 		{
 			continue; /* already checked this brush in another leaf */
 		}
 
-		b->checkcount = checkcount;
-
-		if (!(b->contents & trace_contents))
+		if (!(b->contents & tw->contents))
 		{
 			continue;
 		}
 
-		CM_ClipBoxToBrush(trace_mins, trace_maxs, trace_start,
-				trace_end, &trace_trace, b);
+#ifndef DEDICATED_ONLY
+		if (!tw->reentrant)
+		{
+			c_brush_traces++;
+		}
+#endif
+
+		CM_ClipBoxToBrush(tw->mins, tw->maxs, tw->start,
+				tw->end, &tw->trace, b, tw->ispoint);
 
-		if (!trace_trace.fraction)
+		if (!tw->trace.fraction)
 		{
 			return;
 		}
@@ -948,7 +1007,7 @@ CM_TraceToLeaf(int leafnum)
 }
 
 static void
-CM_TestInLeaf(int leafnum)
+CM_TestInLeaf(tracework_t *tw, int leafnum)
 {
 	const cleaf_t *leaf;
 	int k, maxleaf;
@@ -960,7 +1019,7 @@ CM_TestInLeaf(int leafnum)
 
 	leaf = &cmod->map_leafs[leafnum];
 
-	if (!(leaf->contents & trace_contents) || !cmod->numleafbrushes)
+	if (!(leaf->contents & tw->contents) || !cmod->numleafbrushes)
 	{
 		return;
 	}
@@ -989,21 +1048,19 @@ CM_TestInLeaf(int leafnum)
 
 		b = &cmod->map_brushes[brushnum];
 
-		if (b->checkcount == checkcount)
+		if (CM_BrushChecked(tw, brushnum, b))
 		{
 			continue; /* already checked this brush in another leaf */
 		}
 
-		b->checkcount = checkcount;
-
-		if (!(b->contents & trace_contents))
+		if (!(b->contents & tw->contents))
 		{
 			continue;
 		}
 
-		CM_TestBoxInBrush(trace_mins, trace_maxs, trace_start, &trace_trace, b);
+		CM_TestBoxInBrush(tw->mins, tw->maxs, tw->start, &tw->trace, b);
 
-		if (!trace_trace.fraction)
+		if (!tw->trace.fraction)
 		{
 			return;
 		}
@@ -1011,7 +1068,8 @@ CM_TestInLeaf(int leafnum)
 }
 
 static void
-CM_RecursiveHullCheck(int num, float p1f, float p2f, const vec3_t p1, const vec3_t p2)
+CM_RecursiveHullCheck(tracework_t *tw, int num, float p1f, float p2f,
+		const vec3_t p1, const vec3_t p2)
 {
 	cnode_t *node;
 	cplane_t *plane;
@@ -1023,7 +1081,7 @@ CM_RecursiveHullCheck(int num, float p1f, float p2f, const vec3_t p1, const vec3
 	int side;
 	float midf;
 
-	if (trace_trace.fraction <= p1f)
+	if (tw->trace.fraction <= p1f)
 	{
 		return; /* already hit something nearer */
 	}
@@ -1031,7 +1089,7 @@ CM_RecursiveHullCheck(int num, float p1f, float p2f, const vec3_t p1, const vec3
 	/* if < 0, we are in a leaf node */
 	if (num < 0)
 	{
-		CM_TraceToLeaf(-1 - num);
+		CM_TraceToLeaf(tw, -1 - num);
 		return;
 	}
 
@@ -1050,7 +1108,7 @@ CM_RecursiveHullCheck(int num, float p1f, float p2f, const vec3_t p1, const vec3
 	{
 		t1 = p1[plane->type] - plane->dist;
 		t2 = p2[plane->type] - plane->dist;
-		offset = trace_extents[plane->type];
+		offset = tw->extents[plane->type];
 	}
 
 	else
@@ -1058,29 +1116,29 @@ CM_RecursiveHullCheck(int num, float p1f, float p2f, const vec3_t p1, const vec3
 		t1 = DotProduct(plane->normal, p1) - plane->dist;
 		t2 = DotProduct(plane->normal, p2) - plane->dist;
 
-		if (trace_ispoint)
+		if (tw->ispoint)
 		{
 			offset = 0;
 		}
 
 		else
 		{
-			offset = (float)fabs(trace_extents[0] * plane->normal[0]) +
-					 (float)fabs(trace_extents[1] * plane->normal[1]) +
-					 (float)fabs(trace_extents[2] * plane->normal[2]);
+			offset = (float)fabs(tw->extents[0] * plane->normal[0]) +
+					 (float)fabs(tw->extents[1] * plane->normal[1]) +
+					 (float)fabs(tw->extents[2] * plane->normal[2]);
 		}
 	}
 
 	/* see which sides we need to consider */
 	if ((t1 >= offset) && (t2 >= offset))
 	{
-		CM_RecursiveHullCheck(node->children[0], p1f, p2f, p1, p2);
+		CM_RecursiveHullCheck(tw, node->children[0], p1f, p2f, p1, p2);
 		return;
 	}
 
 	if ((t1 < -offset) && (t2 < -offset))
 	{
-		CM_RecursiveHullCheck(node->children[1], p1f, p2f, p1, p2);
+		CM_RecursiveHullCheck(tw, node->children[1], p1f, p2f, p1, p2);
 		return;
 	}
 
@@ -1126,7 +1184,7 @@ CM_RecursiveHullCheck(int num, float p1f, float p2f, const vec3_t p1, const vec3
 		mid[i] = p1[i] + frac * (p2[i] - p1[i]);
 	}
 
-	CM_RecursiveHullCheck(node->children[side], p1f, midf, p1, mid);
+	CM_RecursiveHullCheck(tw, node->children[side], p1f, midf, p1, mid);
 
 	/* go past the node */
 	if (frac2 < 0)
@@ -1146,34 +1204,28 @@ CM_RecursiveHullCheck(int num, float p1f, float p2f, const vec3_t p1, const vec3
 		mid[i] = p1[i] + frac2 * (p2[i] - p1[i]);
 	}
 
-	CM_RecursiveHullCheck(node->children[side ^ 1], midf, p2f, mid, p2);
+	CM_RecursiveHullCheck(tw, node->children[side ^ 1], midf, p2f, mid, p2);
 }
 
-trace_t
-CM_BoxTrace(const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_t maxs,
-		int headnode, int brushmask)
+static void
+CM_TraceWork(tracework_t *tw, const vec3_t start, const vec3_t end,
+		const vec3_t mins, const vec3_t maxs, int headnode, int brushmask)
 {
-	checkcount++; /* for multi-check avoidance */
-
-#ifndef DEDICATED_ONLY
-	c_traces++; /* for statistics, may be zeroed */
-#endif
-
 	/* fill in a default trace */
-	memset(&trace_trace, 0, sizeof(trace_trace));
-	trace_trace.fraction = 1;
-	trace_trace.surface = &(nullsurface.c);
+	memset(&tw->trace, 0, sizeof(tw->trace));
+	tw->trace.fraction = 1;
+	tw->trace.surface = &(nullsurface.c);
 
 	if (!cmod->numnodes)  /* map not loaded */
 	{
-		return trace_trace;
+		return;
 	}
 
-	trace_contents = brushmask;
-	VectorCopy(start, trace_start);
-	VectorCopy(end, trace_end);
-	VectorCopy(mins, trace_mins);
-	VectorCopy(maxs, trace_maxs);
+	tw->contents = brushmask;
+	VectorCopy(start, tw->start);
+	VectorCopy(end, tw->end);
+	VectorCopy(mins, tw->mins);
+	VectorCopy(maxs, tw->maxs);
 
 	/* check for position test special case */
 	if ((start[0] == end[0]) && (start[1] == end[1]) && (start[2] == end[2]))
@@ -1197,40 +1249,40 @@ CM_BoxTrace(const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_
 
 		for (i = 0; i < numleafs; i++)
 		{
-			CM_TestInLeaf(leafs[i]);
+			CM_TestInLeaf(tw, leafs[i]);
 
-			if (trace_trace.allsolid)
+			if (tw->trace.allsolid)
 			{
 				break;
 			}
 		}
 
-		VectorCopy(start, trace_trace.endpos);
-		return trace_trace;
+		VectorCopy(start, tw->trace.endpos);
+		return;
 	}
 
 	/* check for point special case */
 	if ((mins[0] == 0) && (mins[1] == 0) && (mins[2] == 0) &&
 		(maxs[0] == 0) && (maxs[1] == 0) && (maxs[2] == 0))
 	{
-		trace_ispoint = true;
-		VectorClear(trace_extents);
+		tw->ispoint = true;
+		VectorClear(tw->extents);
 	}
 
 	else
 	{
-		trace_ispoint = false;
-		trace_extents[0] = -mins[0] > maxs[0] ? -mins[0] : maxs[0];
-		trace_extents[1] = -mins[1] > maxs[1] ? -mins[1] : maxs[1];
-		trace_extents[2] = -mins[2] > maxs[2] ? -mins[2] : maxs[2];
+		tw->ispoint = false;
+		tw->extents[0] = -mins[0] > maxs[0] ? -mins[0] : maxs[0];
+		tw->extents[1] = -mins[1] > maxs[1] ? -mins[1] : maxs[1];
+		tw->extents[2] = -mins[2] > maxs[2] ? -mins[2] : maxs[2];
 	}
 
 	/* general sweeping through world */
-	CM_RecursiveHullCheck(headnode, 0, 1, start, end);
+	CM_RecursiveHullCheck(tw, headnode, 0, 1, start, end);
 
-	if (trace_trace.fraction == 1)
+	if (tw->trace.fraction == 1)
 	{
-		VectorCopy(end, trace_trace.endpos);
+		VectorCopy(end, tw->trace.endpos);
 	}
 	else
 	{
@@ -1238,22 +1290,59 @@ CM_BoxTrace(const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_
 
 		for (i = 0; i < 3; i++)
 		{
-			trace_trace.endpos[i] = start[i] + trace_trace.fraction *
+			tw->trace.endpos[i] = start[i] + tw->trace.fraction *
 									(end[i] - start[i]);
 		}
 	}
+}
+
+trace_t
+CM_BoxTrace(const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_t maxs,
+		int headnode, int brushmask)
+{
+	tracework_t tw;
+
+	checkcount++; /* for multi-check avoidance */
+
+#ifndef DEDICATED_ONLY
+	c_traces++; /* for statistics, may be zeroed */
+#endif
+
+	tw.reentrant = false;
+	CM_TraceWork(&tw, start, end, mins, maxs, headnode, brushmask);
+
+	return tw.trace;
+}
+
+/*
+ * Same as CM_BoxTrace(), but it changes nothing outside
+ * of its stack and may run on several threads at once.
+ * The box hull of CM_HeadnodeForBox() is shared, it
+ * must not be traced by several threads.
+ */
+trace_t
+CM_BoxTraceReentrant(const vec3_t start, const vec3_t end, const vec3_t mins,
+		const vec3_t maxs, int headnode, int brushmask)
+{
+	tracework_t tw;
+
+	tw.reentrant = true;
+	tw.numchecked = 0;
+	memset(tw.checked, -1, sizeof(tw.checked));
 
-	return trace_trace;
+	CM_TraceWork(&tw, start, end, mins, maxs, headnode, brushmask);
+
+	return tw.trace;
 }
 
 /*
  * Handles offseting and rotation of the end points for moving and
  * rotating entities
  */
-trace_t
-CM_TransformedBoxTrace(const vec3_t start, const vec3_t end,
+static trace_t
+CM_TransformedTrace(const vec3_t start, const vec3_t end,
 		const vec3_t mins, const vec3_t maxs, int headnode, int brushmask,
-		const vec3_t origin, const vec3_t angles)
+		const vec3_t origin, const vec3_t angles, qboolean reentrant)
 {
 	vec3_t forward, right, up;
 	vec3_t start_l, end_l;
@@ -1293,7 +1382,15 @@ CM_TransformedBoxTrace(const vec3_t start, const vec3_t end,
 	}
 
 	/* sweep the box through the model */
-	trace = CM_BoxTrace(start_l, end_l, mins, maxs, headnode, brushmask);
+	if (reentrant)
+	{
+		trace = CM_BoxTraceReentrant(start_l, end_l, mins, maxs,
+				headnode, brushmask);
+	}
+	else
+	{
+		trace = CM_BoxTrace(start_l, end_l, mins, maxs, headnode, brushmask);
+	}
 
 	if (rotated && (trace.fraction != 1.0))
 	{
@@ -1315,6 +1412,24 @@ CM_TransformedBoxTrace(const vec3_t start, const vec3_t end,
 	return trace;
 }
 
+trace_t
+CM_TransformedBoxTrace(const vec3_t start, const vec3_t end,
+		const vec3_t mins, const vec3_t maxs, int headnode, int brushmask,
+		const vec3_t origin, const vec3_t angles)
+{
+	return CM_TransformedTrace(start, end, mins, maxs, headnode,
+			brushmask, origin, angles, false);
+}
+
+trace_t
+CM_TransformedBoxTraceReentrant(const vec3_t start, const vec3_t end,
+		const vec3_t mins, const vec3_t maxs, int headnode, int brushmask,
+		const vec3_t origin, const vec3_t angles)
+{
+	return CM_TransformedTrace(start, end, mins, maxs, headnode,
+			brushmask, origin, angles, true);
+}
+
 static void
 CMod_LoadSubmodels(const char *name, cmodel_t *map_cmodels, int *numcmodels, int numnodes,
 	const byte *cmod_base, const lump_t *l)
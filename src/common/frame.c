@@ -203,7 +203,16 @@ Qcommon_Mainloop(void)
 			}
 		}
 #else
-		Sys_Nanosleep(850000);
+		/* the paced server blocks on its sockets
+		   until a packet or the next frame is due */
+		{
+			int wait = SV_FrameWait();
+
+			if ((wait < 0) || !NET_SleepUsec(wait))
+			{
+				Sys_Nanosleep(850000);
+			}
+		}
 #endif
 
 		newtime = Sys_Microseconds();
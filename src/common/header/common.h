@@ -244,8 +244,17 @@ enum svc_ops_e
 	svc_deltapacketentities,    /* [...] */
 	svc_frame,
 	svc_fog,                    /* [Paril-KEX] change current fog values */
+	svc_zframe,                 /* [long] dictframe [long] size [short] compressed size ... */
 };
 
+/* Compressed frames, negotiated with "zframe" in the connect string.
+   svc_zframe holds a raw deflated svc_frame, the tail of an earlier
+   compressed frame the client has acknowledged may be used as preset
+   dictionary. Inflated a frame must fit into a message like a plain
+   one, demos store them that way. */
+#define ZFRAME_DICT_SIZE 4096
+#define MAX_ZFRAME_SIZE (MAX_MSGLEN - 16)
+
 /* ============================================== */
 
 /* client to server */
@@ -545,6 +554,9 @@ extern qboolean userinfo_modified;
 #define PORT_ANY -1
 #define MAX_MSGLEN 32768            /* max length of a message */
 #define PACKET_HEADER 10            /* two ints and a short */
+#define MAX_PACKETLEN 1400          /* larger packets are sent in fragments */
+#define FRAGMENT_SIZE (MAX_PACKETLEN - 100)
+#define MAX_RELAY_FRAME (MAX_MSGLEN * 8) /* sent in FRAGMENT_SIZE parts */
 
 typedef enum
 {
@@ -584,6 +596,8 @@ qboolean NET_IsLocalAddress(netadr_t adr);
 char *NET_AdrToString(netadr_t a);
 qboolean NET_StringToAdr(const char *s, netadr_t *a);
 void NET_Sleep(int msec);
+qboolean NET_SleepUsec(int usec);
+int NET_PacketTime(void);
 
 /*=================================================================== */
 
@@ -622,6 +636,12 @@ typedef struct
 	/* message is copied to this buffer when it is first transfered */
 	int reliable_length;
 	byte reliable_buf[MAX_MSGLEN - 16];         /* unacked reliable message */
+
+	/* fragmentation, set when the remote side reassembles fragments */
+	qboolean fragments;
+	int fragment_sequence;
+	int fragment_length;
+	byte fragment_buf[MAX_MSGLEN];
 } netchan_t;
 
 extern netadr_t net_from;
@@ -670,6 +690,13 @@ trace_t CM_TransformedBoxTrace(const vec3_t start, const vec3_t end,
 		const vec3_t mins, const vec3_t maxs, int headnode,
 		int brushmask, const vec3_t origin, const vec3_t angles);
 
+/* may run on several threads, but not on the box hull */
+trace_t CM_BoxTraceReentrant(const vec3_t start, const vec3_t end,
+		const vec3_t mins, const vec3_t maxs, int headnode, int brushmask);
+trace_t CM_TransformedBoxTraceReentrant(const vec3_t start, const vec3_t end,
+		const vec3_t mins, const vec3_t maxs, int headnode,
+		int brushmask, const vec3_t origin, const vec3_t angles);
+
 byte *CM_ClusterPVS(int cluster);
 byte *CM_ClusterPHS(int cluster);
 
@@ -881,6 +908,7 @@ void SCR_BeginLoadingPlaque(void);
 void SV_Init(void);
 void SV_Shutdown(char *finalmsg, qboolean reconnect);
 void SV_Frame(int usec);
+int SV_FrameWait(void);
 const char *SV_LocalizationUIMessage(const char *message, const char *default_message);
 const char *SV_LocalizationMessage(const char *message, const char **sound);
 void SV_LocalizationInit(void);
@@ -915,6 +943,26 @@ void Sys_GetWorkDir(char *buffer, size_t len);
 qboolean Sys_SetWorkDir(char *path);
 qboolean Sys_Realpath(const char *in, char *out, size_t size);
 
+/* Helper threads. The thread function must not call into
+   the engine, everything that's not thread safe (cvars,
+   the console, the zone allocator...) is main thread only. */
+typedef struct sys_thread_s sys_thread_t;
+sys_thread_t *Sys_CreateThread(void (*func)(void *), void *data);
+void Sys_WaitThread(sys_thread_t *thread);
+
+typedef struct sys_mutex_s sys_mutex_t;
+sys_mutex_t *Sys_CreateMutex(void);
+void Sys_DestroyMutex(sys_mutex_t *mutex);
+void Sys_LockMutex(sys_mutex_t *mutex);
+void Sys_UnlockMutex(sys_mutex_t *mutex);
+
+/* Sys_SignalCond() wakes all waiters */
+typedef struct sys_cond_s sys_cond_t;
+sys_cond_t *Sys_CreateCond(void);
+void Sys_DestroyCond(sys_cond_t *cond);
+void Sys_WaitCond(sys_cond_t *cond, sys_mutex_t *mutex);
+void Sys_SignalCond(sys_cond_t *cond);
+
 // Windows only (system.c)
 #ifdef _WIN32
 void Sys_RedirectStdout(void);
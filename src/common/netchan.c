@@ -31,7 +31,8 @@
 /*
  * packet header
  * -------------
- * 31	sequence
+ * 30	sequence
+ * 1	is this message a fragment
  * 1	does this message contain a reliable payload
  * 31	acknowledge sequence
  * 1	acknowledge receipt of even/odd message
@@ -69,6 +70,14 @@
  * valid reliable acknowledgement numbers provides protection against
  * malicious address spoofing.
  *
+ * Packets larger than MAX_PACKETLEN are split into fragments if the
+ * remote side announced that it reassembles them. The fragments share
+ * the sequence and the header of the packet, followed by a short
+ * offset and a short length. A fragment shorter than FRAGMENT_SIZE is
+ * the last one, an empty one is sent if the packet is a multiple of
+ * FRAGMENT_SIZE. A lost fragment loses the whole packet, the reliable
+ * part is retransmitted as usual.
+ *
  * The qport field is a workaround for bad address translating routers
  * that sometimes remap the client's source port on a packet during
  * gameplay.
@@ -214,6 +223,103 @@ Netchan_NeedReliable(netchan_t *chan)
 	return send_reliable;
 }
 
+/*
+ * Sends a packet in FRAGMENT_SIZE pieces, each with
+ * the packet header of the given length in front.
+ */
+static void
+Netchan_TransmitFragments(netchan_t *chan, sizebuf_t *send, int header,
+	unsigned w1)
+{
+	sizebuf_t frag;
+	byte frag_buf[MAX_PACKETLEN];
+	int offset, length;
+
+	offset = header;
+
+	do
+	{
+		length = Q_min(send->cursize - offset, FRAGMENT_SIZE);
+
+		SZ_Init(&frag, frag_buf, sizeof(frag_buf));
+
+		MSG_WriteLong(&frag, w1 | (1U << 30));
+		SZ_Write(&frag, send->data + 4, header - 4);
+		MSG_WriteShort(&frag, offset - header);
+		MSG_WriteShort(&frag, length);
+		SZ_Write(&frag, send->data + offset, length);
+
+		NET_SendPacket(chan->sock, frag.cursize, frag.data,
+				chan->remote_address);
+
+		offset += length;
+	}
+	while (length == FRAGMENT_SIZE);
+}
+
+/*
+ * Adds a fragment to the reassembly buffer. Returns
+ * true and puts the packet into msg once it's complete.
+ */
+static qboolean
+Netchan_ReadFragment(netchan_t *chan, sizebuf_t *msg, unsigned sequence)
+{
+	int offset, length;
+
+	offset = MSG_ReadShort(msg) & 0xffff;
+	length = MSG_ReadShort(msg) & 0xffff;
+
+	if (sequence != chan->fragment_sequence)
+	{
+		chan->fragment_sequence = sequence;
+		chan->fragment_length = 0;
+	}
+
+	/* a fragment got lost or came out of order,
+	   drop the rest of the packet */
+	if (offset != chan->fragment_length)
+	{
+		if (showdrop->value)
+		{
+			Com_Printf("%s:Dropped a fragment of %i\n",
+					NET_AdrToString(chan->remote_address), sequence);
+		}
+
+		return false;
+	}
+
+	if ((length > FRAGMENT_SIZE) ||
+		(msg->readcount + length > msg->cursize) ||
+		(msg->readcount + chan->fragment_length + length > msg->maxsize))
+	{
+		if (showdrop->value)
+		{
+			Com_Printf("%s:Illegal fragment length %i\n",
+					NET_AdrToString(chan->remote_address), length);
+		}
+
+		return false;
+	}
+
+	memcpy(chan->fragment_buf + chan->fragment_length,
+			msg->data + msg->readcount, length);
+	chan->fragment_length += length;
+
+	if (length == FRAGMENT_SIZE)
+	{
+		return false; /* more to come */
+	}
+
+	/* the packet is complete, replace the
+	   fragment with it behind the header */
+	memcpy(msg->data + msg->readcount, chan->fragment_buf,
+			chan->fragment_length);
+	msg->cursize = msg->readcount + chan->fragment_length;
+	chan->fragment_length = 0;
+
+	return true;
+}
+
 /*
  * tries to send an unreliable message to a connection, and handles the
  * transmition / retransmition of the reliable messages.
@@ -227,6 +333,7 @@ Netchan_Transmit(netchan_t *chan, int length, byte *data)
 	byte send_buf[MAX_MSGLEN];
 	qboolean send_reliable;
 	unsigned w1, w2;
+	int header;
 
 	/* check for message overflow */
 	if (chan->message.overflowed)
@@ -250,7 +357,7 @@ Netchan_Transmit(netchan_t *chan, int length, byte *data)
 	/* write the packet header */
 	SZ_Init(&send, send_buf, sizeof(send_buf));
 
-	w1 = (chan->outgoing_sequence & ~(1U << 31)) | (send_reliable << 31);
+	w1 = (chan->outgoing_sequence & ~(3U << 30)) | (send_reliable << 31);
 	w2 =
 		(chan->incoming_sequence &
 	~(1U << 31)) | (chan->incoming_reliable_sequence << 31);
@@ -267,6 +374,8 @@ Netchan_Transmit(netchan_t *chan, int length, byte *data)
 		MSG_WriteShort(&send, qport->value);
 	}
 
+	header = send.cursize;
+
 	/* copy the reliable message to the packet first */
 	if (send_reliable)
 	{
@@ -285,7 +394,15 @@ Netchan_Transmit(netchan_t *chan, int length, byte *data)
 	}
 
 	/* send the datagram */
-	NET_SendPacket(chan->sock, send.cursize, send.data, chan->remote_address);
+	if (chan->fragments && (send.cursize > MAX_PACKETLEN))
+	{
+		Netchan_TransmitFragments(chan, &send, header, w1);
+	}
+	else
+	{
+		NET_SendPacket(chan->sock, send.cursize, send.data,
+				chan->remote_address);
+	}
 
 	if (showpackets->value)
 	{
@@ -315,6 +432,7 @@ Netchan_Process(netchan_t *chan, sizebuf_t *msg)
 {
 	unsigned sequence, sequence_ack;
 	unsigned reliable_ack, reliable_message;
+	qboolean fragment;
 
 	/* get sequence numbers */
 	MSG_BeginReading(msg);
@@ -329,8 +447,9 @@ Netchan_Process(netchan_t *chan, sizebuf_t *msg)
 
 	reliable_message = sequence >> 31;
 	reliable_ack = sequence_ack >> 31;
+	fragment = (sequence >> 30) & 1;
 
-	sequence &= ~(1U << 31);
+	sequence &= ~(3U << 30);
 	sequence_ack &= ~(1U << 31);
 
 	if (showpackets->value)
@@ -363,6 +482,11 @@ Netchan_Process(netchan_t *chan, sizebuf_t *msg)
 		return false;
 	}
 
+	if (fragment && !Netchan_ReadFragment(chan, msg, sequence))
+	{
+		return false;
+	}
+
 	/* dropped packets don't keep the message from being used */
 	chan->dropped = sequence - (chan->incoming_sequence + 1);
 
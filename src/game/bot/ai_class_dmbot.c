@@ -931,7 +931,7 @@ BOT_DMClass_BloquedTimeout(edict_t *self)
 	self->health = 0;
 	self->ai->bloqued_timeout = level.time + 15.0;
 	self->die(self, self, self, 100000, vec3_origin);
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 //==========================================
@@ -947,7 +947,7 @@ BOT_DMclass_DeadFrame(edict_t *self)
 	self->client->buttons = 0;
 	ucmd.buttons = BUTTON_ATTACK;
 	ClientThink(self, &ucmd);
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 //==========================================
@@ -998,7 +998,7 @@ BOT_DMclass_RunFrame(edict_t *self)
 
 	// send command through id's code
 	ClientThink( self, &ucmd );
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 //==========================================
@@ -1008,7 +1008,7 @@ BOT_DMclass_RunFrame(edict_t *self)
 void
 BOT_DMclass_InitPersistant(edict_t *self)
 {
-	self->classname = "dmbot";
+	G_SetClassname(self, "dmbot");
 
 	/* copy name */
 	if (self->client->pers.netname[0])
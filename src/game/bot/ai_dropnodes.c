@@ -473,6 +473,7 @@ AITools_EraseNodes(void)
 	nav.num_nodes = 0;
 	memset(nodes, 0, sizeof(nav_node_t) * MAX_NODES);
 	memset(pLinks, 0, sizeof(nav_plink_t) * MAX_NODES);
+	AStar_InvalidateLinks();
 
 	nav.num_ents = 0;
 	memset(nav.ents, 0, sizeof(nav_ents_t) * MAX_EDICTS);
@@ -490,6 +491,7 @@ void AITools_InitEditnodes( void )
 		AI_LoadPLKFile(level.mapname);
 		//delete everything but nodes
 		memset(pLinks, 0, sizeof(nav_plink_t) * MAX_NODES);
+		AStar_InvalidateLinks();
 
 		nav.num_ents = 0;
 		memset(nav.ents, 0, sizeof(nav_ents_t) * MAX_EDICTS);
@@ -192,6 +192,7 @@ AI_AddLink( int n1, int n2, int linkType)
 	pLinks[n1].moveType[pLinks[n1].numLinks] = linkType;
 
 	pLinks[n1].numLinks++;
+	AStar_InvalidateLinks();
 
 	return true;
 }
@@ -161,6 +161,9 @@ qboolean AI_IsLadder(vec3_t origin, vec3_t v_angle, vec3_t mins, vec3_t maxs, ed
 //	A* PROPS
 //===========================================
 qboolean AStar_GetPath(int origin, int goal, int movetypes, struct astarpath_s *path);
+void AStar_InvalidateLinks(void);
+void AStar_InitLandmarks(const char *mapname);
+int AStar_GetPathCost(int origin, int goal, int movetypes);
 
 /* ai_class_dmbot */
 qboolean BOT_DMclass_FindEnemy(edict_t *self);
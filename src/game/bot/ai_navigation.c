@@ -37,12 +37,7 @@
 //==========================================
 int AI_FindCost(int from, int to, int movetypes)
 {
-	astarpath_t	path;
-
-	if (!AStar_GetPath( from, to, movetypes, &path))
-		return -1;
-
-	return path.numNodes;
+	return AStar_GetPathCost(from, to, movetypes);
 }
 
 //==========================================
@@ -110,9 +110,9 @@ void AI_JumpadGuess_ShowPoint( vec3_t origin, char *modelname )
 	VectorClear ( ent->mins );
 	VectorClear ( ent->maxs );
 	ent->s.modelindex = gi.modelindex ( modelname );
-	ent->nextthink = level.time + 20000;
+	G_SetNextThink(ent, level.time + 20000);
 	ent->think = G_FreeEdict;
-	ent->classname = "checkent";
+	G_SetClassname(ent, "checkent");
 
 	gi.linkentity (ent);
 }
@@ -706,6 +706,7 @@ qboolean AI_LoadPLKFile( char *mapname )
 	}
 
 	fclose(pIn);
+	AStar_InvalidateLinks();
 
 	return true;
 }
@@ -993,6 +994,7 @@ void AI_InitNavigationData(void)
 	nav.num_nodes = 0;
 	memset( nodes, 0, sizeof(nav_node_t) * MAX_NODES );
 	memset( pLinks, 0, sizeof(nav_plink_t) * MAX_NODES );
+	AStar_InvalidateLinks();
 
 	//Load nodes from file
 	nav.loaded = AI_LoadPLKFile(level.mapname);
@@ -1013,6 +1015,7 @@ void AI_InitNavigationData(void)
 	AI_CreateNodesForEntities();
 	newlinks = AI_LinkServerNodes(servernodesstart);
 	newjumplinks = AI_LinkCloseNodes_JumpPass(servernodesstart);
+	AStar_InitLandmarks(level.mapname);
 
 	Com_Printf("-------------------------------------\n");
 	Com_Printf("AI: Nodes Initialized.\n");
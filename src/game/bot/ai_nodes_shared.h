@@ -40,6 +40,8 @@
 #define	NAV_FILE_VERSION	11
 #define NAV_FILE_EXTENSION	"nav"
 #define AI_NODES_FOLDER		"navigation"
+#define	ALT_FILE_VERSION	1
+#define ALT_FILE_EXTENSION	"alt"
 
 #define MASK_NODESOLID		(CONTENTS_SOLID|CONTENTS_PLAYERCLIP|CONTENTS_MONSTERCLIP|CONTENTS_WINDOW)
 #define MASK_AISOLID		(CONTENTS_SOLID|CONTENTS_PLAYERCLIP|CONTENTS_MONSTER|CONTENTS_DEADMONSTER|CONTENTS_MONSTERCLIP)
@@ -31,25 +31,72 @@
 //
 //==========================================
 
-static int alist[MAX_NODES];	//list contains all studied nodes, Open and Closed together
-static int alist_nodesnum;
-
-typedef enum {
-	NOLIST,
-	OPENLIST,
-	CLOSEDLIST
-} astarnodelist_e;
-
 typedef struct
 {
 	int parent;
 	int g;
 	int h;
 
-	astarnodelist_e list;
+	int gen;	// search the other fields belong to
+	int seq;	// order in which the node was first studied
+	int heappos;	// position in the open heap, -1 when not in open
+	qboolean closed;
 } astarnode_t;
 
 static astarnode_t	astar_nodes[MAX_NODES];
+static int astar_gen;	// current search, stale nodes are in no list
+static int astar_seq;
+
+// open list, a binary heap ordered by F, ties go to the node
+// studied first like in the former linear search
+static int astar_heap[MAX_NODES];
+static int astar_heapnum;
+
+// the links of all nodes in one array (compressed sparse rows),
+// node n owns the entries from link_start[n] to link_start[n + 1]
+typedef struct
+{
+	int node;
+	int dist;
+	int moveType;
+} astarlink_t;
+
+static astarlink_t astar_links[MAX_NODES * NODES_MAX_PLINKS];
+static int link_start[MAX_NODES + 1];
+static int link_nodes;	// nodes covered by the arrays
+static qboolean links_dirty = true;
+
+// landmark (ALT) heuristic: shortest distances from and to a few
+// nodes spread over the map, the triangle inequality turns them
+// into a lower bound of the distance between any two nodes
+#define ALT_LANDMARKS 8
+#define ALT_UNREACHABLE INT_MAX
+
+static int alt_landmarks[ALT_LANDMARKS];
+static int alt_from[ALT_LANDMARKS][MAX_NODES];	// landmark to node
+static int alt_to[ALT_LANDMARKS][MAX_NODES];	// node to landmark
+static int alt_num;	// 0 when the tables don't match the links
+static int alt_nodes;
+
+// links reversed, only needed to build the tables
+static astarlink_t astar_rlinks[MAX_NODES * NODES_MAX_PLINKS];
+static int rlink_start[MAX_NODES + 1];
+
+// costs of recent searches, bots check their goals
+// against the same item nodes over and over again
+#define PATHCACHE_SIZE 1024
+
+typedef struct
+{
+	int gen;
+	int origin;
+	int goal;
+	int movetypes;
+	int numNodes;	// -1 when there's no path
+} pathcache_t;
+
+static pathcache_t path_cache[PATHCACHE_SIZE];
+static int path_gen = 1;
 
 //==========================================
 //
@@ -84,13 +131,22 @@ AStar_IsValidNode(int node)
 	return (node >= 0 && node < MAX_NODES);
 }
 
+/*
+ * Check if a node was studied in this search.
+ */
+static inline qboolean
+AStar_nodeIsStudied(int node)
+{
+	return (AStar_IsValidNode(node) && astar_nodes[node].gen == astar_gen);
+}
+
 /*
  * Check if a node is in the Closed list.
  */
 static inline qboolean
 AStar_nodeIsInClosed(int node)
 {
-	return (AStar_IsValidNode(node) && astar_nodes[node].list == CLOSEDLIST);
+	return (AStar_nodeIsStudied(node) && astar_nodes[node].closed);
 }
 
 /*
@@ -99,51 +155,501 @@ AStar_nodeIsInClosed(int node)
 static inline qboolean
 AStar_nodeIsInOpen(int node)
 {
-	return (AStar_IsValidNode(node) && astar_nodes[node].list == OPENLIST);
+	return (AStar_nodeIsStudied(node) && !astar_nodes[node].closed);
+}
+
+/*
+ * The links changed, rebuild the
+ * link arrays before the next search.
+ */
+void
+AStar_InvalidateLinks(void)
+{
+	links_dirty = true;
+	alt_num = 0;
+	path_gen++;
 }
 
+static void
+AStar_BuildLinks(void)
+{
+	int i, j, k, n;
+
+	n = 0;
+
+	for (i = 0; i < nav.num_nodes && i < MAX_NODES; i++)
+	{
+		link_start[i] = n;
+
+		for (j = 0; j < pLinks[i].numLinks && j < NODES_MAX_PLINKS; j++)
+		{
+			astar_links[n].node = pLinks[i].nodes[j];
+			astar_links[n].moveType = pLinks[i].moveType[j];
+
+			// a repeated link costs as much as the first one
+			for (k = 0; pLinks[i].nodes[k] != pLinks[i].nodes[j]; k++)
+			{
+			}
+
+			astar_links[n].dist = (int)pLinks[i].dist[k];
+			n++;
+		}
+	}
+
+	link_nodes = i;
+	link_start[i] = n;
+	links_dirty = false;
+}
+
+/*
+ * Starts a new search, everything studied
+ * before is forgotten without clearing.
+ */
 static void
 AStar_InitLists(void)
 {
 	size_t i;
 
+	if (links_dirty)
+	{
+		AStar_BuildLinks();
+	}
+
+	astar_gen++;
+
+	if (astar_gen <= 0)
+	{
+		// wrapped around, now the nodes must be cleared
+		for (i = 0; i < MAX_NODES; i++)
+		{
+			astar_nodes[i].gen = 0;
+		}
+
+		astar_gen = 1;
+	}
+
+	astar_seq = 0;
+	astar_heapnum = 0;
+}
+
+/*
+ * Marks a node as studied in this search.
+ */
+static void
+AStar_StudyNode(int node)
+{
+	astar_nodes[node].parent = 0;
+	astar_nodes[node].g = 0;
+	astar_nodes[node].h = 0;
+	astar_nodes[node].gen = astar_gen;
+	astar_nodes[node].seq = astar_seq++;
+	astar_nodes[node].heappos = -1;
+	astar_nodes[node].closed = false;
+}
+
+static qboolean
+AStar_HeapLess(int n1, int n2)
+{
+	int f1, f2;
+
+	f1 = astar_nodes[n1].g + astar_nodes[n1].h;
+	f2 = astar_nodes[n2].g + astar_nodes[n2].h;
+
+	if (f1 != f2)
+	{
+		return f1 < f2;
+	}
+
+	return astar_nodes[n1].seq < astar_nodes[n2].seq;
+}
+
+static void
+AStar_HeapSet(int pos, int node)
+{
+	astar_heap[pos] = node;
+	astar_nodes[node].heappos = pos;
+}
+
+static void
+AStar_HeapUp(int pos)
+{
+	int node, parent;
+
+	node = astar_heap[pos];
+
+	while (pos > 0)
+	{
+		parent = (pos - 1) / 2;
+
+		if (!AStar_HeapLess(node, astar_heap[parent]))
+		{
+			break;
+		}
+
+		AStar_HeapSet(pos, astar_heap[parent]);
+		pos = parent;
+	}
+
+	AStar_HeapSet(pos, node);
+}
+
+static void
+AStar_HeapDown(int pos)
+{
+	int node, child;
+
+	node = astar_heap[pos];
+
+	while ((child = pos * 2 + 1) < astar_heapnum)
+	{
+		if ((child + 1 < astar_heapnum) &&
+			AStar_HeapLess(astar_heap[child + 1], astar_heap[child]))
+		{
+			child++;
+		}
+
+		if (!AStar_HeapLess(astar_heap[child], node))
+		{
+			break;
+		}
+
+		AStar_HeapSet(pos, astar_heap[child]);
+		pos = child;
+	}
+
+	AStar_HeapSet(pos, node);
+}
+
+static void
+AStar_HeapRemove(int node)
+{
+	int pos, last;
+
+	pos = astar_nodes[node].heappos;
+
+	if (pos < 0)
+	{
+		return;
+	}
+
+	astar_nodes[node].heappos = -1;
+	last = astar_heap[--astar_heapnum];
+
+	if (last != node)
+	{
+		AStar_HeapSet(pos, last);
+		AStar_HeapUp(pos);
+		AStar_HeapDown(astar_nodes[last].heappos);
+	}
+}
+
+/*
+ * Shortest distances from the landmark to all
+ * nodes, following the given links.
+ */
+static void
+AStar_LandmarkDistances(int landmark, const int *start,
+		const astarlink_t *links, int *dist)
+{
+	const astarlink_t *link, *end;
+	int i, node;
+
 	for (i = 0; i < MAX_NODES; i++)
 	{
-		astar_nodes[i].g = 0;
-		astar_nodes[i].h = 0;
-		astar_nodes[i].parent = 0;
-		astar_nodes[i].list = NOLIST;
+		dist[i] = ALT_UNREACHABLE;
 	}
 
-	alist_nodesnum = 0;
-	memset(alist, -1, sizeof(alist));
+	AStar_InitLists();
+	AStar_StudyNode(landmark);
+	AStar_HeapSet(astar_heapnum, landmark);
+	AStar_HeapUp(astar_heapnum++);
+
+	while (astar_heapnum > 0)
+	{
+		node = astar_heap[0];
+		AStar_HeapRemove(node);
+		astar_nodes[node].closed = true;
+		dist[node] = astar_nodes[node].g;
+
+		end = &links[start[node + 1]];
+
+		for (link = &links[start[node]]; link < end; link++)
+		{
+			int addnode = link->node;
+
+			if (addnode < 0 || addnode >= link_nodes ||
+				AStar_nodeIsInClosed(addnode))
+			{
+				continue;
+			}
+
+			if (AStar_nodeIsInOpen(addnode))
+			{
+				if (astar_nodes[addnode].g > (astar_nodes[node].g + link->dist))
+				{
+					astar_nodes[addnode].g = astar_nodes[node].g + link->dist;
+					AStar_HeapUp(astar_nodes[addnode].heappos);
+				}
+			}
+			else
+			{
+				AStar_StudyNode(addnode);
+				astar_nodes[addnode].g = astar_nodes[node].g + link->dist;
+
+				AStar_HeapSet(astar_heapnum, addnode);
+				AStar_HeapUp(astar_heapnum++);
+			}
+		}
+	}
 }
 
-static int
-AStar_PlinkDistance(int n1, int n2)
+static void
+AStar_BuildReverseLinks(void)
 {
-	size_t i;
+	int i, n;
+	const astarlink_t *link;
+
+	memset(rlink_start, 0, sizeof(rlink_start));
 
-	if (!AStar_IsValidNode(n1) || !AStar_IsValidNode(n2))
+	for (i = 0; i < link_start[link_nodes]; i++)
 	{
-		if (bot_debugmonster->value)
+		if (astar_links[i].node >= 0 && astar_links[i].node < link_nodes)
 		{
-			Com_Printf("WARNING: %s - incorrect distance nodes %d, %d\n",
-				__func__, n1, n2);
+			rlink_start[astar_links[i].node + 1]++;
 		}
+	}
 
-		return -1;
+	for (i = 0; i < link_nodes; i++)
+	{
+		rlink_start[i + 1] += rlink_start[i];
 	}
 
-	for (i = 0; i < pLinks[n1].numLinks; i++)
+	for (n = 0; n < link_nodes; n++)
 	{
-		if (pLinks[n1].nodes[i] == n2)
+		for (link = &astar_links[link_start[n]];
+			link < &astar_links[link_start[n + 1]]; link++)
 		{
-			return (int)pLinks[n1].dist[i];
+			if (link->node >= 0 && link->node < link_nodes)
+			{
+				i = rlink_start[link->node]++;
+				astar_rlinks[i] = *link;
+				astar_rlinks[i].node = n;
+			}
 		}
 	}
 
-	return -1;
+	// the fill moved every start to the next one
+	for (i = link_nodes; i > 0; i--)
+	{
+		rlink_start[i] = rlink_start[i - 1];
+	}
+
+	rlink_start[0] = 0;
+}
+
+/*
+ * Picks the landmarks one after another, each the node
+ * farthest from the ones already taken. Nodes nothing
+ * reaches come first, so every island gets a landmark.
+ */
+static void
+AStar_ComputeLandmarks(void)
+{
+	int i, l, node, best, bestdist;
+
+	AStar_BuildReverseLinks();
+
+	alt_num = 0;
+	alt_nodes = link_nodes;
+
+	node = 0;
+
+	for (l = 0; l < ALT_LANDMARKS && l < link_nodes; l++)
+	{
+		if (l > 0)
+		{
+			best = -1;
+			bestdist = -1;
+
+			for (i = 0; i < link_nodes; i++)
+			{
+				int j, dist = ALT_UNREACHABLE;
+
+				for (j = 0; j < l; j++)
+				{
+					if (alt_from[j][i] != ALT_UNREACHABLE &&
+						alt_to[j][i] != ALT_UNREACHABLE)
+					{
+						dist = Q_min(dist, alt_from[j][i] + alt_to[j][i]);
+					}
+				}
+
+				if (dist > bestdist)
+				{
+					best = i;
+					bestdist = dist;
+				}
+			}
+
+			if (bestdist <= 0)
+			{
+				break;
+			}
+
+			node = best;
+		}
+
+		alt_landmarks[l] = node;
+		AStar_LandmarkDistances(node, link_start, astar_links, alt_from[l]);
+		AStar_LandmarkDistances(node, rlink_start, astar_rlinks, alt_to[l]);
+	}
+
+	alt_num = l;
+}
+
+/*
+ * Fingerprint of the link arrays,
+ * tells if stored tables still fit.
+ */
+static unsigned
+AStar_LinksChecksum(void)
+{
+	unsigned sum = 2166136261u;
+	int i;
+
+	for (i = 0; i <= link_nodes; i++)
+	{
+		sum = (sum ^ (unsigned)link_start[i]) * 16777619u;
+	}
+
+	for (i = 0; i < link_start[link_nodes]; i++)
+	{
+		sum = (sum ^ (unsigned)astar_links[i].node) * 16777619u;
+		sum = (sum ^ (unsigned)astar_links[i].dist) * 16777619u;
+	}
+
+	return sum;
+}
+
+static void
+AStar_LandmarkFilename(const char *mapname, char *filename, size_t size)
+{
+	Com_sprintf(filename, size, "%s/%s/%s.%s",
+		gi.Gamedir(), AI_NODES_FOLDER, mapname, ALT_FILE_EXTENSION);
+}
+
+static qboolean
+AStar_LoadLandmarks(const char *mapname, unsigned checksum)
+{
+	char filename[MAX_OSPATH];
+	int header[4];
+	int l;
+	FILE *pIn;
+
+	AStar_LandmarkFilename(mapname, filename, sizeof(filename));
+
+	pIn = Q_fopen(filename, "rb");
+	if (!pIn)
+	{
+		return false;
+	}
+
+	// version, nodes, links checksum, landmarks
+	if ((fread(header, sizeof(int), 4, pIn) != 4) ||
+		(header[0] != ALT_FILE_VERSION) ||
+		(header[1] != link_nodes) ||
+		((unsigned)header[2] != checksum) ||
+		(header[3] <= 0) || (header[3] > ALT_LANDMARKS) ||
+		(fread(alt_landmarks, sizeof(int), header[3], pIn) != header[3]))
+	{
+		fclose(pIn);
+		return false;
+	}
+
+	for (l = 0; l < header[3]; l++)
+	{
+		if ((fread(alt_from[l], sizeof(int), link_nodes, pIn) != link_nodes) ||
+			(fread(alt_to[l], sizeof(int), link_nodes, pIn) != link_nodes))
+		{
+			fclose(pIn);
+			return false;
+		}
+	}
+
+	fclose(pIn);
+
+	alt_num = header[3];
+	alt_nodes = link_nodes;
+
+	return true;
+}
+
+static void
+AStar_SaveLandmarks(const char *mapname, unsigned checksum)
+{
+	char filename[MAX_OSPATH];
+	int header[4];
+	int l;
+	FILE *pOut;
+
+	AStar_LandmarkFilename(mapname, filename, sizeof(filename));
+
+	gi.CreatePath(filename);
+	pOut = Q_fopen(filename, "wb");
+	if (!pOut)
+	{
+		Com_Printf("Failed to store: %s\n", filename);
+		return;
+	}
+
+	header[0] = ALT_FILE_VERSION;
+	header[1] = alt_nodes;
+	header[2] = (int)checksum;
+	header[3] = alt_num;
+
+	fwrite(header, sizeof(int), 4, pOut);
+	fwrite(alt_landmarks, sizeof(int), alt_num, pOut);
+
+	for (l = 0; l < alt_num; l++)
+	{
+		fwrite(alt_from[l], sizeof(int), alt_nodes, pOut);
+		fwrite(alt_to[l], sizeof(int), alt_nodes, pOut);
+	}
+
+	fclose(pOut);
+}
+
+/*
+ * Sets up the landmark tables for the final links of the
+ * map. They are stored next to the nodes file and only
+ * computed again when the links don't match anymore.
+ */
+void
+AStar_InitLandmarks(const char *mapname)
+{
+	unsigned checksum;
+
+	AStar_BuildLinks();
+	alt_num = 0;
+	path_gen++;
+
+	if (!link_nodes)
+	{
+		return;
+	}
+
+	checksum = AStar_LinksChecksum();
+
+	if (AStar_LoadLandmarks(mapname, checksum))
+	{
+		Com_Printf("AI: Loaded %i landmarks.\n", alt_num);
+		return;
+	}
+
+	AStar_ComputeLandmarks();
+	AStar_SaveLandmarks(mapname, checksum);
+
+	Com_Printf("AI: Computed %i landmarks.\n", alt_num);
 }
 
 static int
@@ -177,6 +683,44 @@ Astar_HDist_ManhatanGuess(int node)
 	return (DistVec[0] + DistVec[1] + DistVec[2]);
 }
 
+/*
+ * Lower bound of the distance to the goal from the landmark
+ * tables, the distance guess when there are none.
+ */
+static int
+Astar_HDist_Landmarks(int node)
+{
+	int l, h, d;
+
+	if (!alt_num || node >= alt_nodes || goalNode >= alt_nodes)
+	{
+		return Astar_HDist_ManhatanGuess(node);
+	}
+
+	h = 0;
+
+	for (l = 0; l < alt_num; l++)
+	{
+		// landmark -> node -> goal
+		if (alt_from[l][goalNode] != ALT_UNREACHABLE &&
+			alt_from[l][node] != ALT_UNREACHABLE)
+		{
+			d = alt_from[l][goalNode] - alt_from[l][node];
+			h = Q_max(h, d);
+		}
+
+		// node -> goal -> landmark
+		if (alt_to[l][node] != ALT_UNREACHABLE &&
+			alt_to[l][goalNode] != ALT_UNREACHABLE)
+		{
+			d = alt_to[l][node] - alt_to[l][goalNode];
+			h = Q_max(h, d);
+		}
+	}
+
+	return h;
+}
+
 static void
 AStar_PutInClosed(int node)
 {
@@ -191,19 +735,19 @@ AStar_PutInClosed(int node)
 		return;
 	}
 
-	if (!astar_nodes[node].list)
+	if (!AStar_nodeIsStudied(node))
 	{
-		alist[alist_nodesnum] = node;
-		alist_nodesnum++;
+		AStar_StudyNode(node);
 	}
 
-	astar_nodes[node].list = CLOSEDLIST;
+	AStar_HeapRemove(node);
+	astar_nodes[node].closed = true;
 }
 
 static void
 AStar_PutAdjacentsInOpen(int node)
 {
-	size_t i;
+	const astarlink_t *link, *end;
 
 	if (!AStar_IsValidNode(node))
 	{
@@ -216,17 +760,24 @@ AStar_PutAdjacentsInOpen(int node)
 		return;
 	}
 
-	for (i = 0; i < pLinks[node].numLinks; i++)
+	if (node >= link_nodes)
+	{
+		return;
+	}
+
+	end = &astar_links[link_start[node + 1]];
+
+	for (link = &astar_links[link_start[node]]; link < end; link++)
 	{
 		int addnode;
 
 		// ignore invalid links
-		if (!(ValidLinksMask & pLinks[node].moveType[i]))
+		if (!(ValidLinksMask & link->moveType))
 		{
 			continue;
 		}
 
-		addnode = pLinks[node].nodes[i];
+		addnode = link->node;
 
 		// ignore self
 		if (addnode == node)
@@ -243,53 +794,25 @@ AStar_PutAdjacentsInOpen(int node)
 		// if it's already inside open list
 		if (AStar_nodeIsInOpen(addnode))
 		{
-			int plink_dist;
-
-			plink_dist = AStar_PlinkDistance(node, addnode);
-			if (plink_dist < 0 && bot_debugmonster->value)
-			{
-				Com_Printf("WARNING: %s - Couldn't find distance between nodes\n",
-					__func__);
-			}
 			// compare G distances and choose best parent
-			else if (astar_nodes[addnode].g > (astar_nodes[node].g + plink_dist))
+			if (astar_nodes[addnode].g > (astar_nodes[node].g + link->dist))
 			{
 				astar_nodes[addnode].parent = node;
-				astar_nodes[addnode].g = astar_nodes[node].g + plink_dist;
+				astar_nodes[addnode].g = astar_nodes[node].g + link->dist;
+				AStar_HeapUp(astar_nodes[addnode].heappos);
 			}
 		}
-		else
+		else if (AStar_IsValidNode(addnode))
 		{
 			// just put it in
-			int plink_dist;
-
-			plink_dist = AStar_PlinkDistance( node, addnode );
-			if (plink_dist < 0)
-			{
-				plink_dist = AStar_PlinkDistance(addnode, node);
-				if (plink_dist < 0)
-				{
-					plink_dist = INT_MAX;
-				}
-
-				if (bot_debugmonster->value)
-				{
-					Com_Printf("WARNING: %s - Couldn't find distance between nodes\n",
-						__func__);
-				}
-			}
-
-			// put in global list
-			if (!astar_nodes[addnode].list)
-			{
-				alist[alist_nodesnum] = addnode;
-				alist_nodesnum++;
-			}
+			AStar_StudyNode(addnode);
 
 			astar_nodes[addnode].parent = node;
-			astar_nodes[addnode].g = astar_nodes[node].g + plink_dist;
-			astar_nodes[addnode].h = Astar_HDist_ManhatanGuess( addnode );
-			astar_nodes[addnode].list = OPENLIST;
+			astar_nodes[addnode].g = astar_nodes[node].g + link->dist;
+			astar_nodes[addnode].h = Astar_HDist_Landmarks(addnode);
+
+			AStar_HeapSet(astar_heapnum, addnode);
+			AStar_HeapUp(astar_heapnum++);
 		}
 	}
 }
@@ -297,24 +820,11 @@ AStar_PutAdjacentsInOpen(int node)
 static int
 AStar_FindInOpen_BestF(void)
 {
-	size_t i;
-	int	bestF = -1;
 	int best = -1;
 
-	for (i = 0; i < alist_nodesnum; i++)
+	if (astar_heapnum > 0)
 	{
-		int node = alist[i];
-
-		if (!AStar_IsValidNode(node) || astar_nodes[node].list != OPENLIST)
-		{
-			continue;
-		}
-
-		if (bestF < 0 || bestF > (astar_nodes[node].g + astar_nodes[node].h))
-		{
-			bestF = astar_nodes[node].g + astar_nodes[node].h;
-			best = node;
-		}
+		best = astar_heap[0];
 	}
 
 	if (bot_debugmonster->value)
@@ -397,15 +907,69 @@ AStar_ResolvePath(int origin, int goal, int movetypes, struct astarpath_s *path)
 	return true;
 }
 
+static pathcache_t *
+AStar_CachedPath(int origin, int goal, int movetypes)
+{
+	unsigned hash;
+
+	hash = ((unsigned)origin * 2654435761u) ^
+		((unsigned)goal * 40503u) ^ (unsigned)movetypes;
+
+	return &path_cache[(hash ^ (hash >> 16)) & (PATHCACHE_SIZE - 1)];
+}
+
+static void
+AStar_CachePath(int origin, int goal, int movetypes, int numNodes)
+{
+	pathcache_t *c;
+
+	c = AStar_CachedPath(origin, goal, movetypes);
+
+	c->gen = path_gen;
+	c->origin = origin;
+	c->goal = goal;
+	c->movetypes = movetypes;
+	c->numNodes = numNodes;
+}
+
 qboolean
 AStar_GetPath(int origin, int goal, int movetypes, struct astarpath_s *path)
 {
 	if (!AStar_ResolvePath(origin, goal, movetypes, path))
 	{
+		AStar_CachePath(origin, goal, movetypes, -1);
 		return false;
 	}
 
+	AStar_CachePath(origin, goal, movetypes, path->numNodes);
+
 	path->originNode = origin;
 	path->goalNode = goal;
 	return true;
 }
+
+/*
+ * Number of nodes on the path, -1 when there is none.
+ * Served from the cache of recent searches when possible.
+ */
+int
+AStar_GetPathCost(int origin, int goal, int movetypes)
+{
+	static astarpath_t path;
+	pathcache_t *c;
+
+	c = AStar_CachedPath(origin, goal, movetypes);
+
+	if ((c->gen == path_gen) && (c->origin == origin) &&
+		(c->goal == goal) && (c->movetypes == movetypes))
+	{
+		return c->numNodes;
+	}
+
+	if (!AStar_GetPath(origin, goal, movetypes, &path))
+	{
+		return -1;
+	}
+
+	return path.numNodes;
+}
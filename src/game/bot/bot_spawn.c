@@ -258,7 +258,7 @@ BOT_DMClass_JoinGame(edict_t *ent, char *team_name)
 	}
 
 	ent->think = AI_Think;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	//join game
 	ent->movetype = MOVETYPE_WALK;
@@ -369,7 +369,7 @@ void BOT_SpawnBot (char *team, char *name, char *skin, char *userinfo)
 	AI_ResetNavigation(bot);
 
 	bot->think = BOT_JoinGame;
-	bot->nextthink = level.time + (int)(random() * 6.0);
+	G_SetNextThink(bot, level.time + (int)(random() * 6.0));
 	if (ctf->value && team != NULL)
 	{
 		if (!Q_stricmp(team, "blue"))
@@ -555,7 +555,7 @@ DBall_BallDie(edict_t *self, edict_t *inflictor /* unused */, edict_t *attacker
 	/* make it invisible and desolid until respawn time */
 	self->solid = SOLID_NOT;
 	self->think = DBall_BallRespawn;
-	self->nextthink = level.time + 2;
+	G_SetNextThink(self, level.time + 2);
 	gi.linkentity(self);
 }
 
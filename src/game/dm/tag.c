@@ -187,7 +187,7 @@ Tag_Respawn(edict_t *ent)
 
 	if (spot == NULL)
 	{
-		ent->nextthink = level.time + 1;
+		G_SetNextThink(ent, level.time + 1);
 		return;
 	}
 
@@ -210,11 +210,11 @@ Tag_MakeTouchable(edict_t *ent)
 	/* check here to see if it's in lava or slime. if so, do a respawn sooner */
 	if (gi.pointcontents(ent->s.origin) & (CONTENTS_LAVA | CONTENTS_SLIME))
 	{
-		tag_token->nextthink = level.time + 3;
+		G_SetNextThink(tag_token, level.time + 3);
 	}
 	else
 	{
-		tag_token->nextthink = level.time + 30;
+		G_SetNextThink(tag_token, level.time + 30);
 	}
 }
 
@@ -236,7 +236,7 @@ Tag_DropToken(edict_t *ent, gitem_t *item)
 
 	tag_token = G_Spawn();
 
-	tag_token->classname = item->classname;
+	G_SetClassname(tag_token, item->classname);
 	tag_token->item = item;
 	tag_token->spawnflags = DROPPED_ITEM;
 	tag_token->s.effects = EF_ROTATE | EF_TAGTRAIL;
@@ -259,7 +259,7 @@ Tag_DropToken(edict_t *ent, gitem_t *item)
 	tag_token->velocity[2] = 300;
 
 	tag_token->think = Tag_MakeTouchable;
-	tag_token->nextthink = level.time + 1;
+	G_SetNextThink(tag_token, level.time + 1);
 
 	gi.linkentity(tag_token);
 
@@ -331,7 +331,7 @@ Tag_PostInitSetup(void)
 	if (e == NULL)
 	{
 		e = G_Spawn();
-		e->classname = "dm_tag_token";
+		G_SetClassname(e, "dm_tag_token");
 
 		SelectSpawnPoint(e, origin, angles);
 		VectorCopy(origin, e->s.origin);
@@ -369,7 +369,7 @@ SP_dm_tag_token(edict_t *self)
 	tag_token = self;
 	tag_count = 0;
 
-	self->classname = "dm_tag_token";
+	G_SetClassname(self, "dm_tag_token");
 	self->model = "models/items/tagtoken/tris.md2";
 	self->count = 1;
 	SpawnItem(self, FindItem("Tag Token"));
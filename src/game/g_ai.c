@@ -36,6 +36,131 @@ static qboolean enemy_infront;
 static int enemy_range;
 static float enemy_yaw;
 
+/*
+ * visible() results are cached for each pair of entities
+ * and eye positions. Only the world and brush models stop
+ * MASK_OPAQUE traces, so the cache stays valid until one
+ * of them is linked or unlinked. It's flushed with each
+ * frame anyway.
+ */
+#define SIGHT_CACHE_SIZE 4096  /* power of two */
+
+typedef struct
+{
+	int epoch;
+	edict_t *self;
+	edict_t *other;
+	vec3_t spot1;
+	vec3_t spot2;
+	qboolean visible;
+	qboolean perceived;  /* filled by the perception stage */
+} sightcache_t;
+
+static sightcache_t sight_cache[SIGHT_CACHE_SIZE];
+static int sight_epoch = 1;
+static int sight_hits, sight_misses, sight_mismatches;
+static int sight_perceived, sight_perceived_hits;
+
+/*
+ * The perception stage traces the sight checks the
+ * monsters thinking this frame are going to make
+ * on worker threads before the entities are run,
+ * the results go into the sight cache. A monster
+ * looks at its enemy and at the FindTarget()
+ * candidate, everything else is traced as usual.
+ */
+#define MAX_PERCEPTS 2
+
+typedef struct
+{
+	edict_t *other;
+	vec3_t spot1;
+	vec3_t spot2;
+	trace_t trace;
+	qboolean visible;
+} percept_t;
+
+typedef struct
+{
+	edict_t *self;
+	int numpercepts;
+	percept_t percepts[MAX_PERCEPTS];
+} perception_t;
+
+static perception_t *perception;  /* [game.maxentities] */
+
+static void (*sight_linkentity)(edict_t *ent);
+static void (*sight_unlinkentity)(edict_t *ent);
+
+/* ========================================================================== */
+
+static void
+AI_LinkEntity(edict_t *ent)
+{
+	/* s.solid is 31 if it was linked as a brush model */
+	if (ent && ((ent->solid == SOLID_BSP) || (ent->s.solid == 31)))
+	{
+		sight_epoch++;
+	}
+
+	/* a relinked edict may have been given a model or
+	   a movetype, it must not stay asleep */
+	G_WakeEdict(ent);
+
+	sight_linkentity(ent);
+}
+
+static void
+AI_UnlinkEntity(edict_t *ent)
+{
+	if (ent && ((ent->solid == SOLID_BSP) || (ent->s.solid == 31)))
+	{
+		sight_epoch++;
+	}
+
+	sight_unlinkentity(ent);
+}
+
+/*
+ * Hooks the sight cache and the edict sleep
+ * into gi.linkentity() and gi.unlinkentity(),
+ * called after gi was copied from the server.
+ */
+void
+AI_InitSight(void)
+{
+	sight_linkentity = gi.linkentity;
+	sight_unlinkentity = gi.unlinkentity;
+
+	gi.linkentity = AI_LinkEntity;
+	gi.unlinkentity = AI_UnlinkEntity;
+}
+
+void
+AI_PrintSightStats(void)
+{
+	int total;
+
+	total = sight_hits + sight_misses;
+
+	gi.cprintf(NULL, PRINT_HIGH, "%i sight checks, %i cached (%.1f%%)\n",
+			total, sight_hits, total ? 100.0f * sight_hits / total : 0.0f);
+	gi.cprintf(NULL, PRINT_HIGH, "%i traced by the perception stage, %i used\n",
+			sight_perceived, sight_perceived_hits);
+
+	if (g_sight_validate->value)
+	{
+		gi.cprintf(NULL, PRINT_HIGH, "%i cached results were wrong\n",
+				sight_mismatches);
+	}
+
+	sight_hits = 0;
+	sight_misses = 0;
+	sight_mismatches = 0;
+	sight_perceived = 0;
+	sight_perceived_hits = 0;
+}
+
 /* ========================================================================== */
 
 /*
@@ -52,6 +177,9 @@ AI_SetSightClient(void)
 	edict_t *ent;
 	int start, check;
 
+	/* a new frame, everything may have moved */
+	sight_epoch++;
+
 	if (level.sight_client == NULL)
 	{
 		start = 1;
@@ -415,6 +543,29 @@ range(edict_t *self, edict_t *other)
 	return RANGE_FAR;
 }
 
+/*
+ * The eye positions visible() traces between
+ */
+static void
+AI_SightSpots(const edict_t *self, const edict_t *other,
+		vec3_t spot1, vec3_t spot2)
+{
+	VectorCopy(self->s.origin, spot1);
+	spot1[2] += self->viewheight;
+	VectorCopy(other->s.origin, spot2);
+	spot2[2] += other->viewheight;
+}
+
+static sightcache_t *
+AI_SightCache(const edict_t *self, const edict_t *other)
+{
+	unsigned int hash;
+
+	hash = (unsigned int)(self - g_edicts) * 31 + (unsigned int)(other - g_edicts);
+
+	return &sight_cache[hash & (SIGHT_CACHE_SIZE - 1)];
+}
+
 /*
  * returns 1 if the entity is visible
  * to self, even if not infront
@@ -425,6 +576,8 @@ visible(edict_t *self, edict_t *other)
 	vec3_t spot1;
 	vec3_t spot2;
 	trace_t trace;
+	sightcache_t *cache;
+	qboolean hit, vis;
 
 	if (!self || !other)
 	{
@@ -443,18 +596,53 @@ visible(edict_t *self, edict_t *other)
 		}
 	}
 
-	VectorCopy(self->s.origin, spot1);
-	spot1[2] += self->viewheight;
-	VectorCopy(other->s.origin, spot2);
-	spot2[2] += other->viewheight;
+	AI_SightSpots(self, other, spot1, spot2);
+
+	cache = AI_SightCache(self, other);
+
+	hit = (cache->epoch == sight_epoch) && (cache->self == self) &&
+		(cache->other == other) && VectorCompare(cache->spot1, spot1) &&
+		VectorCompare(cache->spot2, spot2);
+
+	if (hit)
+	{
+		sight_hits++;
+
+		if (cache->perceived)
+		{
+			sight_perceived_hits++;
+		}
+
+		if (!g_sight_validate->value)
+		{
+			return cache->visible;
+		}
+	}
+	else
+	{
+		sight_misses++;
+	}
+
 	trace = gi.trace(spot1, vec3_origin, vec3_origin, spot2, self, MASK_OPAQUE);
+	vis = (trace.fraction == 1.0) || (trace.ent == other);
 
-	if ((trace.fraction == 1.0) || (trace.ent == other))
+	/* with g_sight_validate the trace only checks the hit */
+	if (hit && (cache->visible != vis))
 	{
-		return true;
+		gi.dprintf("%s: wrong cached result for %i and %i\n", __func__,
+				(int)(self - g_edicts), (int)(other - g_edicts));
+		sight_mismatches++;
 	}
 
-	return false;
+	cache->epoch = sight_epoch;
+	cache->self = self;
+	cache->other = other;
+	VectorCopy(spot1, cache->spot1);
+	VectorCopy(spot2, cache->spot2);
+	cache->visible = vis;
+	cache->perceived = false;
+
+	return vis;
 }
 
 /*
@@ -588,7 +776,7 @@ FoundTarget(edict_t *self)
 	self->monsterinfo.pausetime = 0;
 
 	/* clear the targetname, that point is ours! */
-	combatpoint->targetname = NULL;
+	G_SetTargetname(combatpoint, NULL);
 	self->goalentity = self->movetarget = combatpoint;
 
 	/* run for it */
@@ -596,43 +784,25 @@ FoundTarget(edict_t *self)
 }
 
 /*
- * Self is currently not attacking anything,
- * so try to find a target
- *
- * Returns TRUE if an enemy was sighted
- *
- * When a player fires a missile, the point
- * of impact becomes a fakeplayer so that
- * monsters that see the impact will respond
- * as if they had seen the player.
- *
- * To avoid spending too much time, only
- * a single client (or fakeclient) is
- * checked each frame. This means multi
- * player games will have slightly
- * slower noticing monsters.
+ * Picks the entity FindTarget() checks, NULL if
+ * FindTarget() gives up before looking at one.
+ * Changes nothing, the perception stage calls
+ * it on worker threads.
  */
-qboolean
-FindTarget(edict_t *self)
+static edict_t *
+AI_TargetCandidate(const edict_t *self, qboolean *heardit)
 {
 	edict_t *client;
-	qboolean heardit;
-	int r;
-
-	if (!self)
-	{
-		return false;
-	}
 
 	if (self->monsterinfo.aiflags & AI_GOOD_GUY)
 	{
-		return false;
+		return NULL;
 	}
 
 	/* if we're going to a combat point, just proceed */
 	if (self->monsterinfo.aiflags & AI_COMBAT_POINT)
 	{
-		return false;
+		return NULL;
 	}
 
 	/* if the first spawnflag bit is set, the monster
@@ -640,16 +810,16 @@ FindTarget(edict_t *self)
 	   not another monster getting angry or hearing
 	   something */
 
-	heardit = false;
+	*heardit = false;
 
 	if ((level.sight_entity_framenum >= (level.framenum - 1)) &&
 		!(self->spawnflags & 1))
 	{
 		client = level.sight_entity;
 
-		if (client->enemy == self->enemy)
+		if (client && (client->enemy == self->enemy))
 		{
-			return false;
+			return NULL;
 		}
 	}
 	else if (level.disguise_violation_framenum > level.framenum)
@@ -659,14 +829,14 @@ FindTarget(edict_t *self)
 	else if (level.sound_entity_framenum >= (level.framenum - 1))
 	{
 		client = level.sound_entity;
-		heardit = true;
+		*heardit = true;
 	}
 	else if (!(self->enemy) &&
 			 (level.sound2_entity_framenum >= (level.framenum - 1)) &&
 			 !(self->spawnflags & 1))
 	{
 		client = level.sound2_entity;
-		heardit = true;
+		*heardit = true;
 	}
 	else
 	{
@@ -674,13 +844,52 @@ FindTarget(edict_t *self)
 
 		if (!client)
 		{
-			return false; /* no clients to get mad at */
+			return NULL; /* no clients to get mad at */
 		}
 	}
 
 	/* if the entity went away, forget it */
 	if (!client || !client->inuse ||
 		(client->client && level.intermissiontime))
+	{
+		return NULL;
+	}
+
+	return client;
+}
+
+/*
+ * Self is currently not attacking anything,
+ * so try to find a target
+ *
+ * Returns TRUE if an enemy was sighted
+ *
+ * When a player fires a missile, the point
+ * of impact becomes a fakeplayer so that
+ * monsters that see the impact will respond
+ * as if they had seen the player.
+ *
+ * To avoid spending too much time, only
+ * a single client (or fakeclient) is
+ * checked each frame. This means multi
+ * player games will have slightly
+ * slower noticing monsters.
+ */
+qboolean
+FindTarget(edict_t *self)
+{
+	edict_t *client;
+	qboolean heardit;
+	int r;
+
+	if (!self)
+	{
+		return false;
+	}
+
+	client = AI_TargetCandidate(self, &heardit);
+
+	if (!client)
 	{
 		return false;
 	}
@@ -855,6 +1064,173 @@ FindTarget(edict_t *self)
 	return true;
 }
 
+/* ========================================================================== */
+
+/*
+ * Allocates the perception results,
+ * called when a level is loaded.
+ */
+void
+AI_ClearPerception(void)
+{
+	perception = gi.TagMalloc(game.maxentities * sizeof(perception_t), TAG_LEVEL);
+}
+
+static void
+AI_AddPercept(perception_t *p, edict_t *other)
+{
+	percept_t *percept;
+
+	/* visible() never traces for an invisible client */
+	if (other->client &&
+		(other->client->invisible_framenum > level.framenum))
+	{
+		return;
+	}
+
+	percept = &p->percepts[p->numpercepts++];
+	percept->other = other;
+	AI_SightSpots(p->self, other, percept->spot1, percept->spot2);
+}
+
+/*
+ * Runs on the worker threads. Only reads the
+ * game state and writes to its own results.
+ */
+static void
+AI_Perceive(void *data, int index)
+{
+	perception_t *p;
+	percept_t *percept;
+	edict_t *self, *client;
+	qboolean heardit;
+	int i;
+
+	p = (perception_t *)data + index;
+	self = p->self;
+	p->numpercepts = 0;
+
+	if (self->enemy && self->enemy->inuse)
+	{
+		AI_AddPercept(p, self->enemy);
+	}
+
+	/* the entity FindTarget() looks at */
+	client = AI_TargetCandidate(self, &heardit);
+
+	if (client && (client != self->enemy))
+	{
+		if ((heardit && (self->spawnflags & 1)) ||
+			((client->light_level > 5) && (range(self, client) != RANGE_FAR)))
+		{
+			AI_AddPercept(p, client);
+		}
+	}
+
+	for (i = 0; i < p->numpercepts; i++)
+	{
+		percept = &p->percepts[i];
+		percept->trace = gi.TraceReentrant(percept->spot1, vec3_origin,
+				vec3_origin, percept->spot2, self, MASK_OPAQUE);
+		percept->visible = (percept->trace.fraction == 1.0) ||
+			(percept->trace.ent == percept->other);
+	}
+}
+
+static qboolean
+AI_SameTrace(const trace_t *a, const trace_t *b)
+{
+	return (a->allsolid == b->allsolid) && (a->startsolid == b->startsolid) &&
+		(a->fraction == b->fraction) && VectorCompare(a->endpos, b->endpos) &&
+		VectorCompare(a->plane.normal, b->plane.normal) &&
+		(a->plane.dist == b->plane.dist) && (a->surface == b->surface) &&
+		(a->contents == b->contents) && (a->ent == b->ent);
+}
+
+/*
+ * Called once each frame before the entities
+ * are run. With g_sight_validate every trace
+ * is done again on the main thread and compared.
+ */
+void
+AI_RunPerception(void)
+{
+	perception_t *p;
+	percept_t *percept;
+	sightcache_t *cache;
+	trace_t trace;
+	edict_t *ent;
+	int i, j, count;
+
+	if (!perception || !g_perception->value || !gi.RunParallel)
+	{
+		return;
+	}
+
+	count = 0;
+
+	for (i = G_NextAwakeEdict(game.maxclients + 1); i < globals.num_edicts;
+		 i = G_NextAwakeEdict(i + 1))
+	{
+		ent = &g_edicts[i];
+
+		if (!ent->inuse || !(ent->svflags & SVF_MONSTER) ||
+			(ent->health <= 0) || ent->deadflag || !ent->think)
+		{
+			continue;
+		}
+
+		/* the same test as G_RunThink() */
+		if ((ent->nextthink <= 0) || (ent->nextthink > level.time + 0.001))
+		{
+			continue;
+		}
+
+		perception[count++].self = ent;
+	}
+
+	if (!count)
+	{
+		return;
+	}
+
+	gi.RunParallel(AI_Perceive, perception, count);
+
+	for (i = 0; i < count; i++)
+	{
+		p = &perception[i];
+
+		for (j = 0; j < p->numpercepts; j++)
+		{
+			percept = &p->percepts[j];
+
+			if (g_sight_validate->value)
+			{
+				trace = gi.trace(percept->spot1, vec3_origin, vec3_origin,
+						percept->spot2, p->self, MASK_OPAQUE);
+
+				if (!AI_SameTrace(&trace, &percept->trace))
+				{
+					gi.dprintf("%s: wrong trace for %i and %i\n", __func__,
+							(int)(p->self - g_edicts),
+							(int)(percept->other - g_edicts));
+					sight_mismatches++;
+				}
+			}
+
+			cache = AI_SightCache(p->self, percept->other);
+			cache->epoch = sight_epoch;
+			cache->self = p->self;
+			cache->other = percept->other;
+			VectorCopy(percept->spot1, cache->spot1);
+			VectorCopy(percept->spot2, cache->spot2);
+			cache->visible = percept->visible;
+			cache->perceived = true;
+			sight_perceived++;
+		}
+	}
+}
+
 /* ============================================================================= */
 
 qboolean
@@ -360,7 +360,7 @@ Cmd_Give_f(edict_t *ent)
 		if (it)
 		{
 			it_ent = G_Spawn();
-			it_ent->classname = it->classname;
+			G_SetClassname(it_ent, it->classname);
 			SpawnItem(it_ent, it);
 			Touch_Item(it_ent, ent, NULL, NULL);
 
@@ -445,7 +445,7 @@ Cmd_Give_f(edict_t *ent)
 	else
 	{
 		it_ent = G_Spawn();
-		it_ent->classname = it->classname;
+		G_SetClassname(it_ent, it->classname);
 		SpawnItem(it_ent, it);
 
 		/* since some items don't actually spawn when you say to .. */
@@ -1619,7 +1619,7 @@ Cmd_SpawnEntity_f(edict_t *ent)
 		ent->spawnflags = atoi(gi.argv(8));
 	}
 
-	ent->classname = G_CopyString(gi.argv(1));
+	G_SetClassname(ent, G_CopyString(gi.argv(1)));
 
 	ED_CallSpawn(ent);
 }
@@ -1634,7 +1634,7 @@ Cmd_SpawnOnStartByClass(char *classname, const vec3_t origin)
 	opponent->s.origin[1] = origin[1];
 	opponent->s.origin[2] = origin[2];
 	// and class
-	opponent->classname = G_CopyString(classname);
+	G_SetClassname(opponent, G_CopyString(classname));
 
 	ED_CallSpawn(opponent);
 
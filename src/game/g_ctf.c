@@ -1137,7 +1137,7 @@ CTFDeadDropFlag(edict_t *self)
 	if (dropped)
 	{
 		dropped->think = CTFDropFlagThink;
-		dropped->nextthink = level.time + CTF_AUTO_FLAG_RETURN_TIMEOUT;
+		G_SetNextThink(dropped, level.time + CTF_AUTO_FLAG_RETURN_TIMEOUT);
 		dropped->touch = CTFDropFlagTouch;
 	}
 }
@@ -1163,7 +1163,7 @@ CTFFlagThink(edict_t *ent)
 		ent->s.frame = 173 + (((ent->s.frame - 173) + 1) % 16);
 	}
 
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 void
@@ -1208,7 +1208,7 @@ CTFFlagSetup(edict_t *ent)
 
 	gi.linkentity(ent);
 
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 	ent->think = CTFFlagThink;
 }
 
@@ -2381,7 +2381,7 @@ TechThink(edict_t *tech)
 	}
 	else
 	{
-		tech->nextthink = level.time + CTF_TECH_TIMEOUT;
+		G_SetNextThink(tech, level.time + CTF_TECH_TIMEOUT);
 		tech->think = TechThink;
 	}
 }
@@ -2392,7 +2392,7 @@ CTFDrop_Tech(edict_t *ent, gitem_t *item)
 	edict_t *tech;
 
 	tech = Drop_Item(ent, item);
-	tech->nextthink = level.time + CTF_TECH_TIMEOUT;
+	G_SetNextThink(tech, level.time + CTF_TECH_TIMEOUT);
 	tech->think = TechThink;
 	ent->client->pers.inventory[ITEM_INDEX(item)] = 0;
 }
@@ -2416,7 +2416,7 @@ CTFDeadDropTech(edict_t *ent)
 			/* hack the velocity to make it bounce random */
 			dropped->velocity[0] = (rand() % 600) - 300;
 			dropped->velocity[1] = (rand() % 600) - 300;
-			dropped->nextthink = level.time + CTF_TECH_TIMEOUT;
+			G_SetNextThink(dropped, level.time + CTF_TECH_TIMEOUT);
 			dropped->think = TechThink;
 			dropped->owner = NULL;
 			ent->client->pers.inventory[ITEM_INDEX(tech)] = 0;
@@ -2435,7 +2435,7 @@ SpawnTech(gitem_t *item, edict_t *spot)
 
 	ent = G_Spawn();
 
-	ent->classname = item->classname;
+	G_SetClassname(ent, item->classname);
 	ent->item = item;
 	ent->spawnflags = DROPPED_ITEM;
 	ent->s.effects = item->world_model_flags;
@@ -2458,7 +2458,7 @@ SpawnTech(gitem_t *item, edict_t *spot)
 	VectorScale(forward, 100, ent->velocity);
 	ent->velocity[2] = 300;
 
-	ent->nextthink = level.time + CTF_TECH_TIMEOUT;
+	G_SetNextThink(ent, level.time + CTF_TECH_TIMEOUT);
 	ent->think = TechThink;
 
 	gi.linkentity(ent);
@@ -2517,7 +2517,7 @@ CTFSetupTechSpawn(void)
 	}
 
 	ent = G_Spawn();
-	ent->nextthink = level.time + 2;
+	G_SetNextThink(ent, level.time + 2);
 	ent->think = SpawnTechs;
 }
 
@@ -3264,7 +3264,7 @@ static void
 misc_ctf_banner_think(edict_t *ent)
 {
 	ent->s.frame = (ent->s.frame + 1) % 16;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 void
@@ -3283,7 +3283,7 @@ SP_misc_ctf_banner(edict_t *ent)
 	gi.linkentity(ent);
 
 	ent->think = misc_ctf_banner_think;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 /*
@@ -3307,7 +3307,7 @@ SP_misc_ctf_small_banner(edict_t *ent)
 	gi.linkentity(ent);
 
 	ent->think = misc_ctf_banner_think;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 /*-----------------------------------------------------------------------*/
@@ -3437,7 +3437,7 @@ CTFResetAllPlayers(void)
 			if ((ent->solid == SOLID_NOT) && (ent->think == DoRespawn) &&
 				(ent->nextthink >= level.time))
 			{
-				ent->nextthink = 0;
+				G_SetNextThink(ent, 0);
 				DoRespawn(ent);
 			}
 		}
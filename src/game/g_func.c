@@ -146,7 +146,7 @@ Move_Final(edict_t *ent)
 			ent->velocity);
 
 	ent->think = Move_Done;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 void
@@ -171,7 +171,7 @@ Move_Begin(edict_t *ent)
 			 ent->moveinfo.speed) / FRAMETIME);
 	ent->moveinfo.remaining_distance -= frames * ent->moveinfo.speed *
 										FRAMETIME;
-	ent->nextthink = level.time + (frames * FRAMETIME);
+	G_SetNextThink(ent, level.time + (frames * FRAMETIME));
 	ent->think = Move_Final;
 }
 
@@ -198,7 +198,7 @@ Move_Calc(edict_t *ent, vec3_t dest, void (*func)(edict_t *))
 		}
 		else
 		{
-			ent->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(ent, level.time + FRAMETIME);
 			ent->think = Move_Begin;
 		}
 	}
@@ -207,7 +207,7 @@ Move_Calc(edict_t *ent, vec3_t dest, void (*func)(edict_t *))
 		/* accelerative */
 		ent->moveinfo.current_speed = 0;
 		ent->think = Think_AccelMove;
-		ent->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(ent, level.time + FRAMETIME);
 	}
 }
 
@@ -255,7 +255,7 @@ AngleMove_Final(edict_t *ent)
 	VectorScale(move, 1.0 / FRAMETIME, ent->avelocity);
 
 	ent->think = AngleMove_Done;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 void
@@ -313,12 +313,12 @@ AngleMove_Begin(edict_t *ent)
 	if (ent->moveinfo.speed >= ent->speed)
 	{
 		/* set nextthink to trigger a think when dest is reached */
-		ent->nextthink = level.time + frames * FRAMETIME;
+		G_SetNextThink(ent, level.time + frames * FRAMETIME);
 		ent->think = AngleMove_Final;
 	}
 	else
 	{
-		ent->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(ent, level.time + FRAMETIME);
 		ent->think = AngleMove_Begin;
 	}
 }
@@ -348,7 +348,7 @@ AngleMove_Calc(edict_t *ent, void (*func)(edict_t *))
 	}
 	else
 	{
-		ent->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(ent, level.time + FRAMETIME);
 		ent->think = AngleMove_Begin;
 	}
 }
@@ -533,7 +533,7 @@ Think_AccelMove(edict_t *ent)
 
 	VectorScale(ent->moveinfo.dir, ent->moveinfo.current_speed * 10,
 			ent->velocity);
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 	ent->think = Think_AccelMove;
 }
 
@@ -559,7 +559,7 @@ plat_hit_top(edict_t *ent)
 	ent->moveinfo.state = STATE_TOP;
 
 	ent->think = plat_go_down;
-	ent->nextthink = level.time + 3;
+	G_SetNextThink(ent, level.time + 3);
 }
 
 void
@@ -735,7 +735,7 @@ wait_and_change(edict_t* ent, void (*afterwaitfunc)(edict_t *))
 		{
 			ent->moveinfo.endfunc = afterwaitfunc;
 			ent->think = wait_and_change_think;
-			ent->nextthink = level.time + waittime;
+			G_SetNextThink(ent, level.time + waittime);
 		}
 	}
 	else
@@ -772,7 +772,7 @@ Touch_Plat_Center(edict_t *ent, edict_t *other, cplane_t *plane /* unsed */,
 	else if (ent->moveinfo.state == STATE_TOP)
 	{
 		/* the player is still on the plat, so delay going down */
-		ent->nextthink = level.time + 1;
+		G_SetNextThink(ent, level.time + 1);
 	}
 }
 
@@ -1014,7 +1014,7 @@ plat2_hit_top(edict_t *ent)
 		if (!(ent->spawnflags & PLAT2_TOGGLE))
 		{
 			ent->think = plat2_go_down;
-			ent->nextthink = level.time + 5.0;
+			G_SetNextThink(ent, level.time + 5.0);
 		}
 
 		if (deathmatch->value)
@@ -1031,7 +1031,7 @@ plat2_hit_top(edict_t *ent)
 	{
 		ent->plat2flags = 0;
 		ent->think = plat2_go_down;
-		ent->nextthink = level.time + 2.0;
+		G_SetNextThink(ent, level.time + 2.0);
 		ent->last_move_time = level.time;
 	}
 	else
@@ -1072,7 +1072,7 @@ plat2_hit_bottom(edict_t *ent)
 		if (!(ent->spawnflags & PLAT2_TOGGLE))
 		{
 			ent->think = plat2_go_up;
-			ent->nextthink = level.time + 5.0;
+			G_SetNextThink(ent, level.time + 5.0);
 		}
 
 		if (deathmatch->value)
@@ -1088,7 +1088,7 @@ plat2_hit_bottom(edict_t *ent)
 	{
 		ent->plat2flags = 0;
 		ent->think = plat2_go_up;
-		ent->nextthink = level.time + 2.0;
+		G_SetNextThink(ent, level.time + 2.0);
 		ent->last_move_time = level.time;
 	}
 	else
@@ -1234,12 +1234,12 @@ plat2_operate(edict_t *ent, edict_t *other)
 	if (ent->moveinfo.state == STATE_BOTTOM)
 	{
 		ent->think = plat2_go_up;
-		ent->nextthink = level.time + pauseTime;
+		G_SetNextThink(ent, level.time + pauseTime);
 	}
 	else
 	{
 		ent->think = plat2_go_down;
-		ent->nextthink = level.time + pauseTime;
+		G_SetNextThink(ent, level.time + pauseTime);
 	}
 }
 
@@ -1556,7 +1556,7 @@ rotating_accel(edict_t *self)
 		current_speed += self->accel;
 		VectorScale(self->movedir, current_speed, self->avelocity);
 		self->think = rotating_accel;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -1583,7 +1583,7 @@ rotating_decel(edict_t *self)
 		current_speed -= self->decel;
 		VectorScale(self->movedir, current_speed, self->avelocity);
 		self->think = rotating_decel;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -1833,7 +1833,7 @@ button_wait(edict_t *self)
 
 	if (self->moveinfo.wait >= 0)
 	{
-		self->nextthink = level.time + self->moveinfo.wait;
+		G_SetNextThink(self, level.time + self->moveinfo.wait);
 		self->think = button_return;
 	}
 }
@@ -2084,7 +2084,7 @@ door_hit_top(edict_t *self)
 	if (self->moveinfo.wait >= 0)
 	{
 		self->think = door_go_down;
-		self->nextthink = level.time + self->moveinfo.wait;
+		G_SetNextThink(self, level.time + self->moveinfo.wait);
 	}
 }
 
@@ -2168,7 +2168,7 @@ door_go_up(edict_t *self, edict_t *activator)
 		/* reset top wait time */
 		if (self->moveinfo.wait >= 0)
 		{
-			self->nextthink = level.time + self->moveinfo.wait;
+			G_SetNextThink(self, level.time + self->moveinfo.wait);
 		}
 
 		return;
@@ -2220,7 +2220,7 @@ smart_water_go_up(edict_t *self)
 		/* reset top wait time */
 		if (self->moveinfo.wait >= 0)
 		{
-			self->nextthink = level.time + self->moveinfo.wait;
+			G_SetNextThink(self, level.time + self->moveinfo.wait);
 		}
 
 		return;
@@ -2231,7 +2231,7 @@ smart_water_go_up(edict_t *self)
 		if (self->absmax[2] >= self->health)
 		{
 			VectorClear(self->velocity);
-			self->nextthink = 0;
+			G_SetNextThink(self, 0);
 			self->moveinfo.state = STATE_TOP;
 			return;
 		}
@@ -2309,7 +2309,7 @@ smart_water_go_up(edict_t *self)
 	}
 
 	self->think = smart_water_go_up;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void
@@ -2740,7 +2740,7 @@ SP_func_door(edict_t *ent)
 
 	gi.linkentity(ent);
 
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	if (ent->health || ent->targetname)
 	{
@@ -2779,7 +2779,7 @@ Door_Activate(edict_t *self, edict_t *other /* unused */,
 		self->think = Think_SpawnDoorTrigger;
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 /*
@@ -2941,7 +2941,7 @@ SP_func_door_rotating(edict_t *ent)
 
 	gi.linkentity(ent);
 
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	if (ent->health || ent->targetname)
 	{
@@ -2957,7 +2957,7 @@ SP_func_door_rotating(edict_t *ent)
 		ent->takedamage = DAMAGE_NO;
 		ent->die = NULL;
 		ent->think = NULL;
-		ent->nextthink = 0;
+		G_SetNextThink(ent, 0);
 		ent->use = Door_Activate;
 	}
 }
@@ -3093,7 +3093,7 @@ SP_func_water(edict_t *self)
 		self->spawnflags |= DOOR_TOGGLE;
 	}
 
-	self->classname = "func_door";
+	G_SetClassname(self, "func_door");
 
 	gi.linkentity(self);
 }
@@ -3184,7 +3184,7 @@ train_wait(edict_t *self)
 	{
 		if (self->moveinfo.wait > 0)
 		{
-			self->nextthink = level.time + self->moveinfo.wait;
+			G_SetNextThink(self, level.time + self->moveinfo.wait);
 			self->think = train_next;
 		}
 		else if (self->spawnflags & TRAIN_TOGGLE)
@@ -3193,7 +3193,7 @@ train_wait(edict_t *self)
 			train_next(self);
 			self->spawnflags &= ~TRAIN_START_ON;
 			VectorClear(self->velocity);
-			self->nextthink = 0;
+			G_SetNextThink(self, 0);
 		}
 
 		if (!(self->flags & FL_TEAMSLAVE))
@@ -3462,7 +3462,7 @@ func_train_find(edict_t *self)
 
 	if (self->spawnflags & TRAIN_START_ON)
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 		self->think = train_next;
 		self->activator = self;
 	}
@@ -3488,7 +3488,7 @@ train_use(edict_t *self, edict_t *other /* unused */,
 
 		self->spawnflags &= ~TRAIN_START_ON;
 		VectorClear(self->velocity);
-		self->nextthink = 0;
+		G_SetNextThink(self, 0);
 	}
 	else
 	{
@@ -3552,7 +3552,7 @@ SP_func_train(edict_t *self)
 	{
 		/* start trains on the second frame, to make
 		 * sure their targets have had a chance to spawn */
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 		self->think = func_train_find;
 	}
 	else
@@ -3652,7 +3652,7 @@ SP_trigger_elevator(edict_t *self)
 	}
 
 	self->think = trigger_elevator_init;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 /* ==================================================================== */
@@ -3681,7 +3681,7 @@ func_timer_think(edict_t *self)
 	}
 
 	G_UseTargets(self, self->activator);
-	self->nextthink = level.time + self->wait + crandom() * self->random;
+	G_SetNextThink(self, level.time + self->wait + crandom() * self->random);
 }
 
 void
@@ -3697,14 +3697,14 @@ func_timer_use(edict_t *self, edict_t *other /* unused */, edict_t *activator)
 	/* if on, turn it off */
 	if (self->nextthink)
 	{
-		self->nextthink = 0;
+		G_SetNextThink(self, 0);
 		return;
 	}
 
 	/* turn it on */
 	if (self->delay)
 	{
-		self->nextthink = level.time + self->delay;
+		G_SetNextThink(self, level.time + self->delay);
 	}
 	else
 	{
@@ -3737,8 +3737,8 @@ SP_func_timer(edict_t *self)
 
 	if (self->spawnflags & 1)
 	{
-		self->nextthink = level.time + 1.0 + st.pausetime + self->delay +
-						  self->wait + crandom() * self->random;
+		G_SetNextThink(self, level.time + 1.0 + st.pausetime + self->delay +
+						  self->wait + crandom() * self->random);
 		self->activator = self;
 	}
 
@@ -3850,7 +3850,7 @@ door_secret_move1(edict_t *self)
 		return;
 	}
 
-	self->nextthink = level.time + 1.0;
+	G_SetNextThink(self, level.time + 1.0);
 	self->think = door_secret_move2;
 }
 
@@ -3878,7 +3878,7 @@ door_secret_move3(edict_t *self)
 		return;
 	}
 
-	self->nextthink = level.time + self->wait;
+	G_SetNextThink(self, level.time + self->wait);
 	self->think = door_secret_move4;
 }
 
@@ -3901,7 +3901,7 @@ door_secret_move5(edict_t *self)
 		return;
 	}
 
-	self->nextthink = level.time + 1.0;
+	G_SetNextThink(self, level.time + 1.0);
 	self->think = door_secret_move6;
 }
 
@@ -4066,7 +4066,7 @@ SP_func_door_secret(edict_t *ent)
 		ent->touch = door_touch;
 	}
 
-	ent->classname = "func_door";
+	G_SetClassname(ent, "func_door");
 
 	gi.linkentity(ent);
 }
@@ -4096,7 +4096,7 @@ use_killbox(edict_t *self, edict_t *other /* unused */,
 	if (!self->count)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 }
 
@@ -4131,14 +4131,14 @@ rotating_light_alarm(edict_t *self)
 	if (self->spawnflags & START_OFF)
 	{
 		self->think = NULL;
-		self->nextthink = 0;
+		G_SetNextThink(self, 0);
 	}
 	else
 	{
 		gi.sound(self, CHAN_NO_PHS_ADD + CHAN_VOICE,
 				self->moveinfo.sound_start, 1,
 				ATTN_STATIC, 0);
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 }
 
@@ -4164,7 +4164,7 @@ rotating_light_killed(edict_t *self, edict_t *inflictor /* unused */,
 	self->use = NULL;
 
 	self->think = G_FreeEdict;
-	self->nextthink = level.time + 0.1;
+	G_SetNextThink(self, level.time + 0.1);
 }
 
 void
@@ -4184,7 +4184,7 @@ rotating_light_use(edict_t *self, edict_t *other /* unused */,
 		if (self->spawnflags & 2)
 		{
 			self->think = rotating_light_alarm;
-			self->nextthink = level.time + 0.1;
+			G_SetNextThink(self, level.time + 0.1);
 		}
 	}
 	else
@@ -4261,7 +4261,7 @@ object_repair_fx(edict_t *ent)
 		return;
 	}
 
-	ent->nextthink = level.time + ent->delay;
+	G_SetNextThink(ent, level.time + ent->delay);
 
 	if (ent->health <= 100)
 	{
@@ -4288,7 +4288,7 @@ object_repair_dead(edict_t *ent)
 	}
 
 	G_UseTargets(ent, ent);
-	ent->nextthink = level.time + 0.1;
+	G_SetNextThink(ent, level.time + 0.1);
 	ent->think = object_repair_fx;
 }
 
@@ -4302,12 +4302,12 @@ object_repair_sparks(edict_t *ent)
 
 	if (ent->health < 0)
 	{
-		ent->nextthink = level.time + 0.1;
+		G_SetNextThink(ent, level.time + 0.1);
 		ent->think = object_repair_dead;
 		return;
 	}
 
-	ent->nextthink = level.time + ent->delay;
+	G_SetNextThink(ent, level.time + ent->delay);
 
 	gi.WriteByte(svc_temp_entity);
 	gi.WriteByte(TE_WELDING_SPARKS);
@@ -4328,9 +4328,9 @@ SP_object_repair(edict_t *ent)
 
 	ent->movetype = MOVETYPE_NONE;
 	ent->solid = SOLID_BBOX;
-	ent->classname = "object_repair";
+	G_SetClassname(ent, "object_repair");
 	ent->think = object_repair_sparks;
-	ent->nextthink = level.time + 1.0;
+	G_SetNextThink(ent, level.time + 1.0);
 	ent->health = 100;
 
 	if (!ent->delay)
@@ -199,7 +199,7 @@ SetRespawn(edict_t *ent, float delay)
 	ent->flags |= FL_RESPAWN;
 	ent->svflags |= SVF_NOCLIENT;
 	ent->solid = SOLID_NOT;
-	ent->nextthink = level.time + delay;
+	G_SetNextThink(ent, level.time + delay);
 	ent->think = DoRespawn;
 	gi.linkentity(ent);
 }
@@ -1326,7 +1326,7 @@ MegaHealth_think(edict_t *self)
 	if ((self->owner->health > self->owner->max_health)
 		&& !CTFHasRegeneration(self->owner))
 	{
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 		self->owner->health -= 1;
 		return;
 	}
@@ -1380,7 +1380,7 @@ Pickup_Health(edict_t *ent, edict_t *other)
 	if ((ent->style & HEALTH_TIMED) && !CTFHasRegeneration(other))
 	{
 		ent->think = MegaHealth_think;
-		ent->nextthink = level.time + 5;
+		G_SetNextThink(ent, level.time + 5);
 		ent->owner = other;
 		ent->flags |= FL_RESPAWN;
 		ent->svflags |= SVF_NOCLIENT;
@@ -1820,7 +1820,7 @@ drop_make_touchable(edict_t *ent)
 
 	if (deathmatch->value)
 	{
-		ent->nextthink = level.time + 29;
+		G_SetNextThink(ent, level.time + 29);
 		ent->think = G_FreeEdict;
 	}
 }
@@ -1839,7 +1839,7 @@ Drop_Item(edict_t *ent, gitem_t *item)
 
 	dropped = G_Spawn();
 
-	dropped->classname = item->classname;
+	G_SetClassname(dropped, item->classname);
 	dropped->item = item;
 	dropped->spawnflags = DROPPED_ITEM;
 	dropped->s.effects = item->world_model_flags;
@@ -1884,7 +1884,7 @@ Drop_Item(edict_t *ent, gitem_t *item)
 	dropped->velocity[2] = 300;
 
 	dropped->think = drop_make_touchable;
-	dropped->nextthink = level.time + 1;
+	G_SetNextThink(dropped, level.time + 1);
 
 	gi.linkentity(dropped);
 
@@ -2057,7 +2057,7 @@ droptofloor(edict_t *ent)
 
 		if (ent == ent->teammaster)
 		{
-			ent->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(ent, level.time + FRAMETIME);
 			ent->think = DoRespawn;
 		}
 	}
@@ -2218,7 +2218,7 @@ SetTriggeredSpawn(edict_t *ent)
 	}
 
 	ent->think = NULL;
-	ent->nextthink = 0;
+	G_SetNextThink(ent, 0);
 	ent->use = Item_TriggeredSpawn;
 	ent->svflags |= SVF_NOCLIENT;
 	ent->solid = SOLID_NOT;
@@ -2391,7 +2391,7 @@ SpawnItem(edict_t *ent, gitem_t *item)
 	}
 
 	ent->item = item;
-	ent->nextthink = level.time + 2 * FRAMETIME; /* items start after other solids */
+	G_SetNextThink(ent, level.time + 2 * FRAMETIME); /* items start after other solids */
 	ent->think = droptofloor;
 	ent->s.effects = item->world_model_flags;
 	ent->s.renderfx = RF_GLOW;
@@ -4512,7 +4512,7 @@ SP_item_foodcube(edict_t *self)
 	self->spawnflags |= DROPPED_ITEM;
 	self->style = HEALTH_IGNORE_MAX;
 	gi.soundindex("items/s_health.wav");
-	self->classname = "foodcube";
+	G_SetClassname(self, "foodcube");
 }
 
 void
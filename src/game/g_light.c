@@ -30,7 +30,7 @@
 void
 env_fire_think(edict_t *self)
 {
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	gi.WriteByte(svc_temp_entity);
 	gi.WriteByte(TE_FLAME);
 	gi.WritePosition(self->s.origin);
@@ -73,7 +73,7 @@ SP_env_fire(edict_t *self)
 	self->movetype = MOVETYPE_NONE;
 	self->solid = SOLID_NOT;
 	self->think = env_fire_think;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	gi.linkentity(self);
 }
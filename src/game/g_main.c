@@ -25,6 +25,8 @@
  * =======================================================================
  */
 
+#include <stddef.h>
+
 #include "header/local.h"
 
 game_locals_t game;
@@ -60,6 +62,9 @@ cvar_t *g_select_empty;
 cvar_t *dedicated;
 cvar_t *g_footsteps;
 cvar_t *g_monsterfootsteps;
+cvar_t *g_monster_lod;
+cvar_t *g_sight_validate;
+cvar_t *g_perception;
 cvar_t *g_fix_triggered;
 cvar_t *g_commanderbody_nogod;
 
@@ -121,6 +126,32 @@ ShutdownGame(void)
 	SpawnFree();
 }
 
+/*
+ * Copies as much of the imports as the engine
+ * has, the newer ones stay NULL with an older
+ * engine.
+ */
+static void
+G_CopyImports(const game_import_t *import)
+{
+	size_t size, minsize;
+
+	minsize = offsetof(game_import_t, RunParallel);
+	size = (size_t)import->cvar(GAME_IMPORT_SIZE_CVAR, "0", CVAR_NOSET)->value;
+
+	if (size < minsize)
+	{
+		size = minsize;
+	}
+	else if (size > sizeof(gi))
+	{
+		size = sizeof(gi);
+	}
+
+	memset(&gi, 0, sizeof(gi));
+	memcpy(&gi, import, size);
+}
+
 /*
  * Returns a pointer to the structure
  * with all entry points and global
@@ -129,7 +160,8 @@ ShutdownGame(void)
 Q2_DLL_EXPORTED game_export_t *
 GetGameAPI(game_import_t *import)
 {
-	gi = *import;
+	G_CopyImports(import);
+	AI_InitSight();
 
 	globals.apiversion = GAME_API_VERSION;
 	globals.Init = InitGame;
@@ -227,7 +259,7 @@ CreateTargetChangeLevel(char *map)
 	}
 
 	ent = G_Spawn();
-	ent->classname = "target_changelevel";
+	G_SetClassname(ent, "target_changelevel");
 	Com_sprintf(level.nextmap, sizeof(level.nextmap), "%s", map);
 	ent->map = level.nextmap;
 	return ent;
@@ -474,6 +506,9 @@ G_RunFrame(void)
 	level.framenum++;
 	level.time = level.framenum * FRAMETIME;
 
+	/* wake up the sleeping edicts that think now */
+	G_RunThinkWheel();
+
 	gibsthisframe = 0;
 	debristhisframe = 0;
 
@@ -487,15 +522,20 @@ G_RunFrame(void)
 		return;
 	}
 
+	/* trace what the monsters are going to look at */
+	AI_RunPerception();
+
 	/* treat each object in turn
 	   even the world gets a chance
-	   to think */
-	ent = &g_edicts[0];
-
-	for (i = 0; i < globals.num_edicts; i++, ent++)
+	   to think, sleeping edicts
+	   are skipped */
+	for (i = 0; i < globals.num_edicts; i = G_NextAwakeEdict(i + 1))
 	{
+		ent = &g_edicts[i];
+
 		if (!ent->inuse)
 		{
+			G_CheckSleep(ent);
 			continue;
 		}
 
@@ -526,6 +566,7 @@ G_RunFrame(void)
 		}
 
 		G_RunEntity(ent);
+		G_CheckSleep(ent);
 	}
 
 	/* see if it is time to end a deathmatch */
@@ -137,12 +137,12 @@ gib_think(edict_t *self)
 	}
 
 	self->s.frame++;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	if (self->s.frame == 10)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 8 + random() * 10;
+		G_SetNextThink(self, level.time + 8 + random() * 10);
 	}
 }
 
@@ -176,7 +176,7 @@ gib_touch(edict_t *self, edict_t *other /* unused */, cplane_t *plane, csurface_
 		{
 			self->s.frame++;
 			self->think = gib_think;
-			self->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(self, level.time + FRAMETIME);
 		}
 	}
 }
@@ -256,7 +256,7 @@ ThrowGib(edict_t *self, const char *gibname, int damage, gibtype_t type)
 	gib->avelocity[2] = random() * 600;
 
 	gib->think = G_FreeEdict;
-	gib->nextthink = level.time + 10 + random() * 10;
+	G_SetNextThink(gib, level.time + 10 + random() * 10);
 	gib->s.renderfx |= RF_IR_VISIBLE;
 
 	gi.linkentity(gib);
@@ -287,7 +287,7 @@ ThrowHead(edict_t *self, const char *gibname, int damage, gibtype_t type)
 	self->flags |= FL_NO_KNOCKBACK;
 	self->svflags &= ~SVF_MONSTER;
 	self->takedamage = DAMAGE_YES;
-	self->targetname = NULL;
+	G_SetTargetname(self, NULL);
 	self->die = gib_die;
 
 	// The entity still has the monsters clipmaks.
@@ -314,7 +314,7 @@ ThrowHead(edict_t *self, const char *gibname, int damage, gibtype_t type)
 	self->avelocity[YAW] = crandom() * 600;
 
 	self->think = G_FreeEdict;
-	self->nextthink = level.time + 10 + random() * 10;
+	G_SetNextThink(self, level.time + 10 + random() * 10);
 
 	gi.linkentity(self);
 }
@@ -382,7 +382,7 @@ ThrowGibACID(edict_t *self, const char *gibname, int damage, gibtype_t type)
 	gib->avelocity[2] = random() * 600;
 
 	gib->think = G_FreeEdict;
-	gib->nextthink = level.time + 10 + random() * 10;
+	G_SetNextThink(gib, level.time + 10 + random() * 10);
 
 	gi.linkentity(gib);
 }
@@ -437,7 +437,7 @@ ThrowHeadACID(edict_t *self, const char *gibname, int damage, gibtype_t type)
 	self->avelocity[YAW] = crandom() * 600;
 
 	self->think = G_FreeEdict;
-	self->nextthink = level.time + 10 + random() * 10;
+	G_SetNextThink(self, level.time + 10 + random() * 10);
 
 	gi.linkentity(self);
 }
@@ -484,6 +484,7 @@ ThrowClientHead(edict_t *self, int damage)
 	self->movetype = MOVETYPE_BOUNCE;
 	VelocityForDamage(damage, vd);
 	VectorAdd(self->velocity, vd, self->velocity);
+	G_WakeEdict(self);
 
 	if (self->client) /* bodies in the queue don't have a client anymore */
 	{
@@ -493,7 +494,7 @@ ThrowClientHead(edict_t *self, int damage)
 	else
 	{
 		self->think = NULL;
-		self->nextthink = 0;
+		G_SetNextThink(self, 0);
 	}
 
 	gi.linkentity(self);
@@ -550,10 +551,10 @@ ThrowDebris(edict_t *self, char *modelname, float speed, vec3_t origin)
 	chunk->avelocity[1] = random() * 600;
 	chunk->avelocity[2] = random() * 600;
 	chunk->think = G_FreeEdict;
-	chunk->nextthink = level.time + 5 + random() * 5;
+	G_SetNextThink(chunk, level.time + 5 + random() * 5);
 	chunk->s.frame = 0;
 	chunk->flags = 0;
-	chunk->classname = "debris";
+	G_SetClassname(chunk, "debris");
 	chunk->takedamage = DAMAGE_YES;
 	chunk->die = debris_die;
 	chunk->health = 250;
@@ -851,7 +852,7 @@ viewthing_think(edict_t *ent)
 	}
 
 	ent->s.frame = (ent->s.frame + 1) % 7;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	if (ent->spawnflags)
 	{
@@ -879,7 +880,7 @@ SP_viewthing(edict_t *ent)
 	VectorSet(ent->maxs, 16, 16, 32);
 	ent->s.modelindex = gi.modelindex("models/objects/banner/tris.md2");
 	gi.linkentity(ent);
-	ent->nextthink = level.time + 0.5;
+	G_SetNextThink(ent, level.time + 0.5);
 	ent->think = viewthing_think;
 	return;
 }
@@ -1173,7 +1174,7 @@ SP_func_object(edict_t *self)
 		self->solid = SOLID_BSP;
 		self->movetype = MOVETYPE_PUSH;
 		self->think = func_object_release;
-		self->nextthink = level.time + 2 * FRAMETIME;
+		G_SetNextThink(self, level.time + 2 * FRAMETIME);
 	}
 	else
 	{
@@ -1572,7 +1573,7 @@ barrel_delay(edict_t *self, edict_t *inflictor /* unused */, edict_t *attacker,
 	}
 
 	self->takedamage = DAMAGE_NO;
-	self->nextthink = level.time + 2 * FRAMETIME;
+	G_SetNextThink(self, level.time + 2 * FRAMETIME);
 	self->think = barrel_explode;
 	self->activator = attacker;
 }
@@ -1587,7 +1588,7 @@ barrel_think(edict_t *self)
 
 	/* the think needs to be first since later stuff may override. */
 	self->think = barrel_think;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	M_CatagorizePosition(self);
 	self->flags |= FL_IMMUNE_SLIME;
@@ -1605,7 +1606,7 @@ barrel_start(edict_t *self)
 
 	M_droptofloor(self);
 	self->think = barrel_think;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void
@@ -1656,7 +1657,7 @@ SP_misc_explobox(edict_t *self)
 
 	self->touch = barrel_touch;
 	self->think = barrel_start;
-	self->nextthink = level.time + 2 * FRAMETIME;
+	G_SetNextThink(self, level.time + 2 * FRAMETIME);
 
 	gi.linkentity(self);
 }
@@ -1687,12 +1688,12 @@ misc_blackhole_think(edict_t *self)
 
 	if (++self->s.frame < 19)
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 	else
 	{
 		self->s.frame = 0;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -1720,7 +1721,7 @@ SP_misc_blackhole(edict_t *ent)
 	ent->use = misc_blackhole_use;
 	ent->think = misc_blackhole_think;
 	ent->prethink = misc_blackhole_transparent;
-	ent->nextthink = level.time + 2 * FRAMETIME;
+	G_SetNextThink(ent, level.time + 2 * FRAMETIME);
 	gi.linkentity(ent);
 }
 
@@ -1739,12 +1740,12 @@ misc_eastertank_think(edict_t *self)
 
 	if (++self->s.frame < 293)
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 	else
 	{
 		self->s.frame = 254;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -1763,7 +1764,7 @@ SP_misc_eastertank(edict_t *ent)
 	ent->s.modelindex = gi.modelindex("models/monsters/tank/tris.md2");
 	ent->s.frame = 254;
 	ent->think = misc_eastertank_think;
-	ent->nextthink = level.time + 2 * FRAMETIME;
+	G_SetNextThink(ent, level.time + 2 * FRAMETIME);
 	gi.linkentity(ent);
 }
 
@@ -1782,12 +1783,12 @@ misc_easterchick_think(edict_t *self)
 
 	if (++self->s.frame < 247)
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 	else
 	{
 		self->s.frame = 208;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -1806,7 +1807,7 @@ SP_misc_easterchick(edict_t *ent)
 	ent->s.modelindex = gi.modelindex("models/monsters/bitch/tris.md2");
 	ent->s.frame = 208;
 	ent->think = misc_easterchick_think;
-	ent->nextthink = level.time + 2 * FRAMETIME;
+	G_SetNextThink(ent, level.time + 2 * FRAMETIME);
 	gi.linkentity(ent);
 }
 
@@ -1823,12 +1824,12 @@ misc_easterchick2_think(edict_t *self)
 
 	if (++self->s.frame < 287)
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 	else
 	{
 		self->s.frame = 248;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -1847,7 +1848,7 @@ SP_misc_easterchick2(edict_t *ent)
 	ent->s.modelindex = gi.modelindex("models/monsters/bitch/tris.md2");
 	ent->s.frame = 248;
 	ent->think = misc_easterchick2_think;
-	ent->nextthink = level.time + 2 * FRAMETIME;
+	G_SetNextThink(ent, level.time + 2 * FRAMETIME);
 	gi.linkentity(ent);
 }
 
@@ -1869,11 +1870,11 @@ commander_body_think(edict_t *self)
 
 	if (++self->s.frame < 24)
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 	else
 	{
-		self->nextthink = 0;
+		G_SetNextThink(self, 0);
 	}
 
 	if (self->s.frame == 22)
@@ -1892,7 +1893,7 @@ commander_body_use(edict_t *self, edict_t *other /* unused */, edict_t *activato
 	}
 
 	self->think = commander_body_think;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	gi.sound(self, CHAN_BODY, gi.soundindex("tank/pain.wav"), 1, ATTN_NORM, 0);
 }
 
@@ -1974,7 +1975,7 @@ SP_monster_commander_body(edict_t *self)
 	gi.soundindex("tank/pain.wav");
 
 	self->think = commander_body_drop;
-	self->nextthink = level.time + 5 * FRAMETIME;
+	G_SetNextThink(self, level.time + 5 * FRAMETIME);
 }
 
 /* ===================================================== */
@@ -1994,7 +1995,7 @@ misc_banner_think(edict_t *ent)
 	}
 
 	ent->s.frame = (ent->s.frame + 1) % 16;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 void
@@ -2012,7 +2013,7 @@ SP_misc_banner(edict_t *ent)
 	gi.linkentity(ent);
 
 	ent->think = misc_banner_think;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 /* ===================================================== */
@@ -2164,7 +2165,7 @@ SP_misc_viper(edict_t *ent)
 	VectorSet(ent->maxs, 16, 16, 32);
 
 	ent->think = func_train_find;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 	ent->use = misc_viper_use;
 	ent->svflags |= SVF_NOCLIENT;
 	ent->moveinfo.accel = ent->moveinfo.decel = ent->moveinfo.speed =
@@ -2205,7 +2206,7 @@ SP_misc_crashviper(edict_t *ent)
 	VectorSet(ent->maxs, 16, 16, 32);
 
 	ent->think = func_train_find;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 	ent->use = misc_viper_use;
 	ent->svflags |= SVF_NOCLIENT;
 	ent->moveinfo.accel = ent->moveinfo.decel = ent->moveinfo.speed = ent->speed;
@@ -2366,7 +2367,7 @@ misc_viper_missile_use(edict_t *self, edict_t *other, edict_t *activator)
 
 	monster_fire_rocket(self, start, dir, self->dmg, 500, MZ2_CHICK_ROCKET_1);
 
-	self->nextthink = level.time + 0.1;
+	G_SetNextThink(self, level.time + 0.1);
 	self->think = G_FreeEdict;
 }
 
@@ -2450,7 +2451,7 @@ SP_misc_strogg_ship(edict_t *ent)
 	VectorSet(ent->maxs, 16, 16, 32);
 
 	ent->think = func_train_find;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 	ent->use = misc_strogg_ship_use;
 	ent->svflags |= SVF_NOCLIENT;
 	ent->moveinfo.accel = ent->moveinfo.decel =
@@ -2492,7 +2493,7 @@ SP_misc_transport(edict_t *ent)
 	VectorSet(ent->maxs, 16, 16, 32);
 
 	ent->think = func_train_find;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 	ent->use = misc_strogg_ship_use;
 	ent->svflags |= SVF_NOCLIENT;
 	ent->moveinfo.accel = ent->moveinfo.decel = ent->moveinfo.speed = ent->speed;
@@ -2522,7 +2523,7 @@ misc_satellite_dish_think(edict_t *self)
 
 	if (self->s.frame < 38)
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -2536,7 +2537,7 @@ misc_satellite_dish_use(edict_t *self, edict_t *other /* unused */, edict_t *act
 
 	self->s.frame = 0;
 	self->think = misc_satellite_dish_think;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void
@@ -2621,7 +2622,7 @@ SP_misc_gib_arm(edict_t *ent)
 	ent->avelocity[1] = random() * 200;
 	ent->avelocity[2] = random() * 200;
 	ent->think = G_FreeEdict;
-	ent->nextthink = level.time + 30;
+	G_SetNextThink(ent, level.time + 30);
 	gi.linkentity(ent);
 }
 
@@ -2649,7 +2650,7 @@ SP_misc_gib_leg(edict_t *ent)
 	ent->avelocity[1] = random() * 200;
 	ent->avelocity[2] = random() * 200;
 	ent->think = G_FreeEdict;
-	ent->nextthink = level.time + 30;
+	G_SetNextThink(ent, level.time + 30);
 	gi.linkentity(ent);
 }
 
@@ -2677,7 +2678,7 @@ SP_misc_gib_head(edict_t *ent)
 	ent->avelocity[1] = random() * 200;
 	ent->avelocity[2] = random() * 200;
 	ent->think = G_FreeEdict;
-	ent->nextthink = level.time + 30;
+	G_SetNextThink(ent, level.time + 30);
 	gi.linkentity(ent);
 }
 
@@ -2963,7 +2964,7 @@ func_clock_think(edict_t *self)
 		if (!(self->spawnflags & 8))
 		{
 			self->think = G_FreeEdict;
-			self->nextthink = level.time + 1;
+			G_SetNextThink(self, level.time + 1);
 			return;
 		}
 
@@ -2975,7 +2976,7 @@ func_clock_think(edict_t *self)
 		}
 	}
 
-	self->nextthink = level.time + 1;
+	G_SetNextThink(self, level.time + 1);
 }
 
 void
@@ -3041,7 +3042,7 @@ SP_func_clock(edict_t *self)
 	}
 	else
 	{
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 }
 
@@ -3185,7 +3186,7 @@ amb4_think(edict_t *ent)
 		return;
 	}
 
-	ent->nextthink = level.time + 2.0;
+	G_SetNextThink(ent, level.time + 2.0);
 	gi.sound(ent, CHAN_VOICE, amb4sound, 1, ATTN_NONE, 0);
 }
 
@@ -3198,7 +3199,7 @@ SP_misc_amb4(edict_t *ent)
 	}
 
 	ent->think = amb4_think;
-	ent->nextthink = level.time + 1;
+	G_SetNextThink(ent, level.time + 1);
 	amb4sound = gi.soundindex("world/amb4.wav");
 	gi.linkentity(ent);
 }
@@ -3451,7 +3452,7 @@ misc_player_mannequin_think(edict_t * self)
 		M_ChangeYaw(self);
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void
@@ -3584,7 +3585,7 @@ SP_misc_player_mannequin(edict_t * self)
 	}
 
 	self->think = misc_player_mannequin_think;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	if (self->targetname)
 	{
@@ -3635,7 +3636,7 @@ SP_npc_timeminder(edict_t *self)
 	self->monsterinfo.action = "idle";
 	self->think = object_think;
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	gi.linkentity(self);
 }
@@ -247,7 +247,7 @@ dabeam_hit(edict_t *self)
 	}
 
 	VectorCopy(tr.endpos, self->s.old_origin);
-	self->nextthink = level.time + 0.1;
+	G_SetNextThink(self, level.time + 0.1);
 	self->think = G_FreeEdict;
 }
 
@@ -302,7 +302,7 @@ monster_dabeam(edict_t *self)
 	}
 
 	self->think = dabeam_hit;
-	self->nextthink = level.time + 0.1;
+	G_SetNextThink(self, level.time + 0.1);
 	VectorSet(self->mins, -8, -8, -8);
 	VectorSet(self->maxs, 8, 8, 8);
 	gi.linkentity(self);
@@ -403,7 +403,7 @@ M_FliesOn(edict_t *self)
 	self->s.effects |= EF_FLIES;
 	self->s.sound = gi.soundindex("infantry/inflies1.wav");
 	self->think = M_FliesOff;
-	self->nextthink = level.time + 60;
+	G_SetNextThink(self, level.time + 60);
 }
 
 void
@@ -425,7 +425,7 @@ M_FlyCheck(edict_t *self)
 	}
 
 	self->think = M_FliesOn;
-	self->nextthink = level.time + 5 + 10 * random();
+	G_SetNextThink(self, level.time + 5 + 10 * random());
 }
 
 void
@@ -1001,7 +1001,7 @@ M_MoveFrame(edict_t *self)
 		return;
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	if ((self->monsterinfo.nextframe) &&
 		(self->monsterinfo.nextframe >= firstframe) &&
@@ -1240,7 +1240,7 @@ monster_dynamic_dead(edict_t *self)
 
 	self->movetype = MOVETYPE_TOSS;
 	self->svflags |= SVF_DEADMONSTER;
-	self->nextthink = 0;
+	G_SetNextThink(self, 0);
 	gi.linkentity(self);
 }
 
@@ -1443,7 +1443,7 @@ void
 object_think(edict_t *self)
 {
 	M_SetAnimGroupFrame(self, self->monsterinfo.action, false);
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 static const char *object_actions[] = {
@@ -1488,11 +1488,112 @@ object_spawn(edict_t *self)
 	}
 
 	self->movetype = MOVETYPE_NONE;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	self->think = object_think;
 	gi.linkentity(self);
 }
 
+/*
+ * Level of detail for idle monsters. A monster with nothing
+ * to do that no client can see or hear (outside of all their
+ * PHS or farther away than FindTarget() looks) only thinks
+ * every MONSTER_LOD_FRAMES frames. Noises and sightings wake
+ * it up at once. The decision only depends on the game state,
+ * so demos play out the same way.
+ */
+#define MONSTER_LOD_FRAMES 4
+#define MONSTER_LOD_RANGE 1000
+
+static int *monster_lod;  /* [game.maxentities], frame of the next think */
+
+void
+M_ClearLOD(void)
+{
+	monster_lod = gi.TagMalloc(game.maxentities * sizeof(int), TAG_LEVEL);
+}
+
+/*
+ * The same events that FindTarget() reacts to
+ */
+static qboolean
+M_Alerted(void)
+{
+	return (level.sight_entity_framenum >= (level.framenum - 1)) ||
+		(level.disguise_violation_framenum > level.framenum) ||
+		(level.sound_entity_framenum >= (level.framenum - 1)) ||
+		(level.sound2_entity_framenum >= (level.framenum - 1));
+}
+
+static qboolean
+M_OutOfReach(edict_t *self)
+{
+	edict_t *ent;
+	vec3_t v;
+	int i;
+
+	for (i = 1; i <= game.maxclients; i++)
+	{
+		ent = &g_edicts[i];
+
+		if (!ent->inuse || !ent->client)
+		{
+			continue;
+		}
+
+		VectorSubtract(ent->s.origin, self->s.origin, v);
+
+		if ((VectorLength(v) <= MONSTER_LOD_RANGE) &&
+			gi.inPHS(self->s.origin, ent->s.origin))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static qboolean
+M_SkipThink(edict_t *self)
+{
+	int e;
+
+	if (!monster_lod || !g_monster_lod->value)
+	{
+		return false;
+	}
+
+	e = self - g_edicts;
+
+	/* only standing around, not in the water
+	   and not falling */
+	if (self->enemy || self->goalentity || self->movetarget ||
+		(self->health <= 0) || self->deadflag || self->waterlevel ||
+		(self->monsterinfo.aiflags & (AI_SOUND_TARGET | AI_COMBAT_POINT)) ||
+		(!self->groundentity && !(self->flags & (FL_FLY | FL_SWIM))) ||
+		M_Alerted())
+	{
+		monster_lod[e] = 0;
+		return false;
+	}
+
+	if (level.framenum < monster_lod[e])
+	{
+		return true;
+	}
+
+	/* a full think, check if the next ones can be skipped */
+	if (M_OutOfReach(self))
+	{
+		monster_lod[e] = level.framenum + MONSTER_LOD_FRAMES;
+	}
+	else
+	{
+		monster_lod[e] = 0;
+	}
+
+	return false;
+}
+
 void
 monster_think(edict_t *self)
 {
@@ -1501,6 +1602,12 @@ monster_think(edict_t *self)
 		return;
 	}
 
+	if (M_SkipThink(self))
+	{
+		G_SetNextThink(self, level.time + FRAMETIME);
+		return;
+	}
+
 	M_MoveFrame(self);
 
 	if (self->linkcount != self->monsterinfo.linkcount)
@@ -1615,7 +1722,7 @@ monster_triggered_spawn_use(edict_t *self, edict_t *other /* unused */, edict_t
 	/* we have a one frame delay here so we
 	   don't telefrag the guy who activated us */
 	self->think = monster_triggered_spawn;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	if (activator->client)
 	{
@@ -1636,7 +1743,7 @@ monster_triggered_start(edict_t *self)
 	self->solid = SOLID_NOT;
 	self->movetype = MOVETYPE_NONE;
 	self->svflags |= SVF_NOCLIENT;
-	self->nextthink = 0;
+	G_SetNextThink(self, 0);
 	self->use = monster_triggered_spawn_use;
 }
 
@@ -1715,7 +1822,13 @@ monster_start(edict_t *self)
 		level.total_monsters++;
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	/* the slot may have held a monster before */
+	if (monster_lod)
+	{
+		monster_lod[self - g_edicts] = 0;
+	}
+
+	G_SetNextThink(self, level.time + FRAMETIME);
 	self->svflags |= SVF_MONSTER;
 	self->s.renderfx |= RF_FRAMELERP;
 	self->takedamage = DAMAGE_AIM;
@@ -1919,7 +2032,7 @@ monster_start_go(edict_t *self)
 	}
 
 	self->think = monster_think;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void
@@ -2111,7 +2224,7 @@ stationarymonster_triggered_spawn_use(edict_t *self, edict_t *other /* unused */
 
 	/* we have a one frame delay here so we don't telefrag the guy who activated us */
 	self->think = stationarymonster_triggered_spawn;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	if (activator->client)
 	{
@@ -2132,7 +2245,7 @@ stationarymonster_triggered_start(edict_t *self)
 	self->solid = SOLID_NOT;
 	self->movetype = MOVETYPE_NONE;
 	self->svflags |= SVF_NOCLIENT;
-	self->nextthink = 0;
+	G_SetNextThink(self, 0);
 	self->use = stationarymonster_triggered_spawn_use;
 }
 
@@ -729,7 +729,7 @@ hint_path_touch(edict_t *self, edict_t *other, cplane_t *plane /* unused */,
 		   xample, when riding a plat. */
 		if (self->wait)
 		{
-			other->nextthink = level.time + self->wait;
+			G_SetNextThink(other, level.time + self->wait);
 		}
 	}
 }
@@ -973,13 +973,13 @@ SpawnBadArea(vec3_t mins, vec3_t maxs, float lifespan, edict_t *owner)
 	badarea->touch = badarea_touch;
 	badarea->movetype = MOVETYPE_NONE;
 	badarea->solid = SOLID_TRIGGER;
-	badarea->classname = "bad_area";
+	G_SetClassname(badarea, "bad_area");
 	gi.linkentity(badarea);
 
 	if (lifespan)
 	{
 		badarea->think = G_FreeEdict;
-		badarea->nextthink = level.time + lifespan;
+		G_SetNextThink(badarea, level.time + lifespan);
 	}
 
 	badarea->owner = owner;
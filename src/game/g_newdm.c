@@ -276,7 +276,7 @@ DoRandomRespawn(edict_t *ent)
 	gi.unlinkentity(ent);
 
 	newEnt = G_Spawn();
-	newEnt->classname = classname;
+	G_SetClassname(newEnt, classname);
 	VectorCopy(ent->s.origin, newEnt->s.origin);
 	VectorCopy(ent->s.old_origin, newEnt->s.old_origin);
 	VectorCopy(ent->mins, newEnt->mins);
@@ -413,7 +413,7 @@ body_think(edict_t *self)
 		self->s.frame = firstframe;
 	}
 
-	self->nextthink = level.time + 0.1;
+	G_SetNextThink(self, level.time + 0.1);
 }
 
 void
@@ -452,9 +452,9 @@ fire_doppleganger(edict_t *ent, vec3_t start, vec3_t aimdir)
 	base->pain = doppleganger_pain;
 	base->die = doppleganger_die;
 
-	base->nextthink = level.time + 30;
+	G_SetNextThink(base, level.time + 30);
 	base->think = doppleganger_timeout;
-	base->classname = "doppleganger";
+	G_SetClassname(base, "doppleganger");
 
 	gi.linkentity(base);
 
@@ -469,7 +469,7 @@ fire_doppleganger(edict_t *ent, vec3_t start, vec3_t aimdir)
 	VectorCopy(start, body->s.origin);
 	body->s.origin[2] += 8;
 	body->think = body_think;
-	body->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(body, level.time + FRAMETIME);
 	gi.linkentity(body);
 
 	base->teamchain = body;
@@ -91,7 +91,7 @@ fd_secret_move1(edict_t *self)
 		return;
 	}
 
-	self->nextthink = level.time + 1.0;
+	G_SetNextThink(self, level.time + 1.0);
 	self->think = fd_secret_move2;
 }
 
@@ -122,7 +122,7 @@ fd_secret_move3(edict_t *self)
 
 	if (!(self->spawnflags & SEC_OPEN_ONCE))
 	{
-		self->nextthink = level.time + self->wait;
+		G_SetNextThink(self, level.time + self->wait);
 		self->think = fd_secret_move4;
 	}
 }
@@ -152,7 +152,7 @@ fd_secret_move5(edict_t *self)
 		return;
 	}
 
-	self->nextthink = level.time + 1.0;
+	G_SetNextThink(self, level.time + 1.0);
 	self->think = fd_secret_move6;
 }
 
@@ -377,7 +377,7 @@ force_wall_think(edict_t *self)
 	}
 
 	self->think = force_wall_think;
-	self->nextthink = level.time + 0.1;
+	G_SetNextThink(self, level.time + 0.1);
 }
 
 void
@@ -393,7 +393,7 @@ force_wall_use(edict_t *self, edict_t *other /* activator */,
 	{
 		self->wait = 1;
 		self->think = NULL;
-		self->nextthink = 0;
+		G_SetNextThink(self, 0);
 		self->solid = SOLID_NOT;
 		gi.linkentity(self);
 	}
@@ -401,7 +401,7 @@ force_wall_use(edict_t *self, edict_t *other /* activator */,
 	{
 		self->wait = 0;
 		self->think = force_wall_think;
-		self->nextthink = level.time + 0.1;
+		G_SetNextThink(self, level.time + 0.1);
 		self->solid = SOLID_BSP;
 		KillBox(self); /* Is this appropriate? */
 		gi.linkentity(self);
@@ -462,7 +462,7 @@ SP_func_force_wall(edict_t *ent)
 	{
 		ent->solid = SOLID_BSP;
 		ent->think = force_wall_think;
-		ent->nextthink = level.time + 0.1;
+		G_SetNextThink(ent, level.time + 0.1);
 	}
 	else
 	{
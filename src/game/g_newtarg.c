@@ -169,7 +169,7 @@ SP_target_steam(edict_t *self)
 	if (self->target)
 	{
 		self->think = target_steam_start;
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 	else
 	{
@@ -361,7 +361,7 @@ blacklight_think(edict_t *self)
 	self->s.angles[PITCH] = rand() % 360;
 	self->s.angles[YAW] = rand() % 360;
 	self->s.angles[ROLL] = rand() % 360;
-	self->nextthink = level.time + 0.1;
+	G_SetNextThink(self, level.time + 0.1);
 }
 
 void
@@ -386,7 +386,7 @@ SP_target_blacklight(edict_t *ent)
 	ent->think = blacklight_think;
 	ent->s.modelindex = gi.modelindex("models/items/spawngro2/tris.md2");
 	ent->s.frame = 1;
-	ent->nextthink = level.time + 0.1;
+	G_SetNextThink(ent, level.time + 0.1);
 	gi.linkentity(ent);
 }
 
@@ -406,7 +406,7 @@ orb_think(edict_t *self)
 	self->s.angles[PITCH] = rand() % 360;
 	self->s.angles[YAW] = rand() % 360;
 	self->s.angles[ROLL] = rand() % 360;
-	self->nextthink = level.time + 0.1;
+	G_SetNextThink(self, level.time + 0.1);
 }
 
 void
@@ -428,7 +428,7 @@ SP_target_orb(edict_t *ent)
 	VectorClear(ent->maxs);
 
 	ent->think = orb_think;
-	ent->nextthink = level.time + 0.1;
+	G_SetNextThink(ent, level.time + 0.1);
 	ent->s.modelindex = gi.modelindex("models/items/spawngro2/tris.md2");
 	ent->s.frame = 2;
 	ent->s.effects |= EF_SPHERETRANS;
@@ -123,7 +123,7 @@ fire_flechette(edict_t *self, vec3_t start, vec3_t dir, int damage,
 
 	flechette->owner = self;
 	flechette->touch = flechette_touch;
-	flechette->nextthink = level.time + (8000.0f / (float)speed);
+	G_SetNextThink(flechette, level.time + (8000.0f / (float)speed));
 	flechette->think = G_FreeEdict;
 	flechette->dmg = damage;
 	flechette->dmg_radius = kick;
@@ -210,7 +210,7 @@ prox_die(edict_t *self, edict_t *inflictor, edict_t *attacker /* unused */,
 	{
 		self->takedamage = DAMAGE_NO;
 		self->think = Prox_Explode;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -247,7 +247,7 @@ Prox_Field_Touch(edict_t *ent, edict_t *other, cplane_t *plane /* unused */,
 	{
 		gi.sound(ent, CHAN_VOICE, gi.soundindex("weapons/proxwarn.wav"), 1, ATTN_NORM, 0);
 		prox->think = Prox_Explode;
-		prox->nextthink = level.time + PROX_TIME_DELAY;
+		G_SetNextThink(prox, level.time + PROX_TIME_DELAY);
 		return;
 	}
 
@@ -277,7 +277,7 @@ prox_seek(edict_t *ent)
 		}
 
 		ent->think = prox_seek;
-		ent->nextthink = level.time + 0.1;
+		G_SetNextThink(ent, level.time + 0.1);
 	}
 }
 
@@ -357,7 +357,7 @@ prox_open(edict_t *ent)
 		}
 
 		ent->think = prox_seek;
-		ent->nextthink = level.time + 0.2;
+		G_SetNextThink(ent, level.time + 0.2);
 	}
 	else
 	{
@@ -368,7 +368,7 @@ prox_open(edict_t *ent)
 
 		ent->s.frame++;
 		ent->think = prox_open;
-		ent->nextthink = level.time + 0.05;
+		G_SetNextThink(ent, level.time + 0.05);
 	}
 }
 
@@ -497,7 +497,7 @@ prox_land(edict_t *ent, edict_t *other, cplane_t *plane, csurface_t *surf)
 	field->movetype = MOVETYPE_NONE;
 	field->solid = SOLID_TRIGGER;
 	field->owner = ent;
-	field->classname = "prox_field";
+	G_SetClassname(field, "prox_field");
 	field->teammaster = ent;
 	gi.linkentity(field);
 
@@ -512,7 +512,7 @@ prox_land(edict_t *ent, edict_t *other, cplane_t *plane, csurface_t *surf)
 	ent->die = prox_die;
 	ent->teamchain = field;
 	ent->health = PROX_HEALTH;
-	ent->nextthink = level.time + 0.05;
+	G_SetNextThink(ent, level.time + 0.05);
 	ent->think = prox_open;
 	ent->touch = NULL;
 	ent->solid = SOLID_BBOX;
@@ -556,26 +556,26 @@ fire_prox(edict_t *self, vec3_t start, vec3_t aimdir, int damage_multiplier, int
 	prox->touch = prox_land;
 	prox->think = Prox_Explode;
 	prox->dmg = PROX_DAMAGE * damage_multiplier;
-	prox->classname = "prox";
+	G_SetClassname(prox, "prox");
 	prox->svflags |= SVF_DAMAGEABLE;
 	prox->flags |= FL_MECHANICAL;
 
 	switch (damage_multiplier)
 	{
 		case 1:
-			prox->nextthink = level.time + PROX_TIME_TO_LIVE;
+			G_SetNextThink(prox, level.time + PROX_TIME_TO_LIVE);
 			break;
 		case 2:
-			prox->nextthink = level.time + 30;
+			G_SetNextThink(prox, level.time + 30);
 			break;
 		case 4:
-			prox->nextthink = level.time + 15;
+			G_SetNextThink(prox, level.time + 15);
 			break;
 		case 8:
-			prox->nextthink = level.time + 10;
+			G_SetNextThink(prox, level.time + 10);
 			break;
 		default:
-			prox->nextthink = level.time + PROX_TIME_TO_LIVE;
+			G_SetNextThink(prox, level.time + PROX_TIME_TO_LIVE);
 			break;
 	}
 
@@ -697,7 +697,7 @@ Nuke_Quake(edict_t *self)
 
 	if (level.time < self->timestamp)
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 	else
 	{
@@ -748,7 +748,7 @@ Nuke_Explode(edict_t *ent)
 	ent->think = Nuke_Quake;
 	ent->speed = NUKE_QUAKE_STRENGTH;
 	ent->timestamp = level.time + NUKE_QUAKE_TIME;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 	ent->last_move_time = 0;
 }
 
@@ -829,7 +829,7 @@ Nuke_Think(edict_t *ent)
 		}
 
 		ent->think = Nuke_Think;
-		ent->nextthink = level.time + 0.1;
+		G_SetNextThink(ent, level.time + 0.1);
 		ent->health = 1;
 		ent->owner = NULL;
 
@@ -860,7 +860,7 @@ Nuke_Think(edict_t *ent)
 			ent->timestamp = level.time + 1.0;
 		}
 
-		ent->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(ent, level.time + FRAMETIME);
 	}
 }
 
@@ -919,7 +919,7 @@ fire_nuke(edict_t *self, vec3_t start, vec3_t aimdir, int speed)
 	nuke->s.modelindex = gi.modelindex("models/weapons/g_nuke/tris.md2");
 	nuke->owner = self;
 	nuke->teammaster = self;
-	nuke->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(nuke, level.time + FRAMETIME);
 	nuke->wait = level.time + NUKE_DELAY + NUKE_TIME_TO_LIVE;
 	nuke->think = Nuke_Think;
 	nuke->touch = nuke_bounce;
@@ -938,7 +938,7 @@ fire_nuke(edict_t *self, vec3_t start, vec3_t aimdir, int speed)
 		nuke->dmg_radius = NUKE_RADIUS + NUKE_RADIUS * (0.25 * (float)damage_modifier);
 	}
 
-	nuke->classname = "nuke";
+	G_SetClassname(nuke, "nuke");
 	nuke->die = nuke_die;
 
 	gi.linkentity(nuke);
@@ -1127,7 +1127,7 @@ tesla_think_active(edict_t *self)
 	if (self->inuse)
 	{
 		self->think = tesla_think_active;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -1178,7 +1178,7 @@ tesla_activate(edict_t *self)
 	trigger->solid = SOLID_TRIGGER;
 	trigger->owner = self;
 	trigger->touch = tesla_zap;
-	trigger->classname = "tesla trigger";
+	G_SetClassname(trigger, "tesla trigger");
 
 	/* doesn't need to be marked as a teamslave since the move code for bounce looks for teamchains */
 	gi.linkentity(trigger);
@@ -1193,7 +1193,7 @@ tesla_activate(edict_t *self)
 
 	self->teamchain = trigger;
 	self->think = tesla_think_active;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	self->air_finished = level.time + TESLA_TIME_TO_LIVE;
 }
 
@@ -1224,7 +1224,7 @@ tesla_think(edict_t *ent)
 	{
 		ent->s.frame = 14;
 		ent->think = tesla_activate;
-		ent->nextthink = level.time + 0.1;
+		G_SetNextThink(ent, level.time + 0.1);
 	}
 	else
 	{
@@ -1250,7 +1250,7 @@ tesla_think(edict_t *ent)
 		}
 
 		ent->think = tesla_think;
-		ent->nextthink = level.time + 0.1;
+		G_SetNextThink(ent, level.time + 0.1);
 	}
 }
 
@@ -1320,7 +1320,7 @@ fire_tesla(edict_t *self, vec3_t start, vec3_t aimdir,
 
 	tesla->wait = level.time + TESLA_TIME_TO_LIVE;
 	tesla->think = tesla_think;
-	tesla->nextthink = level.time + TESLA_ACTIVATE_TIME;
+	G_SetNextThink(tesla, level.time + TESLA_ACTIVATE_TIME);
 
 	/* blow up on contact with lava & slime code */
 	tesla->touch = tesla_lava;
@@ -1337,7 +1337,7 @@ fire_tesla(edict_t *self, vec3_t start, vec3_t aimdir,
 	tesla->takedamage = DAMAGE_YES;
 	tesla->die = tesla_die;
 	tesla->dmg = TESLA_DAMAGE * damage_multiplier;
-	tesla->classname = "tesla";
+	G_SetClassname(tesla, "tesla");
 	tesla->svflags |= SVF_DAMAGEABLE;
 	tesla->clipmask = MASK_SHOT | CONTENTS_SLIME | CONTENTS_LAVA;
 	tesla->flags |= FL_MECHANICAL;
@@ -1627,10 +1627,10 @@ fire_blaster2(edict_t *self, vec3_t start, vec3_t dir, int damage,
 	bolt->touch = blaster2_touch;
 
 	bolt->owner = self;
-	bolt->nextthink = level.time + 2;
+	G_SetNextThink(bolt, level.time + 2);
 	bolt->think = G_FreeEdict;
 	bolt->dmg = damage;
-	bolt->classname = "bolt";
+	G_SetClassname(bolt, "bolt");
 	gi.linkentity(bolt);
 
 	if (self->client)
@@ -1707,7 +1707,7 @@ tracker_pain_daemon_think(edict_t *self)
 					self->enemy->s.effects |= EF_TRACKERTRAIL;
 				}
 
-				self->nextthink = level.time + FRAMETIME;
+				G_SetNextThink(self, level.time + FRAMETIME);
 			}
 		}
 		else
@@ -1733,9 +1733,9 @@ tracker_pain_daemon_spawn(edict_t *owner, edict_t *enemy, int damage)
 	}
 
 	daemon = G_Spawn();
-	daemon->classname = "pain daemon";
+	G_SetClassname(daemon, "pain daemon");
 	daemon->think = tracker_pain_daemon_think;
-	daemon->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(daemon, level.time + FRAMETIME);
 	daemon->timestamp = level.time;
 	daemon->owner = owner;
 	daemon->enemy = enemy;
@@ -1865,7 +1865,7 @@ tracker_fly(edict_t *self)
 	VectorScale(dir, self->speed, self->velocity);
 	VectorCopy(dest, self->monsterinfo.saved_goal);
 
-	self->nextthink = level.time + 0.1;
+	G_SetNextThink(self, level.time + 0.1);
 }
 
 void
@@ -1901,17 +1901,17 @@ fire_tracker(edict_t *self, vec3_t start, vec3_t dir, int damage,
 	bolt->enemy = enemy;
 	bolt->owner = self;
 	bolt->dmg = damage;
-	bolt->classname = "tracker";
+	G_SetClassname(bolt, "tracker");
 	gi.linkentity(bolt);
 
 	if (enemy)
 	{
-		bolt->nextthink = level.time + 0.1;
+		G_SetNextThink(bolt, level.time + 0.1);
 		bolt->think = tracker_fly;
 	}
 	else
 	{
-		bolt->nextthink = level.time + 10;
+		G_SetNextThink(bolt, level.time + 10);
 		bolt->think = G_FreeEdict;
 	}
 
@@ -285,7 +285,7 @@ SP_obj_dying_elf(edict_t *self)
 	self->monsterinfo.action = "fetal";
 	self->rrs.mesh = 0x1e; /* disable weapons */
 	self->think = object_think;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	gi.linkentity(self);
 }
 
@@ -1736,7 +1736,7 @@ void
 object_big_fire_think(edict_t *self)
 {
 	M_SetAnimGroupFrame(self, "bigfire", false);
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	/* add particles */
 	gi.WriteByte(svc_temp_entity);
@@ -1751,7 +1751,7 @@ SP_object_big_fire(edict_t *self)
 	self->movetype = MOVETYPE_NONE;
 	self->solid = SOLID_NOT;
 	self->think = object_big_fire_think;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	self->s.frame = 0;
 
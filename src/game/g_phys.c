@@ -111,6 +111,332 @@ SV_CheckVelocity(edict_t *ent)
 	}
 }
 
+/* ================================================================== */
+
+/* THINK SCHEDULING */
+
+/*
+ * Idle MOVETYPE_NONE entities (triggers, targets, path
+ * corners, ...) only do something when their think is
+ * due. They're put to sleep and G_RunFrame() skips them,
+ * a timer wheel wakes them up on the frame their think
+ * is due. Writing nextthink through G_SetNextThink()
+ * wakes them up, too, everything else is rechecked on
+ * the next visit. The first level of the wheel has a
+ * slot per frame, the second one a slot per block of
+ * frames, everything farther out is rechecked once per
+ * block. The links are level memory, like the free list.
+ */
+#define WHEEL_BITS 8
+#define WHEEL_FRAMES (1 << WHEEL_BITS)  /* slots of the first level */
+#define WHEEL_BLOCKS 64                 /* slots of the second level */
+#define WHEEL_FAR (WHEEL_FRAMES + WHEEL_BLOCKS)
+#define WHEEL_SLOTS (WHEEL_FAR + 1)
+
+typedef struct
+{
+	int next, prev;     /* edict numbers, -1 ends the slot */
+	int slot;           /* -1 when not in the wheel */
+	int frame;          /* frame the think is due */
+} thinklink_t;
+
+static thinklink_t *think_links;  /* [game.maxentities] */
+static unsigned *sleep_bits;      /* [game.maxentities / 32] */
+static int think_wheel[WHEEL_SLOTS];
+static int sleep_count;
+
+static void
+G_LinkThink(int e, int slot)
+{
+	thinklink_t *link;
+
+	link = &think_links[e];
+	link->slot = slot;
+	link->prev = -1;
+	link->next = think_wheel[slot];
+
+	if (link->next >= 0)
+	{
+		think_links[link->next].prev = e;
+	}
+
+	think_wheel[slot] = e;
+}
+
+static void
+G_UnlinkThink(int e)
+{
+	thinklink_t *link;
+
+	link = &think_links[e];
+
+	if (link->slot < 0)
+	{
+		return;
+	}
+
+	if (link->prev >= 0)
+	{
+		think_links[link->prev].next = link->next;
+	}
+	else
+	{
+		think_wheel[link->slot] = link->next;
+	}
+
+	if (link->next >= 0)
+	{
+		think_links[link->next].prev = link->prev;
+	}
+
+	link->slot = -1;
+}
+
+/*
+ * Puts an edict into the slot for its
+ * frame, as seen from the current frame.
+ */
+static void
+G_ScheduleThink(int e)
+{
+	int delta, frame;
+
+	frame = think_links[e].frame;
+	delta = frame - level.framenum;
+
+	if (delta < WHEEL_FRAMES)
+	{
+		G_LinkThink(e, frame & (WHEEL_FRAMES - 1));
+	}
+	else if (delta < WHEEL_FRAMES * (WHEEL_BLOCKS - 1))
+	{
+		G_LinkThink(e, WHEEL_FRAMES +
+				((frame >> WHEEL_BITS) & (WHEEL_BLOCKS - 1)));
+	}
+	else
+	{
+		G_LinkThink(e, WHEEL_FAR);
+	}
+}
+
+/*
+ * Moves all edicts of a slot back into the wheel.
+ */
+static void
+G_RescheduleSlot(int slot)
+{
+	int e, next;
+
+	e = think_wheel[slot];
+	think_wheel[slot] = -1;
+
+	while (e >= 0)
+	{
+		next = think_links[e].next;
+		think_links[e].slot = -1;
+		G_ScheduleThink(e);
+		e = next;
+	}
+}
+
+/*
+ * Rebuilds the wheel, called whenever the edicts
+ * were wiped or loaded. Everything starts awake.
+ */
+void
+G_ClearThinks(void)
+{
+	int i;
+
+	think_links = gi.TagMalloc(game.maxentities * sizeof(thinklink_t),
+			TAG_LEVEL);
+	sleep_bits = gi.TagMalloc(((game.maxentities + 31) / 32) *
+			sizeof(unsigned), TAG_LEVEL);
+	sleep_count = 0;
+
+	for (i = 0; i < game.maxentities; i++)
+	{
+		think_links[i].slot = -1;
+	}
+
+	for (i = 0; i < WHEEL_SLOTS; i++)
+	{
+		think_wheel[i] = -1;
+	}
+}
+
+void
+G_WakeEdict(edict_t *ent)
+{
+	int e;
+
+	if (!ent || !think_links)
+	{
+		return;
+	}
+
+	e = ent - g_edicts;
+
+	if (!(sleep_bits[e >> 5] & (1U << (e & 31))))
+	{
+		return;
+	}
+
+	G_UnlinkThink(e);
+	sleep_bits[e >> 5] &= ~(1U << (e & 31));
+	sleep_count--;
+}
+
+void
+G_SetNextThink(edict_t *ent, float nextthink)
+{
+	if (!ent)
+	{
+		return;
+	}
+
+	ent->nextthink = nextthink;
+	G_WakeEdict(ent);
+}
+
+/*
+ * Puts an edict to sleep after G_RunFrame()
+ * visited it, if there's nothing to do for
+ * it until its next think. Free edicts
+ * sleep until they're reused.
+ */
+void
+G_CheckSleep(edict_t *ent)
+{
+	int e;
+
+	if (!ent || !think_links)
+	{
+		return;
+	}
+
+	e = ent - g_edicts;
+
+	if ((e <= maxclients->value) || (sleep_bits[e >> 5] & (1U << (e & 31))))
+	{
+		return;
+	}
+
+	if (ent->inuse)
+	{
+		/* the old origin is only kept up to
+		   date for entities sent to clients */
+		if ((ent->movetype != MOVETYPE_NONE) || ent->prethink ||
+			ent->groundentity || (ent->s.modelindex &&
+				!(ent->svflags & SVF_NOCLIENT)) ||
+			!VectorCompare(ent->s.origin, ent->s.old_origin))
+		{
+			return;
+		}
+
+		if (ent->nextthink > 0)
+		{
+			if (ent->nextthink <= level.time + 0.001)
+			{
+				return;
+			}
+
+			/* rather a frame early than late, an early
+			   wake up just puts the edict to sleep again */
+			think_links[e].frame = (int)ceil((ent->nextthink - 0.001) /
+					FRAMETIME - 0.25);
+
+			if (think_links[e].frame <= level.framenum)
+			{
+				think_links[e].frame = level.framenum + 1;
+			}
+
+			G_ScheduleThink(e);
+		}
+	}
+
+	sleep_bits[e >> 5] |= 1U << (e & 31);
+	sleep_count++;
+}
+
+/*
+ * Wakes up the edicts whose think is due this
+ * frame, called at the start of each frame.
+ */
+void
+G_RunThinkWheel(void)
+{
+	int e, next, block;
+
+	if (!think_links)
+	{
+		return;
+	}
+
+	if (!(level.framenum & (WHEEL_FRAMES - 1)))
+	{
+		/* a new block, pull the next one in */
+		block = (level.framenum >> WHEEL_BITS) & (WHEEL_BLOCKS - 1);
+
+		G_RescheduleSlot(WHEEL_FAR);
+		G_RescheduleSlot(WHEEL_FRAMES + block);
+	}
+
+	e = think_wheel[level.framenum & (WHEEL_FRAMES - 1)];
+
+	while (e >= 0)
+	{
+		next = think_links[e].next;
+		G_WakeEdict(&g_edicts[e]);
+		e = next;
+	}
+}
+
+/*
+ * Returns the first edict from e on
+ * that G_RunFrame() has to visit.
+ */
+int
+G_NextAwakeEdict(int e)
+{
+	unsigned bits;
+
+	if (!think_links || (e <= maxclients->value))
+	{
+		return e;
+	}
+
+	while (e < globals.num_edicts)
+	{
+		bits = sleep_bits[e >> 5] >> (e & 31);
+
+		if (!(bits & 1))
+		{
+			return e;
+		}
+
+		if (bits == (~0U >> (e & 31)))
+		{
+			/* rest of the word sleeps */
+			e = (e | 31) + 1;
+		}
+		else
+		{
+			e++;
+		}
+	}
+
+	return e;
+}
+
+int
+G_SleepingEdicts(void)
+{
+	return sleep_count;
+}
+
+/* ================================================================== */
+
 /*
  * Runs thinking code for
  * this frame if necessary
@@ -137,7 +463,7 @@ SV_RunThink(edict_t *ent)
 		return true;
 	}
 
-	ent->nextthink = 0;
+	G_SetNextThink(ent, 0);
 
 	if (!ent->think)
 	{
@@ -874,7 +1200,7 @@ SV_Physics_Pusher(edict_t *ent)
 		{
 			if (mv->nextthink > 0)
 			{
-				mv->nextthink += FRAMETIME;
+				G_SetNextThink(mv, mv->nextthink + FRAMETIME);
 			}
 		}
 
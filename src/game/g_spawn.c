@@ -75,6 +75,11 @@ static dynamicentity_t *dynamicentities;
 static int ndynamicentities;
 static int nstaticentities;
 
+/* spawnable fields sorted by name, the
+   order of fields[] is the savegame format */
+static const field_t **spawnfields;
+static int nspawnfields;
+
 static void
 DynamicSpawnSetScale(edict_t *self)
 {
@@ -230,7 +235,7 @@ void
 dynamicspawn_think(edict_t *self)
 {
 	M_SetAnimGroupFrame(self, "idle", true);
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 static void
@@ -317,7 +322,7 @@ DynamicSpawn(edict_t *self, dynamicentity_t *data)
 		if (has_idle && self->movetype != MOVETYPE_STEP)
 		{
 			self->think = dynamicspawn_think;
-			self->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(self, level.time + FRAMETIME);
 		}
 	}
 
@@ -455,17 +460,17 @@ ED_CallSpawn(edict_t *ent)
 
 	if (!strcmp(ent->classname, "weapon_nailgun"))
 	{
-		ent->classname = (FindItem("ETF Rifle"))->classname;
+		G_SetClassname(ent, (FindItem("ETF Rifle"))->classname);
 	}
 
 	if (!strcmp(ent->classname, "ammo_nails"))
 	{
-		ent->classname = (FindItem("Flechettes"))->classname;
+		G_SetClassname(ent, (FindItem("Flechettes"))->classname);
 	}
 
 	if (!strcmp(ent->classname, "weapon_heatbeam"))
 	{
-		ent->classname = (FindItem("Plasma Beam"))->classname;
+		G_SetClassname(ent, (FindItem("Plasma Beam"))->classname);
 	}
 
 	/* search dynamic definitions */
@@ -657,77 +662,223 @@ ED_ParseColorField(const char *value)
 }
 
 /*
- * Takes a key/value pair and sets
- * the binary values in an edict
+ * Case insensitive compare of a field name with
+ * a key that isn't terminated. Field names are
+ * plain ASCII, so there's no need for tolower().
  */
-static void
-ED_ParseField(const char *key, const char *value, edict_t *ent)
+static int
+ED_FieldCompare(const char *name, const char *key, int len)
 {
-	field_t *f;
-	byte *b;
-	float v;
-	vec3_t vec;
+	int i, c1, c2;
 
-	if (!ent || !value || !key)
+	for (i = 0; i < len; i++)
 	{
-		return;
-	}
+		c1 = (unsigned char)name[i];
+		c2 = (unsigned char)key[i];
 
-	for (f = fields; f->name; f++)
-	{
-		if (!(f->flags & FFL_NOSPAWN) && !Q_strcasecmp(f->name, (char *)key))
+		if (c1 != c2)
 		{
-			/* found it */
-			if (f->flags & FFL_SPAWNTEMP)
+			if ((c1 >= 'A') && (c1 <= 'Z'))
 			{
-				b = (byte *)&st;
+				c1 += 'a' - 'A';
 			}
-			else
+
+			if ((c2 >= 'A') && (c2 <= 'Z'))
 			{
-				b = (byte *)ent;
+				c2 += 'a' - 'A';
 			}
 
-			switch (f->type)
+			if (c1 != c2)
 			{
-				case F_LRAWSTRING:
-					*(char **)(b + f->ofs) = ED_NewString(value, true);
-					break;
-				case F_LSTRING:
-					*(char **)(b + f->ofs) = ED_NewString(value, false);
-					break;
-				case F_VECTOR:
-					VectorClear(vec);
-					sscanf(value, "%f %f %f", &vec[0], &vec[1], &vec[2]);
-					((float *)(b + f->ofs))[0] = vec[0];
-					((float *)(b + f->ofs))[1] = vec[1];
-					((float *)(b + f->ofs))[2] = vec[2];
-					break;
-				case F_INT:
-					*(int *)(b + f->ofs) = (int)strtol(value, (char **)NULL, 10);
-					break;
-				case F_FLOAT:
-					*(float *)(b + f->ofs) = (float)strtod(value, (char **)NULL);
-					break;
-				case F_ANGLEHACK:
-					v = (float)strtod(value, (char **)NULL);
-					((float *)(b + f->ofs))[0] = 0;
-					((float *)(b + f->ofs))[1] = v;
-					((float *)(b + f->ofs))[2] = 0;
-					break;
-				case F_RGBA:
-					*(unsigned *)(b + f->ofs) = ED_ParseColorField(value);
-					break;
-				case F_IGNORE:
-					break;
-				default:
-					break;
+				return c1 - c2;
 			}
+		}
+	}
 
-			return;
+	return (unsigned char)name[len];
+}
+
+/*
+ * Finds the first spawnable field with the name.
+ */
+static const field_t *
+ED_FindField(const char *key, int len)
+{
+	int start, end, i;
+
+	start = 0;
+	end = nspawnfields;
+
+	while (start < end)
+	{
+		i = start + (end - start) / 2;
+
+		if (ED_FieldCompare(spawnfields[i]->name, key, len) < 0)
+		{
+			start = i + 1;
+		}
+		else
+		{
+			end = i;
+		}
+	}
+
+	if ((start < nspawnfields) &&
+		!ED_FieldCompare(spawnfields[start]->name, key, len))
+	{
+		return spawnfields[start];
+	}
+
+	return NULL;
+}
+
+/*
+ * Returns the next token of the entity string without
+ * copying it. Works like COM_Parse(), the token isn't
+ * terminated. data is set to NULL at the end.
+ */
+static const char *
+ED_ParseToken(char **data_p, int *len)
+{
+	const char *token;
+	char *data;
+	int c;
+
+	data = *data_p;
+	*len = 0;
+
+	if (!data)
+	{
+		return "";
+	}
+
+skipwhite:
+
+	while ((c = *data) <= ' ')
+	{
+		if (c == 0)
+		{
+			*data_p = NULL;
+			return "";
+		}
+
+		data++;
+	}
+
+	/* skip // comments */
+	if ((c == '/') && (data[1] == '/'))
+	{
+		while (*data && *data != '\n')
+		{
+			data++;
+		}
+
+		goto skipwhite;
+	}
+
+	/* handle quoted strings specially */
+	if (c == '\"')
+	{
+		data++;
+		token = data;
+
+		while (*data && (*data != '\"'))
+		{
+			data++;
+		}
+
+		*len = data - token;
+
+		if (*data)
+		{
+			data++;
+		}
+	}
+	else
+	{
+		/* parse a regular word */
+		token = data;
+
+		do
+		{
+			data++;
+			c = *data;
 		}
+		while (c > 32);
+
+		*len = data - token;
 	}
 
-	gi.dprintf("'%s' is not a field. Value is '%s'\n", key, value);
+	/* too long tokens are empty, as in COM_Parse() */
+	if (*len >= MAX_TOKEN_CHARS)
+	{
+		*len = 0;
+	}
+
+	*data_p = data;
+	return token;
+}
+
+/*
+ * Takes a key/value pair and sets
+ * the binary values in an edict
+ */
+static void
+ED_ParseField(const field_t *f, const char *value, edict_t *ent)
+{
+	byte *b;
+	float v;
+	vec3_t vec;
+
+	if (!f || !value || !ent)
+	{
+		return;
+	}
+
+	if (f->flags & FFL_SPAWNTEMP)
+	{
+		b = (byte *)&st;
+	}
+	else
+	{
+		b = (byte *)ent;
+	}
+
+	switch (f->type)
+	{
+		case F_LRAWSTRING:
+			*(char **)(b + f->ofs) = ED_NewString(value, true);
+			break;
+		case F_LSTRING:
+			*(char **)(b + f->ofs) = ED_NewString(value, false);
+			break;
+		case F_VECTOR:
+			VectorClear(vec);
+			sscanf(value, "%f %f %f", &vec[0], &vec[1], &vec[2]);
+			((float *)(b + f->ofs))[0] = vec[0];
+			((float *)(b + f->ofs))[1] = vec[1];
+			((float *)(b + f->ofs))[2] = vec[2];
+			break;
+		case F_INT:
+			*(int *)(b + f->ofs) = (int)strtol(value, (char **)NULL, 10);
+			break;
+		case F_FLOAT:
+			*(float *)(b + f->ofs) = (float)strtod(value, (char **)NULL);
+			break;
+		case F_ANGLEHACK:
+			v = (float)strtod(value, (char **)NULL);
+			((float *)(b + f->ofs))[0] = 0;
+			((float *)(b + f->ofs))[1] = v;
+			((float *)(b + f->ofs))[2] = 0;
+			break;
+		case F_RGBA:
+			*(unsigned *)(b + f->ofs) = ED_ParseColorField(value);
+			break;
+		case F_IGNORE:
+			break;
+		default:
+			break;
+	}
 }
 
 /*
@@ -739,8 +890,10 @@ static char *
 ED_ParseEdict(char *data, edict_t *ent)
 {
 	qboolean init;
-	char keyname[256];
-	const char *com_token;
+	char value[MAX_TOKEN_CHARS];
+	const char *keyname, *token;
+	const field_t *f;
+	int keylen, len;
 
 	if (!ent)
 	{
@@ -755,9 +908,9 @@ ED_ParseEdict(char *data, edict_t *ent)
 	while (1)
 	{
 		/* parse key */
-		com_token = COM_Parse(&data);
+		keyname = ED_ParseToken(&data, &keylen);
 
-		if (com_token[0] == '}')
+		if (keylen && (keyname[0] == '}'))
 		{
 			break;
 		}
@@ -768,10 +921,8 @@ ED_ParseEdict(char *data, edict_t *ent)
 			break;
 		}
 
-		Q_strlcpy(keyname, com_token, sizeof(keyname));
-
 		/* parse value */
-		com_token = COM_Parse(&data);
+		token = ED_ParseToken(&data, &len);
 
 		if (!data)
 		{
@@ -779,7 +930,7 @@ ED_ParseEdict(char *data, edict_t *ent)
 			break;
 		}
 
-		if (com_token[0] == '}')
+		if (len && (token[0] == '}'))
 		{
 			gi.error("%s: closing brace without data", __func__);
 			break;
@@ -790,12 +941,24 @@ ED_ParseEdict(char *data, edict_t *ent)
 		/* keynames with a leading underscore are
 		   used for utility comments, and are
 		   immediately discarded by quake */
-		if (keyname[0] == '_')
+		if (keylen && (keyname[0] == '_'))
 		{
 			continue;
 		}
 
-		ED_ParseField(keyname, com_token, ent);
+		f = ED_FindField(keyname, keylen);
+
+		if (!f)
+		{
+			gi.dprintf("'%.*s' is not a field. Value is '%.*s'\n",
+					keylen, keyname, len, token);
+			continue;
+		}
+
+		memcpy(value, token, len);
+		value[len] = '\0';
+
+		ED_ParseField(f, value, ent);
 	}
 
 	if (!init)
@@ -803,6 +966,9 @@ ED_ParseEdict(char *data, edict_t *ent)
 		memset(ent, 0, sizeof(*ent));
 	}
 
+	/* the fields were set by offset */
+	G_LinkNames(ent);
+
 	return data;
 }
 
@@ -978,8 +1144,8 @@ SpawnEntities(const char *mapname, char *entities, const char *spawnpoint)
 {
 	edict_t *ent;
 	int inhibit;
-	const char *com_token;
-	int i;
+	const char *token;
+	int i, len;
 	float skill_level;
 
 	if (!mapname || !entities || !spawnpoint)
@@ -1012,6 +1178,11 @@ SpawnEntities(const char *mapname, char *entities, const char *spawnpoint)
 
 	memset(&level, 0, sizeof(level));
 	memset(g_edicts, 0, game.maxentities * sizeof(g_edicts[0]));
+	G_ClearNames();
+	G_ClearFreeEdicts();
+	G_ClearThinks();
+	M_ClearLOD();
+	AI_ClearPerception();
 
 	Q_strlcpy(level.mapname, mapname, sizeof(level.mapname));
 	Q_strlcpy(game.spawnpoint, spawnpoint, sizeof(game.spawnpoint));
@@ -1029,16 +1200,16 @@ SpawnEntities(const char *mapname, char *entities, const char *spawnpoint)
 	while (1)
 	{
 		/* parse the opening brace */
-		com_token = COM_Parse(&entities);
+		token = ED_ParseToken(&entities, &len);
 
 		if (!entities)
 		{
 			break;
 		}
 
-		if (com_token[0] != '{')
+		if (!len || (token[0] != '{'))
 		{
-			gi.error("%s: found %s when expecting {", __func__, com_token);
+			gi.error("%s: found %.*s when expecting {", __func__, len, token);
 			break;
 		}
 
@@ -1693,7 +1864,7 @@ CreateMonster(vec3_t origin, vec3_t angles, char *classname)
 
 	VectorCopy(origin, newEnt->s.origin);
 	VectorCopy(angles, newEnt->s.angles);
-	newEnt->classname = ED_NewString(classname, true);
+	G_SetClassname(newEnt, ED_NewString(classname, true));
 	newEnt->monsterinfo.aiflags |= AI_DO_NOT_COUNT;
 
 	VectorSet(newEnt->gravityVector, 0, 0, -1);
@@ -1717,7 +1888,7 @@ DetermineBBox(char *classname, vec3_t mins, vec3_t maxs)
 
 	VectorCopy(vec3_origin, newEnt->s.origin);
 	VectorCopy(vec3_origin, newEnt->s.angles);
-	newEnt->classname = ED_NewString(classname, true);
+	G_SetClassname(newEnt, ED_NewString(classname, true));
 	newEnt->monsterinfo.aiflags |= AI_DO_NOT_COUNT;
 
 	ED_CallSpawn(newEnt);
@@ -2025,7 +2196,7 @@ spawngrow_think(edict_t *self)
 		}
 	}
 
-	self->nextthink += FRAMETIME;
+	G_SetNextThink(self, self->nextthink + FRAMETIME);
 }
 
 void
@@ -2048,7 +2219,7 @@ SpawnGrow_Spawn(vec3_t startpos, int size)
 	ent->solid = SOLID_NOT;
 	ent->s.renderfx = RF_IR_VISIBLE;
 	ent->movetype = MOVETYPE_NONE;
-	ent->classname = "spawngro";
+	G_SetClassname(ent, "spawngro");
 
 	if (size <= 1)
 	{
@@ -2069,7 +2240,7 @@ SpawnGrow_Spawn(vec3_t startpos, int size)
 	ent->think = spawngrow_think;
 
 	ent->wait = level.time + lifespan;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	if (size != 2)
 	{
@@ -2106,7 +2277,7 @@ widowlegs_think(edict_t *self)
 	if (self->s.frame < MAX_LEGSFRAME)
 	{
 		self->s.frame++;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 		return;
 	}
 	else if (self->wait == 0)
@@ -2169,11 +2340,11 @@ widowlegs_think(edict_t *self)
 		gi.WritePosition(point);
 		gi.multicast(point, MULTICAST_ALL);
 
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 		return;
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void
@@ -2187,12 +2358,12 @@ Widowlegs_Spawn(vec3_t startpos, vec3_t angles)
 	ent->solid = SOLID_NOT;
 	ent->s.renderfx = RF_IR_VISIBLE;
 	ent->movetype = MOVETYPE_NONE;
-	ent->classname = "widowlegs";
+	G_SetClassname(ent, "widowlegs");
 
 	ent->s.modelindex = gi.modelindex("models/monsters/legs/tris.md2");
 	ent->think = widowlegs_think;
 
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 	gi.linkentity(ent);
 }
 
@@ -2690,6 +2861,55 @@ StaticSort(const void *p1, const void *p2)
 	return Q_stricmp(ent1->name, ent2->name);
 }
 
+static int
+FieldSort(const void *p1, const void *p2)
+{
+	const field_t *f1, *f2;
+	int res;
+
+	f1 = *(const field_t **)p1;
+	f2 = *(const field_t **)p2;
+
+	res = ED_FieldCompare(f1->name, f2->name, strlen(f2->name));
+
+	/* keep the table order of duplicates */
+	if (!res)
+	{
+		res = (f1 < f2) ? -1 : (f1 > f2);
+	}
+
+	return res;
+}
+
+static void
+FieldSpawnInit(void)
+{
+	const field_t *f;
+
+	for (f = fields; f->name; f++)
+	{
+	}
+
+	spawnfields = malloc((f - fields) * sizeof(*spawnfields));
+	nspawnfields = 0;
+
+	if (!spawnfields)
+	{
+		gi.error("%s: can't allocate field index", __func__);
+		return;
+	}
+
+	for (f = fields; f->name; f++)
+	{
+		if (!(f->flags & FFL_NOSPAWN))
+		{
+			spawnfields[nspawnfields++] = f;
+		}
+	}
+
+	qsort(spawnfields, nspawnfields, sizeof(*spawnfields), FieldSort);
+}
+
 static void
 StaticSpawnInit(void)
 {
@@ -2712,6 +2932,7 @@ void
 SpawnInit(void)
 {
 	StaticSpawnInit();
+	FieldSpawnInit();
 	DynamicSpawnInit();
 }
 
@@ -2726,4 +2947,8 @@ SpawnFree(void)
 
 	dynamicentities = NULL;
 	ndynamicentities = 0;
+
+	free(spawnfields);
+	spawnfields = NULL;
+	nspawnfields = 0;
 }
@@ -223,7 +223,7 @@ sphere_fire(edict_t *self, edict_t *enemy)
 
 	self->touch = vengeance_touch;
 	self->think = sphere_think_explode;
-	self->nextthink = self->wait;
+	G_SetNextThink(self, self->wait);
 }
 
 void
@@ -600,7 +600,7 @@ defender_think(edict_t *self)
 
 	if (self->inuse)
 	{
-		self->nextthink = level.time + 0.1;
+		G_SetNextThink(self, level.time + 0.1);
 	}
 }
 
@@ -679,7 +679,7 @@ hunter_think(edict_t *self)
 
 	if (self->inuse)
 	{
-		self->nextthink = level.time + 0.1;
+		G_SetNextThink(self, level.time + 0.1);
 	}
 }
 
@@ -715,7 +715,7 @@ vengeance_think(edict_t *self)
 
 	if (self->inuse)
 	{
-		self->nextthink = level.time + 0.1;
+		G_SetNextThink(self, level.time + 0.1);
 	}
 }
 
@@ -747,7 +747,7 @@ Sphere_Spawn(edict_t *owner, int spawnflags)
 		sphere->owner = owner;
 	}
 
-	sphere->classname = "sphere";
+	G_SetClassname(sphere, "sphere");
 	sphere->yaw_speed = 40;
 	sphere->monsterinfo.attack_finished = 0;
 	sphere->spawnflags = spawnflags; /* need this for the HUD to recognize sphere */
@@ -789,7 +789,7 @@ Sphere_Spawn(edict_t *owner, int spawnflags)
 			return NULL;
 	}
 
-	sphere->nextthink = level.time + 0.1;
+	G_SetNextThink(sphere, level.time + 0.1);
 
 	gi.linkentity(sphere);
 
@@ -330,6 +330,14 @@ ServerCommand(void)
 	{
 		Svcmd_Test_f();
 	}
+	else if (Q_stricmp(cmd, "edicts") == 0)
+	{
+		G_PrintEdictStats();
+	}
+	else if (Q_stricmp(cmd, "sight") == 0)
+	{
+		AI_PrintSightStats();
+	}
 	else if (Q_stricmp(cmd, "addip") == 0)
 	{
 		SVCmd_AddIP_f();
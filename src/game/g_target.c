@@ -251,7 +251,7 @@ Use_Target_Help(edict_t *ent, edict_t *other /* unused */, edict_t *activator /*
 		   otherwise its changes to game structure will leak past save loads
 		*/
 		ent->think = Target_Help_Think;
-		ent->nextthink = TARGET_HELP_THINK_DELAY;
+		G_SetNextThink(ent, TARGET_HELP_THINK_DELAY);
 	}
 }
 
@@ -452,7 +452,7 @@ use_target_explosion(edict_t *self, edict_t *other /* unused */, edict_t *activa
 	}
 
 	self->think = target_explosion_explode;
-	self->nextthink = level.time + self->delay;
+	G_SetNextThink(self, level.time + self->delay);
 }
 
 void
@@ -637,7 +637,7 @@ use_target_spawner(edict_t *self, edict_t *other /* unused */, edict_t *activato
 	}
 
 	ent = G_Spawn();
-	ent->classname = self->target;
+	G_SetClassname(ent, self->target);
 	VectorCopy(self->s.origin, ent->s.origin);
 	VectorCopy(self->s.angles, ent->s.angles);
 	ED_CallSpawn(ent);
@@ -809,7 +809,7 @@ SP_target_crosslevel_target(edict_t *self)
 	self->svflags = SVF_NOCLIENT;
 
 	self->think = target_crosslevel_target_think;
-	self->nextthink = level.time + self->delay;
+	G_SetNextThink(self, level.time + self->delay);
 }
 
 /* ========================================================== */
@@ -921,7 +921,7 @@ target_laser_think(edict_t *self)
 
 	VectorCopy(tr.endpos, self->s.old_origin);
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void
@@ -952,7 +952,7 @@ target_laser_off(edict_t *self)
 
 	self->spawnflags &= ~1;
 	self->svflags |= SVF_NOCLIENT;
-	self->nextthink = 0;
+	G_SetNextThink(self, 0);
 }
 
 void
@@ -1075,7 +1075,7 @@ SP_target_laser(edict_t *self)
 
 	/* let everything else get spawned before we start firing */
 	self->think = target_laser_start;
-	self->nextthink = level.time + 1;
+	G_SetNextThink(self, level.time + 1);
 }
 
 /* QUAKED target_mal_laser (1 0 0) (-4 -4 -4) (4 4 4) START_ON RED GREEN BLUE YELLOW ORANGE FAT
@@ -1096,7 +1096,7 @@ target_mal_laser_on(edict_t *self)
 
 	self->spawnflags |= 0x80000001;
 	self->svflags &= ~SVF_NOCLIENT;
-	self->nextthink = level.time + self->wait + self->delay;
+	G_SetNextThink(self, level.time + self->wait + self->delay);
 }
 
 void
@@ -1109,7 +1109,7 @@ target_mal_laser_off(edict_t *self)
 
 	self->spawnflags &= ~1;
 	self->svflags |= SVF_NOCLIENT;
-	self->nextthink = 0;
+	G_SetNextThink(self, 0);
 }
 
 void
@@ -1141,7 +1141,7 @@ mal_laser_think(edict_t *self)
 	}
 
 	target_laser_think(self);
-	self->nextthink = level.time + self->wait + 0.1;
+	G_SetNextThink(self, level.time + self->wait + 0.1);
 	self->spawnflags |= 0x80000000;
 }
 
@@ -1210,7 +1210,7 @@ SP_target_mal_laser(edict_t *self)
 	VectorSet(self->mins, -8, -8, -8);
 	VectorSet(self->maxs, 8, 8, 8);
 
-	self->nextthink = level.time + self->delay;
+	G_SetNextThink(self, level.time + self->delay);
 	self->think = mal_laser_think;
 
 	self->use = target_mal_laser_use;
@@ -1253,7 +1253,7 @@ target_lightramp_think(edict_t *self)
 
 	if ((level.time - self->timestamp) < self->speed)
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 	else if (self->spawnflags & 1)
 	{
@@ -1420,7 +1420,7 @@ target_earthquake_think(edict_t *self)
 
 	if (level.time < self->timestamp)
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -1433,7 +1433,7 @@ target_earthquake_use(edict_t *self, edict_t *other /* unused */, edict_t *activ
 	}
 
 	self->timestamp = level.time + self->count;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	self->activator = activator;
 	self->last_move_time = 0;
 }
@@ -1521,7 +1521,7 @@ update_target_camera_think(edict_t *self)
 		if (self->moveinfo.remaining_distance <= 0)
 		{
 			VectorCopy(self->movetarget->s.origin, self->s.origin);
-			self->nextthink = level.time + self->movetarget->wait;
+			G_SetNextThink(self, level.time + self->movetarget->wait);
 			if (self->movetarget->target)
 			{
 				self->movetarget = G_PickTarget(self->movetarget->target);
@@ -1605,7 +1605,7 @@ update_target_camera_think(edict_t *self)
 		return;
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void
@@ -1621,7 +1621,7 @@ target_camera_dummy_think(edict_t *self)
 		self->velocity[1] * self->velocity[1]));
 	self->client = NULL;
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void
@@ -1668,7 +1668,7 @@ use_target_camera(edict_t *self, edict_t *other, edict_t *activator)
 		dummy->groundentity = activator->groundentity;
 		dummy->groundentity_linkcount = dummy->groundentity ? dummy->groundentity->linkcount : 0;
 		dummy->think = target_camera_dummy_think;
-		dummy->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(dummy, level.time + FRAMETIME);
 		dummy->solid = SOLID_BBOX;
 		dummy->movetype = MOVETYPE_STEP;
 		VectorCopy(activator->mins, dummy->mins);
@@ -1704,7 +1704,7 @@ use_target_camera(edict_t *self, edict_t *other, edict_t *activator)
 
 	self->activator = activator;
 	self->think = update_target_camera_think;
-	self->nextthink = level.time + self->wait;
+	G_SetNextThink(self, level.time + self->wait);
 	self->moveinfo.move_speed = self->speed;
 
 	VectorSubtract(self->movetarget->s.origin, self->s.origin,  diff);
@@ -1761,7 +1761,7 @@ void
 use_target_soundfx(edict_t *self, edict_t *other, edict_t *activator)
 {
 	self->think = update_target_soundfx;
-	self->nextthink = level.time + self->delay;
+	G_SetNextThink(self, level.time + self->delay);
 }
 
 void
@@ -1826,7 +1826,7 @@ target_light_flicker_think(edict_t *self)
 		self->svflags ^= SVF_NOCLIENT;
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 /* think function handles interpolation from start to finish. */
@@ -1890,7 +1890,7 @@ target_light_think(edict_t *self)
 
 	self->s.skinnum = (b << 8) | (g << 16) | (r << 24);
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void
@@ -1915,7 +1915,7 @@ target_light_use(edict_t *self, edict_t *other, edict_t *activator)
 	if (!self->health)
 	{
 		self->think = NULL;
-		self->nextthink = 0;
+		G_SetNextThink(self, 0);
 		return;
 	}
 
@@ -1923,12 +1923,12 @@ target_light_use(edict_t *self, edict_t *other, edict_t *activator)
 	if (self->chain)
 	{
 		self->think = target_light_think;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 	else if (self->spawnflags & SPAWNFLAG_TARGET_LIGHT_FLICKER)
 	{
 		self->think = target_light_flicker_think;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
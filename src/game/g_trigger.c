@@ -73,7 +73,7 @@ multi_wait(edict_t *ent)
 		return;
 	}
 
-	ent->nextthink = 0;
+	G_SetNextThink(ent, 0);
 }
 
 /*
@@ -101,7 +101,7 @@ multi_trigger(edict_t *ent)
 	if (ent->wait > 0)
 	{
 		ent->think = multi_wait;
-		ent->nextthink = level.time + ent->wait;
+		G_SetNextThink(ent, level.time + ent->wait);
 	}
 	else
 	{
@@ -110,7 +110,7 @@ multi_trigger(edict_t *ent)
 		   called while looping through area
 		   links... */
 		ent->touch = NULL;
-		ent->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(ent, level.time + FRAMETIME);
 		ent->think = G_FreeEdict;
 	}
 }
@@ -695,13 +695,13 @@ trigger_push_inactive(edict_t *self)
 
 	if (self->delay > level.time)
 	{
-		self->nextthink = level.time + 0.1;
+		G_SetNextThink(self, level.time + 0.1);
 	}
 	else
 	{
 		self->touch = trigger_push_touch;
 		self->think = trigger_push_active;
-		self->nextthink = level.time + 0.1;
+		G_SetNextThink(self, level.time + 0.1);
 		self->delay = self->nextthink + self->wait;
 	}
 }
@@ -716,14 +716,14 @@ trigger_push_active(edict_t *self)
 
 	if (self->delay > level.time)
 	{
-		self->nextthink = level.time + 0.1;
+		G_SetNextThink(self, level.time + 0.1);
 		trigger_effect(self);
 	}
 	else
 	{
 		self->touch = NULL;
 		self->think = trigger_push_inactive;
-		self->nextthink = level.time + 0.1;
+		G_SetNextThink(self, level.time + 0.1);
 		self->delay = self->nextthink + self->wait;
 	}
 }
@@ -783,7 +783,7 @@ SP_trigger_push(edict_t *self)
 		}
 
 		self->think = trigger_push_active;
-		self->nextthink = level.time + 0.1;
+		G_SetNextThink(self, level.time + 0.1);
 		self->delay = self->nextthink + self->wait;
 	}
 
@@ -254,7 +254,7 @@ turret_breach_think(edict_t *self)
 
 	VectorScale(delta, 1.0 / FRAMETIME, self->avelocity);
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	for (ent = self->teammaster; ent; ent = ent->teamchain)
 	{
@@ -387,7 +387,7 @@ SP_turret_breach(edict_t *self)
 	self->blocked = turret_blocked;
 
 	self->think = turret_breach_finish_init;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	gi.linkentity(self);
 }
 
@@ -460,7 +460,7 @@ turret_driver_think(edict_t *self)
 		return;
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	if (self->enemy && (!self->enemy->inuse || (self->enemy->health <= 0)))
 	{
@@ -534,7 +534,7 @@ turret_driver_link(edict_t *self)
 	}
 
 	self->think = turret_driver_think;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	self->target_ent = G_PickTarget(self->target);
 	self->target_ent->owner = self;
@@ -617,7 +617,7 @@ SP_turret_driver(edict_t *self)
 	}
 
 	self->think = turret_driver_link;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	gi.linkentity(self);
 }
@@ -641,7 +641,7 @@ turret_brain_think(edict_t *self)
 		return;
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	if (self->enemy)
 	{
@@ -741,7 +741,7 @@ turret_brain_link(edict_t *self)
 	}
 
 	self->think = turret_brain_think;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	self->target_ent = G_PickTarget(self->target);
 	self->target_ent->owner = self;
@@ -779,7 +779,7 @@ turret_brain_deactivate(edict_t *self, edict_t *other /* unused */, edict_t *act
 	}
 
 	self->think = NULL;
-	self->nextthink = 0;
+	G_SetNextThink(self, 0);
 }
 
 void
@@ -800,7 +800,7 @@ turret_brain_activate(edict_t *self, edict_t *other /* unused */, edict_t *activ
 	self->use = turret_brain_deactivate;
 
 	self->think = turret_brain_link;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 /*
@@ -845,7 +845,7 @@ SP_turret_invisible_brain(edict_t *self)
 	else
 	{
 		self->think = turret_brain_link;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 
 	self->movetype = MOVETYPE_PUSH;
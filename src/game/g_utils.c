@@ -25,6 +25,8 @@
  * =======================================================================
  */
 
+#include <ctype.h>
+
 #include "header/local.h"
 
 #define MAXCHOICES 8
@@ -56,6 +58,260 @@ G_ProjectSource2(const vec3_t point, const vec3_t distance, const vec3_t forward
 				up[2] * distance[2];
 }
 
+/*
+ * Hash indexes over classname and targetname, so G_Find()
+ * only visits entities with a matching name. Each chain is
+ * sorted by edict number, G_Find() returns the entities in
+ * the same order as a linear search. The links are kept
+ * outside the edicts, savegames aren't affected. This only
+ * works if the names are set with G_SetClassname() and
+ * G_SetTargetname(), or G_LinkNames() is called after
+ * writing the fields directly.
+ */
+#define NAME_HASH_SIZE 1024
+
+enum
+{
+	NAME_CLASSNAME,
+	NAME_TARGETNAME,
+	NUM_NAMES
+};
+
+typedef struct
+{
+	int next, prev;     /* edict numbers, -1 ends the chain */
+	int bucket;         /* -1 if not linked */
+} namelink_t;
+
+typedef struct
+{
+	int fieldofs;
+	int head[NAME_HASH_SIZE];
+	int tail[NAME_HASH_SIZE];
+	namelink_t *links;  /* [game.maxentities] */
+} nameindex_t;
+
+static nameindex_t g_names[NUM_NAMES] = {
+	{FOFS(classname)},
+	{FOFS(targetname)}
+};
+
+static int
+G_NameHash(const char *name)
+{
+	unsigned hash;
+
+	hash = 0;
+
+	while (*name)
+	{
+		hash = hash * 31 + tolower((unsigned char)*name);
+		name++;
+	}
+
+	return hash & (NAME_HASH_SIZE - 1);
+}
+
+static void
+G_UnlinkName(nameindex_t *index, int e)
+{
+	namelink_t *link;
+
+	link = &index->links[e];
+
+	if (link->bucket < 0)
+	{
+		return;
+	}
+
+	if (link->prev >= 0)
+	{
+		index->links[link->prev].next = link->next;
+	}
+	else
+	{
+		index->head[link->bucket] = link->next;
+	}
+
+	if (link->next >= 0)
+	{
+		index->links[link->next].prev = link->prev;
+	}
+	else
+	{
+		index->tail[link->bucket] = link->prev;
+	}
+
+	link->bucket = -1;
+}
+
+static void
+G_LinkName(nameindex_t *index, edict_t *ent)
+{
+	namelink_t *link;
+	const char *name;
+	int e, bucket, i;
+
+	if (!index->links)
+	{
+		return; /* no level loaded */
+	}
+
+	e = ent - g_edicts;
+	link = &index->links[e];
+	name = *(char **)((byte *)ent + index->fieldofs);
+	bucket = name ? G_NameHash(name) : -1;
+
+	/* the chain is sorted by edict
+	   number, nothing to do */
+	if (bucket == link->bucket)
+	{
+		return;
+	}
+
+	G_UnlinkName(index, e);
+
+	if (bucket < 0)
+	{
+		return;
+	}
+
+	link->bucket = bucket;
+
+	/* entities are mostly spawned in
+	   order, try the tail first */
+	i = index->tail[bucket];
+
+	while ((i >= 0) && (i > e))
+	{
+		i = index->links[i].prev;
+	}
+
+	link->prev = i;
+
+	if (i >= 0)
+	{
+		link->next = index->links[i].next;
+		index->links[i].next = e;
+	}
+	else
+	{
+		link->next = index->head[bucket];
+		index->head[bucket] = e;
+	}
+
+	if (link->next >= 0)
+	{
+		index->links[link->next].prev = e;
+	}
+	else
+	{
+		index->tail[bucket] = e;
+	}
+}
+
+/*
+ * Empties the name indexes, called whenever all
+ * edicts are wiped. The links are level memory.
+ */
+void
+G_ClearNames(void)
+{
+	nameindex_t *index;
+	int i;
+
+	for (index = g_names; index < &g_names[NUM_NAMES]; index++)
+	{
+		index->links = gi.TagMalloc(game.maxentities * sizeof(namelink_t),
+				TAG_LEVEL);
+
+		for (i = 0; i < game.maxentities; i++)
+		{
+			index->links[i].bucket = -1;
+		}
+
+		for (i = 0; i < NAME_HASH_SIZE; i++)
+		{
+			index->head[i] = -1;
+			index->tail[i] = -1;
+		}
+	}
+}
+
+/*
+ * Updates the name indexes after the
+ * fields were written directly.
+ */
+void
+G_LinkNames(edict_t *ent)
+{
+	G_LinkName(&g_names[NAME_CLASSNAME], ent);
+	G_LinkName(&g_names[NAME_TARGETNAME], ent);
+}
+
+void
+G_SetClassname(edict_t *ent, char *classname)
+{
+	ent->classname = classname;
+	G_LinkName(&g_names[NAME_CLASSNAME], ent);
+}
+
+void
+G_SetTargetname(edict_t *ent, char *targetname)
+{
+	ent->targetname = targetname;
+	G_LinkName(&g_names[NAME_TARGETNAME], ent);
+}
+
+/*
+ * G_Find() through a name index.
+ */
+static edict_t *
+G_FindName(edict_t *from, const nameindex_t *index, const char *match)
+{
+	edict_t *ent;
+	char *s;
+	int e, bucket;
+
+	bucket = G_NameHash(match);
+	e = index->head[bucket];
+
+	if (from)
+	{
+		/* when iterating from is in the same chain */
+		if (index->links[from - g_edicts].bucket == bucket)
+		{
+			e = index->links[from - g_edicts].next;
+		}
+		else
+		{
+			while ((e >= 0) && (e <= from - g_edicts))
+			{
+				e = index->links[e].next;
+			}
+		}
+	}
+
+	for ( ; e >= 0; e = index->links[e].next)
+	{
+		ent = &g_edicts[e];
+
+		if (!ent->inuse)
+		{
+			continue;
+		}
+
+		s = *(char **)((byte *)ent + index->fieldofs);
+
+		if (s && !Q_stricmp(s, match))
+		{
+			return ent;
+		}
+	}
+
+	return NULL;
+}
+
 /*
  * Searches all active entities for the next
  * one that holds the matching string at fieldofs
@@ -69,12 +325,21 @@ edict_t *
 G_Find(edict_t *from, int fieldofs, const char *match)
 {
 	char *s;
+	int i;
 
 	if (!match)
 	{
 		return NULL;
 	}
 
+	for (i = 0; i < NUM_NAMES; i++)
+	{
+		if ((fieldofs == g_names[i].fieldofs) && g_names[i].links)
+		{
+			return G_FindName(from, &g_names[i], match);
+		}
+	}
+
 	if (!from)
 	{
 		from = g_edicts;
@@ -108,110 +373,179 @@ G_Find(edict_t *from, int fieldofs, const char *match)
 }
 
 /*
- * Returns entities that have origins
- * within a spherical area
+ * Radius queries ask the server's area tree for the
+ * entities in the bounding box of the sphere, instead
+ * of looking at all edicts. The result is sorted by
+ * edict number and kept for the following calls of
+ * the same query, so the iterator returns the same
+ * entities in the same order as a linear search.
+ * Entities spawned while iterating aren't returned.
  */
-edict_t *
-findradius(edict_t *from, vec3_t org, float rad)
+static edict_t *radius_list[MAX_EDICTS];
+static int radius_count;
+static vec3_t radius_org;
+static float radius_rad;
+
+static int
+G_RadiusCompare(const void *a, const void *b)
 {
-	vec3_t eorg;
-	int j;
+	return *(edict_t * const *)a - *(edict_t * const *)b;
+}
 
-	if (!from)
-	{
-		from = g_edicts;
-	}
-	else
-	{
-		from++;
-	}
+/*
+ * Collects the candidates of a query. Returns
+ * false if there are too many to hold, the
+ * caller has to search linearly then.
+ */
+static qboolean
+G_RadiusQuery(const vec3_t org, float rad)
+{
+	vec3_t mins, maxs;
+	int i;
 
-	for ( ; from < &g_edicts[globals.num_edicts]; from++)
+	for (i = 0; i < 3; i++)
 	{
-		if (!from->inuse)
-		{
-			continue;
-		}
-
-		if (from->solid == SOLID_NOT)
-		{
-			continue;
-		}
+		mins[i] = org[i] - rad;
+		maxs[i] = org[i] + rad;
+	}
 
-		for (j = 0; j < 3; j++)
-		{
-			eorg[j] = org[j] - (from->s.origin[j] +
-					   (from->mins[j] + from->maxs[j]) * 0.5);
-		}
+	VectorCopy(org, radius_org);
+	radius_rad = rad;
 
-		if (VectorLength(eorg) > rad)
-		{
-			continue;
-		}
+	radius_count = gi.BoxEdicts(mins, maxs, radius_list, MAX_EDICTS,
+			AREA_SOLID);
+	radius_count += gi.BoxEdicts(mins, maxs, radius_list + radius_count,
+			MAX_EDICTS - radius_count, AREA_TRIGGERS);
 
-		return from;
+	if (radius_count >= MAX_EDICTS)
+	{
+		radius_count = -1;
+		return false;
 	}
 
-	return NULL;
+	qsort(radius_list, radius_count, sizeof(radius_list[0]),
+			G_RadiusCompare);
+
+	return true;
 }
 
-/*
- * Returns entities that have origins within a spherical area
- */
-edict_t *
-findradius2(edict_t *from, vec3_t org, float rad)
+static qboolean
+G_RadiusCheck(const edict_t *ent, const vec3_t org, float rad,
+		qboolean damageable)
 {
-	/* rad must be positive */
 	vec3_t eorg;
 	int j;
 
-	if (!from)
+	if (!ent->inuse)
 	{
-		from = g_edicts;
+		return false;
 	}
-	else
+
+	if (ent->solid == SOLID_NOT)
 	{
-		from++;
+		return false;
 	}
 
-	for ( ; from < &g_edicts[globals.num_edicts]; from++)
+	if (damageable &&
+		(!ent->takedamage || !(ent->svflags & SVF_DAMAGEABLE)))
 	{
-		if (!from->inuse)
-		{
-			continue;
-		}
+		return false;
+	}
 
-		if (from->solid == SOLID_NOT)
-		{
-			continue;
-		}
+	for (j = 0; j < 3; j++)
+	{
+		eorg[j] = org[j] - (ent->s.origin[j] +
+				   (ent->mins[j] + ent->maxs[j]) * 0.5);
+	}
 
-		if (!from->takedamage)
-		{
-			continue;
-		}
+	return VectorLength(eorg) <= rad;
+}
+
+static edict_t *
+G_RadiusNext(edict_t *from, const vec3_t org, float rad, qboolean damageable)
+{
+	int lo, hi, mid;
+
+	/* a new query, or another one came in between */
+	if (!from || (rad != radius_rad) || !VectorCompare(org, radius_org))
+	{
+		G_RadiusQuery(org, rad);
+	}
 
-		if (!(from->svflags & SVF_DAMAGEABLE))
+	if (radius_count < 0)
+	{
+		/* too many candidates, search all edicts */
+		for (from = from ? from + 1 : g_edicts;
+			 from < &g_edicts[globals.num_edicts]; from++)
 		{
-			continue;
+			if (G_RadiusCheck(from, org, rad, damageable))
+			{
+				return from;
+			}
 		}
 
-		for (j = 0; j < 3; j++)
+		return NULL;
+	}
+
+	/* the world isn't in the area tree */
+	if (!from && G_RadiusCheck(g_edicts, org, rad, damageable))
+	{
+		return g_edicts;
+	}
+
+	/* continue behind from */
+	lo = 0;
+
+	if (from)
+	{
+		hi = radius_count;
+
+		while (lo < hi)
 		{
-			eorg[j] = org[j] - (from->s.origin[j] + (from->mins[j] + from->maxs[j]) * 0.5);
+			mid = (lo + hi) / 2;
+
+			if (radius_list[mid] <= from)
+			{
+				lo = mid + 1;
+			}
+			else
+			{
+				hi = mid;
+			}
 		}
+	}
 
-		if (VectorLength(eorg) > rad)
+	for ( ; lo < radius_count; lo++)
+	{
+		if (G_RadiusCheck(radius_list[lo], org, rad, damageable))
 		{
-			continue;
+			return radius_list[lo];
 		}
-
-		return from;
 	}
 
 	return NULL;
 }
 
+/*
+ * Returns entities that have origins
+ * within a spherical area
+ */
+edict_t *
+findradius(edict_t *from, vec3_t org, float rad)
+{
+	return G_RadiusNext(from, org, rad, false);
+}
+
+/*
+ * Returns entities that have origins within a spherical area
+ */
+edict_t *
+findradius2(edict_t *from, vec3_t org, float rad)
+{
+	/* rad must be positive */
+	return G_RadiusNext(from, org, rad, true);
+}
+
 /*
  * Searches all active entities for
  * the next one that holds the matching
@@ -302,8 +636,8 @@ G_UseTargets(edict_t *ent, edict_t *activator)
 	{
 		/* create a temp object to fire at a later time */
 		t = G_Spawn();
-		t->classname = "DelayedUse";
-		t->nextthink = level.time + ent->delay;
+		G_SetClassname(t, "DelayedUse");
+		G_SetNextThink(t, level.time + ent->delay);
 		t->think = Think_Delay;
 		t->activator = activator;
 
@@ -418,6 +752,8 @@ G_UseTargets(edict_t *ent, edict_t *activator)
 			{
 				if (t->use)
 				{
+					/* use may change more than nextthink */
+					G_WakeEdict(t);
 					t->use(t, ent, activator);
 				}
 			}
@@ -702,11 +1038,12 @@ G_InitEdict(edict_t *e)
 
 	if (e->nextthink)
 	{
-		e->nextthink = 0;
+		G_SetNextThink(e, 0);
 	}
 
+	G_WakeEdict(e);
 	e->inuse = true;
-	e->classname = "noclass";
+	G_SetClassname(e, "noclass");
 	e->gravity = 1.0;
 	e->s.number = e - g_edicts;
 
@@ -717,6 +1054,115 @@ G_InitEdict(edict_t *e)
 	VectorSet(e->rrs.scale, 1.0, 1.0, 1.0);
 }
 
+/*
+ * Freed edicts wait in a FIFO, ordered by freetime.
+ * Only the oldest one has to be checked against the
+ * reuse policy, allocation doesn't scan the edicts.
+ * The links are level memory, like the name indexes.
+ */
+typedef struct
+{
+	int next, prev;     /* edict numbers, -1 ends the queue */
+	qboolean queued;
+} freelink_t;
+
+static freelink_t *free_links;  /* [game.maxentities] */
+static int free_head, free_tail;
+static int free_count;
+static int desperate_spawns;
+
+static void
+G_QueueFreeEdict(int e)
+{
+	freelink_t *link;
+
+	link = &free_links[e];
+	link->queued = true;
+	link->next = -1;
+	link->prev = free_tail;
+
+	if (free_tail >= 0)
+	{
+		free_links[free_tail].next = e;
+	}
+	else
+	{
+		free_head = e;
+	}
+
+	free_tail = e;
+	free_count++;
+}
+
+static void
+G_UnqueueFreeEdict(int e)
+{
+	freelink_t *link;
+
+	link = &free_links[e];
+
+	if (!link->queued)
+	{
+		return;
+	}
+
+	if (link->prev >= 0)
+	{
+		free_links[link->prev].next = link->next;
+	}
+	else
+	{
+		free_head = link->next;
+	}
+
+	if (link->next >= 0)
+	{
+		free_links[link->next].prev = link->prev;
+	}
+	else
+	{
+		free_tail = link->prev;
+	}
+
+	link->queued = false;
+	free_count--;
+}
+
+/*
+ * Rebuilds the free list from the edicts, called
+ * whenever they were wiped or loaded. Free edicts
+ * are queued in order, they have no freetime.
+ */
+void
+G_ClearFreeEdicts(void)
+{
+	int i;
+
+	free_links = gi.TagMalloc(game.maxentities * sizeof(freelink_t),
+			TAG_LEVEL);
+	free_head = -1;
+	free_tail = -1;
+	free_count = 0;
+	desperate_spawns = 0;
+
+	for (i = game.maxclients + 1; i < globals.num_edicts; i++)
+	{
+		if (!g_edicts[i].inuse)
+		{
+			G_QueueFreeEdict(i);
+		}
+	}
+}
+
+void
+G_PrintEdictStats(void)
+{
+	gi.cprintf(NULL, PRINT_HIGH, "%i of %i edicts, %i free, "
+			"%i desperate allocations, %i sleeping\n", globals.num_edicts,
+			game.maxentities, free_count, desperate_spawns,
+			G_SleepingEdicts());
+}
+
 /*
  * Either finds a free edict, or allocates a
  * new one.  Try to avoid reusing an entity
@@ -734,16 +1180,22 @@ G_FindFreeEdict(int policy)
 {
 	edict_t *e;
 
-	for (e = g_edicts + game.maxclients + 1 ; e < &g_edicts[globals.num_edicts] ; e++)
+	if (!free_links || (free_head < 0))
 	{
-		/* the first couple seconds of server time can involve a lot of
-		   freeing and allocating, so relax the replacement policy
-		*/
-		if (!e->inuse && (policy == POLICY_DESPERATE || e->freetime < 2.0f || (level.time - e->freetime) > 0.5f))
-		{
-			G_InitEdict(e);
-			return e;
-		}
+		return NULL;
+	}
+
+	e = &g_edicts[free_head];
+
+	/* the first couple seconds of server time can involve a lot of
+	   freeing and allocating, so relax the replacement policy. the
+	   head is the oldest one, if it's too young all others are.
+	*/
+	if (policy == POLICY_DESPERATE || e->freetime < 2.0f || (level.time - e->freetime) > 0.5f)
+	{
+		G_UnqueueFreeEdict(free_head);
+		G_InitEdict(e);
+		return e;
 	}
 
 	return NULL;
@@ -761,7 +1213,14 @@ G_SpawnOptional(void)
 
 	if (globals.num_edicts >= game.maxentities)
 	{
-		return G_FindFreeEdict (POLICY_DESPERATE);
+		e = G_FindFreeEdict (POLICY_DESPERATE);
+
+		if (e)
+		{
+			desperate_spawns++;
+		}
+
+		return e;
 	}
 
 	e = &g_edicts[globals.num_edicts++];
@@ -812,9 +1271,17 @@ G_FreeEdict(edict_t *ed)
 	}
 
 	memset(ed, 0, sizeof(*ed));
-	ed->classname = "freed";
+	G_LinkNames(ed);
+	G_SetClassname(ed, "freed");
 	ed->freetime = level.time;
 	ed->inuse = false;
+
+	if (free_links)
+	{
+		/* freed twice, it goes to the end again */
+		G_UnqueueFreeEdict(ed - g_edicts);
+		G_QueueFreeEdict(ed - g_edicts);
+	}
 }
 
 void
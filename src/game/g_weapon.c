@@ -470,10 +470,10 @@ fire_blaster(edict_t *self, vec3_t start, vec3_t dir, int damage,
 	bolt->s.sound = gi.soundindex("misc/lasfly.wav");
 	bolt->owner = self;
 	bolt->touch = blaster_touch;
-	bolt->nextthink = level.time + 2;
+	G_SetNextThink(bolt, level.time + 2);
 	bolt->think = G_FreeEdict;
 	bolt->dmg = damage;
-	bolt->classname = "bolt";
+	G_SetClassname(bolt, "bolt");
 
 	if (hyper)
 	{
@@ -526,10 +526,10 @@ fire_blueblaster(edict_t *self, vec3_t start, vec3_t dir, int damage,
 	bolt->s.sound = gi.soundindex("misc/lasfly.wav");
 	bolt->owner = self;
 	bolt->touch = blaster_touch;
-	bolt->nextthink = level.time + 2;
+	G_SetNextThink(bolt, level.time + 2);
 	bolt->think = G_FreeEdict;
 	bolt->dmg = damage;
-	bolt->classname = "bolt";
+	G_SetClassname(bolt, "bolt");
 	gi.linkentity(bolt);
 
 	if (self->client)
@@ -713,11 +713,11 @@ fire_grenade(edict_t *self, vec3_t start, vec3_t aimdir, int damage, int speed,
 	grenade->s.modelindex = gi.modelindex("models/objects/grenade/tris.md2");
 	grenade->owner = self;
 	grenade->touch = Grenade_Touch;
-	grenade->nextthink = level.time + timer;
+	G_SetNextThink(grenade, level.time + timer);
 	grenade->think = Grenade_Explode;
 	grenade->dmg = damage;
 	grenade->dmg_radius = damage_radius;
-	grenade->classname = "grenade";
+	G_SetClassname(grenade, "grenade");
 
 	gi.linkentity(grenade);
 }
@@ -753,11 +753,11 @@ fire_grenade2(edict_t *self, vec3_t start, vec3_t aimdir, int damage,
 	grenade->s.modelindex = gi.modelindex("models/objects/grenade2/tris.md2");
 	grenade->owner = self;
 	grenade->touch = Grenade_Touch;
-	grenade->nextthink = level.time + timer;
+	G_SetNextThink(grenade, level.time + timer);
 	grenade->think = Grenade_Explode;
 	grenade->dmg = damage;
 	grenade->dmg_radius = damage_radius;
-	grenade->classname = "hgrenade";
+	G_SetClassname(grenade, "hgrenade");
 
 	if (held)
 	{
@@ -885,13 +885,13 @@ fire_rocket(edict_t *self, vec3_t start, vec3_t dir, int damage,
 	rocket->s.modelindex = gi.modelindex("models/objects/rocket/tris.md2");
 	rocket->owner = self;
 	rocket->touch = rocket_touch;
-	rocket->nextthink = level.time + (8000.0f / (float)speed);
+	G_SetNextThink(rocket, level.time + (8000.0f / (float)speed));
 	rocket->think = G_FreeEdict;
 	rocket->dmg = damage;
 	rocket->radius_dmg = radius_damage;
 	rocket->dmg_radius = damage_radius;
 	rocket->s.sound = gi.soundindex("weapons/rockfly.wav");
-	rocket->classname = "rocket";
+	G_SetClassname(rocket, "rocket");
 
 	if (self->client)
 	{
@@ -1041,7 +1041,7 @@ bfg_explode(edict_t *self)
 		}
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	self->s.frame++;
 
 	if (self->s.frame == 5)
@@ -1108,7 +1108,7 @@ bfg_touch(edict_t *self, edict_t *other, cplane_t *plane, csurface_t *surf)
 	self->s.sound = 0;
 	self->s.effects &= ~EF_ANIM_ALLFAST;
 	self->think = bfg_explode;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	self->enemy = other;
 
 	gi.linkentity(self);
@@ -1230,7 +1230,7 @@ bfg_think(edict_t *self)
 		gi.multicast(self->s.origin, MULTICAST_PHS);
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void
@@ -1258,15 +1258,15 @@ fire_bfg(edict_t *self, vec3_t start, vec3_t dir, int damage,
 	bfg->s.modelindex = gi.modelindex("sprites/s_bfg1.sp2");
 	bfg->owner = self;
 	bfg->touch = bfg_touch;
-	bfg->nextthink = level.time + (8000.0f / (float)speed);
+	G_SetNextThink(bfg, level.time + (8000.0f / (float)speed));
 	bfg->think = G_FreeEdict;
 	bfg->radius_dmg = damage;
 	bfg->dmg_radius = damage_radius;
-	bfg->classname = "bfg blast";
+	G_SetClassname(bfg, "bfg blast");
 	bfg->s.sound = gi.soundindex("weapons/bfg__l1a.wav");
 
 	bfg->think = bfg_think;
-	bfg->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(bfg, level.time + FRAMETIME);
 	bfg->teammaster = bfg;
 	bfg->teamchain = NULL;
 
@@ -1367,7 +1367,7 @@ fire_ionripper(edict_t *self, vec3_t start, vec3_t dir, int damage,
 	ion->s.sound = gi.soundindex("misc/lasfly.wav");
 	ion->owner = self;
 	ion->touch = ionripper_touch;
-	ion->nextthink = level.time + 3;
+	G_SetNextThink(ion, level.time + 3);
 	ion->think = ionripper_sparks;
 	ion->dmg = damage;
 	ion->dmg_radius = 100;
@@ -1447,7 +1447,7 @@ heat_think(edict_t *self)
 		VectorScale(vec, 500, self->velocity);
 	}
 
-	self->nextthink = level.time + 0.1;
+	G_SetNextThink(self, level.time + 0.1);
 }
 
 void
@@ -1476,7 +1476,7 @@ fire_heat(edict_t *self, vec3_t start, vec3_t dir, int damage, int speed,
 	heat->owner = self;
 	heat->touch = rocket_touch;
 
-	heat->nextthink = level.time + 0.1;
+	G_SetNextThink(heat, level.time + 0.1);
 	heat->think = heat_think;
 
 	heat->dmg = damage;
@@ -1575,7 +1575,7 @@ fire_plasma(edict_t *self, vec3_t start, vec3_t dir, int damage,
 
 	plasma->owner = self;
 	plasma->touch = plasma_touch;
-	plasma->nextthink = level.time + (8000.0f / (float)speed);
+	G_SetNextThink(plasma, level.time + (8000.0f / (float)speed));
 	plasma->think = G_FreeEdict;
 	plasma->dmg = damage;
 	plasma->radius_dmg = radius_damage;
@@ -1614,7 +1614,7 @@ Trap_Think(edict_t *ent)
 		return;
 	}
 
-	ent->nextthink = level.time + 0.1;
+	G_SetNextThink(ent, level.time + 0.1);
 
 	if (!ent->groundentity)
 	{
@@ -1684,7 +1684,7 @@ Trap_Think(edict_t *ent)
 					best->waterlevel = 1;
 				}
 
-				best->nextthink = level.time + 0.1;
+				G_SetNextThink(best, level.time + 0.1);
 				best->think = G_FreeEdict;
 				gi.linkentity(best);
 			}
@@ -1701,7 +1701,7 @@ Trap_Think(edict_t *ent)
 
 		if (ent->s.frame == 8)
 		{
-			ent->nextthink = level.time + 1.0;
+			G_SetNextThink(ent, level.time + 1.0);
 			ent->think = G_FreeEdict;
 
 			best = G_Spawn();
@@ -1860,11 +1860,11 @@ fire_trap(edict_t *self, vec3_t start, vec3_t aimdir, int damage,
 	VectorSet(trap->maxs, 4, 4, 8);
 	trap->s.modelindex = gi.modelindex("models/weapons/z_trap/tris.md2");
 	trap->owner = self;
-	trap->nextthink = level.time + 1.0;
+	G_SetNextThink(trap, level.time + 1.0);
 	trap->think = Trap_Think;
 	trap->dmg = damage;
 	trap->dmg_radius = damage_radius;
-	trap->classname = "htrap";
+	G_SetClassname(trap, "htrap");
 	trap->s.sound = gi.soundindex("weapons/traploop.wav");
 
 	if (held)
@@ -38,6 +38,12 @@
 #define GAME_API_R97_VERSION 3
 #define GAME_API_VERSION 4
 
+/* Read only cvar the engine sets to the size of its game_import_t
+   before loading the game. Older engines don't set it and fill in
+   the imports up to RunParallel only, the game must not copy or
+   call the ones behind. */
+#define GAME_IMPORT_SIZE_CVAR "sv_gameimportsize"
+
 /* edict->svflags */
 #define SVF_NOCLIENT 0x00000001             /* don't send entity to clients, even if it has effects */
 #define SVF_DEADMONSTER 0x00000002          /* treat as CONTENTS_DEADMONSTER for collision */
@@ -221,6 +227,16 @@ typedef struct
 
 	const char* (*LocalizationMessage)(const char *message, int *sound_index);
 	const char* (*LocalizationUIMessage)(const char *message, const char *default_message);
+
+	/* Runs func(data, index) for each index below count on worker
+	   threads and returns when all are done. func must not change
+	   anything outside of its own results and may only call the
+	   reentrant functions, that is TraceReentrant. Both are NULL
+	   in the game if GAME_IMPORT_SIZE_CVAR doesn't cover them. */
+	void (*RunParallel)(void (*func)(void *data, int index), void *data, int count);
+	trace_t (*TraceReentrant)(const vec3_t start, const vec3_t mins,
+			const vec3_t maxs, const vec3_t end, const edict_t *passent,
+			int contentmask);
 } game_import_t;
 
 /* functions exported by the game subsystem */
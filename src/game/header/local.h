@@ -673,6 +673,9 @@ extern cvar_t *g_select_empty;
 extern cvar_t *dedicated;
 extern cvar_t *g_footsteps;
 extern cvar_t *g_monsterfootsteps;
+extern cvar_t *g_monster_lod;
+extern cvar_t *g_sight_validate;
+extern cvar_t *g_perception;
 extern cvar_t *g_fix_triggered;
 extern cvar_t *g_commanderbody_nogod;
 
@@ -817,12 +820,18 @@ qboolean KillBox(edict_t *ent);
 void G_ProjectSource(const vec3_t point, const vec3_t distance, const vec3_t forward,
 		const vec3_t right, vec3_t result);
 edict_t *G_Find(edict_t *from, int fieldofs, const char *match);
+void G_ClearNames(void);
+void G_LinkNames(edict_t *ent);
+void G_SetClassname(edict_t *ent, char *classname);
+void G_SetTargetname(edict_t *ent, char *targetname);
 edict_t *findradius(edict_t *from, vec3_t org, float rad);
 edict_t *G_PickTarget(char *targetname);
 void G_UseTargets(edict_t *ent, edict_t *activator);
 void G_SetMovedir(vec3_t angles, vec3_t movedir);
 
 void G_InitEdict(edict_t *e);
+void G_ClearFreeEdicts(void);
+void G_PrintEdictStats(void);
 edict_t *G_SpawnOptional(void);
 edict_t *G_Spawn(void);
 void G_FreeEdict(edict_t *e);
@@ -927,6 +936,7 @@ void monster_dynamic_pain_noanim(edict_t *self, edict_t *other /* unused */,
 		float kick /* unused */, int damage);
 void monster_dynamic_sight(edict_t *self, edict_t *other /* unused */);
 void monster_think(edict_t *self);
+void M_ClearLOD(void);
 void walkmonster_start(edict_t *self);
 void swimmonster_start(edict_t *self);
 void flymonster_start(edict_t *self);
@@ -961,6 +971,10 @@ void SP_misc_teleporter_dest(edict_t *ent);
 
 /* g_ai.c */
 void AI_SetSightClient(void);
+void AI_InitSight(void);
+void AI_PrintSightStats(void);
+void AI_ClearPerception(void);
+void AI_RunPerception(void);
 
 void ai_stand(edict_t *self, float dist);
 void ai_move(edict_t *self, float dist);
@@ -1093,6 +1107,13 @@ void M_SetAnimGroupFrameValues(edict_t *self, const char *name,
 
 /* g_phys.c */
 void G_RunEntity(edict_t *ent);
+void G_SetNextThink(edict_t *ent, float nextthink);
+void G_WakeEdict(edict_t *ent);
+void G_CheckSleep(edict_t *ent);
+void G_ClearThinks(void);
+void G_RunThinkWheel(void);
+int G_NextAwakeEdict(int e);
+int G_SleepingEdicts(void);
 void SV_AddGravity(edict_t *ent);
 
 /* g_main.c */
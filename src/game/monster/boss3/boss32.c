@@ -852,7 +852,7 @@ makron_torso_think(edict_t *self)
 		self->s.frame = FRAME_death301;
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 static void
@@ -929,7 +929,7 @@ makron_torso(edict_t *self)
 	torso->s.frame = FRAME_death301;
 	torso->s.modelindex = gi.modelindex("models/monsters/boss3/rider/tris.md2");
 	torso->think = makron_torso_think;
-	torso->nextthink = level.time + 2 * FRAMETIME;
+	G_SetNextThink(torso, level.time + 2 * FRAMETIME);
 	torso->s.sound = gi.soundindex("makron/spine.wav");
 
 	gi.linkentity(torso);
@@ -1273,8 +1273,8 @@ MakronToss(edict_t *self)
 	}
 
 	ent = G_Spawn();
-	ent->classname = "monster_makron";
-	ent->nextthink = level.time + 0.8;
+	G_SetClassname(ent, "monster_makron");
+	G_SetNextThink(ent, level.time + 0.8);
 	ent->think = MakronSpawn;
 	ent->target = self->target;
 	VectorCopy(self->s.origin, ent->s.origin);
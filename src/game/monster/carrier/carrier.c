@@ -479,7 +479,7 @@ CarrierSpawn(edict_t *self)
 
 		self->monsterinfo.monster_slots--;
 
-		ent->nextthink = level.time;
+		G_SetNextThink(ent, level.time);
 		ent->think(ent);
 
 		ent->monsterinfo.aiflags |= AI_SPAWNED_CARRIER | AI_DO_NOT_COUNT |
@@ -121,10 +121,10 @@ fire_enfbolt(edict_t *self, vec3_t start, vec3_t dir, int damage, int speed)
 	bolt->s.modelindex = gi.modelindex("models/monsters/objects/laser/tris.md2");
 	bolt->owner = self;
 	bolt->touch = enfbolt_touch;
-	bolt->nextthink = level.time + 5;
+	G_SetNextThink(bolt, level.time + 5);
 	bolt->think = G_FreeEdict;
 	bolt->dmg = damage;
-	bolt->classname = "enfbolt";
+	G_SetClassname(bolt, "enfbolt");
 	gi.linkentity(bolt);
 
 	tr = gi.trace (self->s.origin, NULL, NULL, bolt->s.origin, bolt, MASK_SHOT);
@@ -168,7 +168,7 @@ bot_goal_think(edict_t *self)
 	}
 	else
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -177,12 +177,12 @@ make_bot_goal(edict_t *self)
 {
 	edict_t *ent = G_Spawn();
 
-	ent->classname = "bot_goal";
+	G_SetClassname(ent, "bot_goal");
 	ent->solid = SOLID_BBOX;
 	ent->owner = self;
 
 	ent->think = bot_goal_think;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 	ent->touch_debounce_time = level.time + FIXBOT_GOAL_TIMEOUT;
 
 	return ent;
@@ -386,7 +386,7 @@ use_scanner(edict_t *self)
 			/* remove the old one */
 			if (strcmp(self->goalentity->classname, "bot_goal") == 0)
 			{
-				self->goalentity->nextthink = level.time + 0.1;
+				G_SetNextThink(self->goalentity, level.time + 0.1);
 				self->goalentity->think = G_FreeEdict;
 			}
 
@@ -412,7 +412,7 @@ use_scanner(edict_t *self)
 
 		if (self->goalentity->touch_debounce_time < level.time || VectorLength(vec) < 32)
 		{
-			self->goalentity->nextthink = level.time + 0.1;
+			G_SetNextThink(self->goalentity, level.time + 0.1);
 			self->goalentity->think = G_FreeEdict;
 			self->goalentity = self->enemy = NULL;
 
@@ -441,7 +441,7 @@ use_scanner(edict_t *self)
 
 		if (strcmp(self->goalentity->classname, "bot_goal") == 0)
 		{
-			self->goalentity->nextthink = level.time + 0.1;
+			G_SetNextThink(self->goalentity, level.time + 0.1);
 			self->goalentity->think = G_FreeEdict;
 			self->goalentity = self->enemy = NULL;
 		}
@@ -647,7 +647,7 @@ fly_vertical(edict_t *self)
 	if ((self->s.frame == FRAME_landing_58) ||
 		(self->s.frame == FRAME_takeoff_16))
 	{
-		self->goalentity->nextthink = level.time + 0.1;
+		G_SetNextThink(self->goalentity, level.time + 0.1);
 		self->goalentity->think = G_FreeEdict;
 		self->monsterinfo.currentmove = &fixbot_move_stand;
 		self->goalentity = self->enemy = NULL;
@@ -685,7 +685,7 @@ fly_vertical2(edict_t *self)
 
 	if (len < 32)
 	{
-		self->goalentity->nextthink = level.time + 0.1;
+		G_SetNextThink(self->goalentity, level.time + 0.1);
 		self->goalentity->think = G_FreeEdict;
 		self->monsterinfo.currentmove = &fixbot_move_stand;
 		self->goalentity = self->enemy = NULL;
@@ -1199,7 +1199,7 @@ fixbot_fire_laser(edict_t *self)
 			self->enemy->spawnflags = 0;
 			self->enemy->monsterinfo.aiflags = 0;
 			self->enemy->target = NULL;
-			self->enemy->targetname = NULL;
+			G_SetTargetname(self->enemy, NULL);
 			self->enemy->combattarget = NULL;
 			self->enemy->deathtarget = NULL;
 			self->enemy->owner = self;
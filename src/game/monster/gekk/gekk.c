@@ -844,7 +844,7 @@ fire_loogie(edict_t *self, vec3_t start, vec3_t dir, int damage, int speed)
 	loogie->s.modelindex = gi.modelindex("models/objects/loogy/tris.md2");
 	loogie->owner = self;
 	loogie->touch = loogie_touch;
-	loogie->nextthink = level.time + 2;
+	G_SetNextThink(loogie, level.time + 2);
 	loogie->think = G_FreeEdict;
 	loogie->dmg = damage;
 	gi.linkentity(loogie);
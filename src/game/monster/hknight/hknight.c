@@ -173,10 +173,10 @@ fire_magic(edict_t *self, vec3_t start, vec3_t dir, int damage, int speed)
 	magic->s.modelindex = gi.modelindex("models/proj/fireball/tris.md2");
 	magic->owner = self;
 	magic->touch = magic_touch;
-	magic->nextthink = level.time + 10;
+	G_SetNextThink(magic, level.time + 10);
 	magic->think = G_FreeEdict;
 	magic->dmg = damage;
-	magic->classname = "fireball";
+	G_SetClassname(magic, "fireball");
 	gi.linkentity(magic);
 
 	tr = gi.trace (magic->s.origin, NULL, NULL, magic->s.origin, magic, MASK_SHOT);
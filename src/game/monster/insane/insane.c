@@ -872,7 +872,7 @@ insane_dead(edict_t *self)
 	}
 
 	self->svflags |= SVF_DEADMONSTER;
-	self->nextthink = 0;
+	G_SetNextThink(self, 0);
 	gi.linkentity(self);
 }
 
@@ -1213,7 +1213,7 @@ medic_cable_attack(edict_t *self)
 		self->enemy->spawnflags = 0;
 		self->enemy->monsterinfo.aiflags = 0;
 		self->enemy->target = NULL;
-		self->enemy->targetname = NULL;
+		G_SetTargetname(self->enemy, NULL);
 		self->enemy->combattarget = NULL;
 		self->enemy->deathtarget = NULL;
 		self->enemy->owner = self;
@@ -1243,7 +1243,7 @@ medic_cable_attack(edict_t *self)
 
 			if (self->enemy->think)
 			{
-				self->enemy->nextthink = level.time;
+				G_SetNextThink(self->enemy, level.time);
 				self->enemy->think(self->enemy);
 			}
 
@@ -1685,7 +1685,7 @@ medic_finish_spawn(edict_t *self)
 
 		if (ent->think)
 		{
-			ent->nextthink = level.time;
+			G_SetNextThink(ent, level.time);
 			ent->think(ent);
 		}
 
@@ -1911,7 +1911,7 @@ MedicCommanderCache(void)
 
 		VectorCopy(vec3_origin, newEnt->s.origin);
 		VectorCopy(vec3_origin, newEnt->s.angles);
-		newEnt->classname = ED_NewString(reinforcements[i], true);
+		G_SetClassname(newEnt, ED_NewString(reinforcements[i], true));
 
 		newEnt->monsterinfo.aiflags |= AI_DO_NOT_COUNT;
 
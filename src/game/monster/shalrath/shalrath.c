@@ -142,7 +142,7 @@ shalrath_pod_home(edict_t *self)
 	gi.WriteByte(255);
 	gi.multicast(self->s.origin, MULTICAST_PVS);
 
-	self->nextthink = level.time + 0.1;
+	G_SetNextThink(self, level.time + 0.1);
 	self->think = shalrath_pod_home;
 	think = !think;
 }
@@ -172,10 +172,10 @@ fire_shalrath_pod(edict_t *self, vec3_t start, vec3_t dir, int damage, int speed
 	pod->s.modelindex = gi.modelindex("models/proj/pod/tris.md2");
 	pod->owner = self;
 	pod->touch = shalrath_pod_touch;
-	pod->nextthink = level.time + 0.1;
+	G_SetNextThink(pod, level.time + 0.1);
 	pod->think = shalrath_pod_home;
 	pod->dmg = damage;
-	pod->classname = "shalrath_pod";
+	G_SetClassname(pod, "shalrath_pod");
 	pod->enemy = self->enemy;
 
 	gi.linkentity(pod);
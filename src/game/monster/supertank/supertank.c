@@ -847,7 +847,7 @@ BossExplode(edict_t *self)
 	gi.WritePosition(org);
 	gi.multicast(self->s.origin, MULTICAST_PVS);
 
-	self->nextthink = level.time + 0.1;
+	G_SetNextThink(self, level.time + 0.1);
 }
 
 void
@@ -1220,7 +1220,7 @@ tank_stand_think(edict_t * self)
 		self->s.frame++;
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 /*
@@ -1323,7 +1323,7 @@ SP_monster_tank(edict_t *self)
 		self->monsterinfo.scale = MODEL_SCALE * 1.5f;
 		self->use = Use_Boss3;
 		self->think = tank_stand_think;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 	else
 	{
@@ -236,7 +236,7 @@ tarbaby_die(edict_t *self, edict_t *inflictor /* unused */,
 	self->s.frame = FRAME_exp;
 	self->deadflag = DEAD_DEAD;
 	self->think = tarbaby_explode;
-	self->nextthink = level.time + 0.1;
+	G_SetNextThink(self, level.time + 0.1);
 }
 
 /*
@@ -391,7 +391,7 @@ WidowSpawn(edict_t *self)
 
 			self->monsterinfo.monster_used++;
 			ent->monsterinfo.commander = self;
-			ent->nextthink = level.time;
+			G_SetNextThink(ent, level.time);
 			ent->think(ent);
 
 			ent->monsterinfo.aiflags |= AI_SPAWNED_WIDOW | AI_DO_NOT_COUNT | AI_IGNORE_SHOTS;
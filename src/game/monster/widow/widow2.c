@@ -227,7 +227,7 @@ Widow2Spawn(edict_t *self)
 			self->monsterinfo.monster_used++;
 			ent->monsterinfo.commander = self;
 
-			ent->nextthink = level.time;
+			G_SetNextThink(ent, level.time);
 			ent->think(ent);
 
 			ent->monsterinfo.aiflags |= AI_SPAWNED_WIDOW | AI_DO_NOT_COUNT | AI_IGNORE_SHOTS;
@@ -925,7 +925,7 @@ widow2_finaldeath(edict_t *self)
 	VectorSet(self->maxs, 70, 70, 80);
 	self->movetype = MOVETYPE_TOSS;
 	self->takedamage = DAMAGE_YES;
-	self->nextthink = 0;
+	G_SetNextThink(self, 0);
 	gi.linkentity(self);
 }
 
@@ -1646,11 +1646,11 @@ ThrowWidowGibReal(edict_t *self, char *gibname, int damage, gibtype_t type,
 		/* sized gibs last longer */
 		if (sized)
 		{
-			gib->nextthink = level.time + 20 + random() * 15;
+			G_SetNextThink(gib, level.time + 20 + random() * 15);
 		}
 		else
 		{
-			gib->nextthink = level.time + 5 + random() * 10;
+			G_SetNextThink(gib, level.time + 5 + random() * 10);
 		}
 	}
 	else
@@ -1660,11 +1660,11 @@ ThrowWidowGibReal(edict_t *self, char *gibname, int damage, gibtype_t type,
 		/* sized gibs last longer */
 		if (sized)
 		{
-			gib->nextthink = level.time + 60 + random() * 15;
+			G_SetNextThink(gib, level.time + 60 + random() * 15);
 		}
 		else
 		{
-			gib->nextthink = level.time + 25 + random() * 10;
+			G_SetNextThink(gib, level.time + 25 + random() * 10);
 		}
 	}
 
@@ -1890,7 +1890,7 @@ WidowExplode(edict_t *self)
 
 			self->deadflag = DEAD_DEAD;
 			self->think = monster_think;
-			self->nextthink = level.time + 0.1;
+			G_SetNextThink(self, level.time + 0.1);
 			self->monsterinfo.currentmove = &widow2_move_dead;
 			return;
 	}
@@ -1921,7 +1921,7 @@ WidowExplode(edict_t *self)
 		gi.multicast(self->s.origin, MULTICAST_ALL);
 	}
 
-	self->nextthink = level.time + 0.1;
+	G_SetNextThink(self, level.time + 0.1);
 }
 
 void
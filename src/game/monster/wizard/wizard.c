@@ -125,10 +125,10 @@ spit_fire(edict_t *self, vec3_t start, vec3_t dir, int damage, int speed)
 	spit->s.modelindex = gi.modelindex("models/proj/spit/tris.md2");
 	spit->owner = self;
 	spit->touch = spit_touch;
-	spit->nextthink = level.time + 2;
+	G_SetNextThink(spit, level.time + 2);
 	spit->think = G_FreeEdict;
 	spit->dmg = damage;
-	spit->classname = "spit";
+	G_SetClassname(spit, "spit");
 	gi.linkentity(spit);
 
 	tr = gi.trace (self->s.origin, NULL, NULL, spit->s.origin, spit, MASK_SHOT);
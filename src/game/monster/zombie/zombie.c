@@ -140,10 +140,10 @@ fire_zombie_gib(edict_t *self, vec3_t start, vec3_t aimdir, int damage, int spee
 	gib->s.modelindex = gi.modelindex("models/objects/gibs/sm_meat/tris.md2");
 	gib->owner = self;
 	gib->touch = zombie_gib_touch;
-	gib->nextthink = level.time + 2.5;
+	G_SetNextThink(gib, level.time + 2.5);
 	gib->think = G_FreeEdict;
 	gib->dmg = damage;
-	gib->classname = "zombie_gib";
+	G_SetClassname(gib, "zombie_gib");
 
 	gi.linkentity(gib);
 	gi.sound(self, CHAN_WEAPON, sound_fling, 1, ATTN_NORM, 0);
@@ -81,7 +81,7 @@ ChasecamStart(edict_t *ent)
 	 * entity's because as the camera starts, it will force itself out
 	 * slowly backwards from the player model */
 	VectorCopy(ent->s.origin, chasecam->s.origin);
-	chasecam->classname = "chasecam";
+	G_SetClassname(chasecam, "chasecam");
 	chasecam->prethink = ChasecamTrack;
 	chasecam->think = ChasecamTrack;
 	ent->client->chasecam = chasecam;
@@ -130,7 +130,7 @@ ChasecamTrack(edict_t *ent)
 	int distance;
 	int tot;
 
-	ent->nextthink = level.time + 0.100;
+	G_SetNextThink(ent, level.time + 0.100);
 
 	/* get the CLIENT's angle, and break it down into direction vectors,
 	 * of forward, right, and up. VERY useful */
@@ -90,7 +90,7 @@ SP_FixCoopSpots(edict_t *self)
 		{
 			if ((!self->targetname) || (Q_stricmp(self->targetname, spot->targetname) != 0))
 			{
-				self->targetname = spot->targetname;
+				G_SetTargetname(self, spot->targetname);
 			}
 
 			return;
@@ -117,27 +117,27 @@ SP_CreateCoopSpots(edict_t *self)
 	if (Q_stricmp(level.mapname, "security") == 0)
 	{
 		spot = G_Spawn();
-		spot->classname = "info_player_coop";
+		G_SetClassname(spot, "info_player_coop");
 		spot->s.origin[0] = 188 - 64;
 		spot->s.origin[1] = -164;
 		spot->s.origin[2] = 80;
-		spot->targetname = "jail3";
+		G_SetTargetname(spot, "jail3");
 		spot->s.angles[YAW] = 90;
 
 		spot = G_Spawn();
-		spot->classname = "info_player_coop";
+		G_SetClassname(spot, "info_player_coop");
 		spot->s.origin[0] = 188 + 64;
 		spot->s.origin[1] = -164;
 		spot->s.origin[2] = 80;
-		spot->targetname = "jail3";
+		G_SetTargetname(spot, "jail3");
 		spot->s.angles[YAW] = 90;
 
 		spot = G_Spawn();
-		spot->classname = "info_player_coop";
+		G_SetClassname(spot, "info_player_coop");
 		spot->s.origin[0] = 188 + 128;
 		spot->s.origin[1] = -164;
 		spot->s.origin[2] = 80;
-		spot->targetname = "jail3";
+		G_SetTargetname(spot, "jail3");
 		spot->s.angles[YAW] = 90;
 
 		return;
@@ -175,7 +175,7 @@ CreateUnnamedSpawnpoint(const edict_t *self, const char *mapname, const char *sp
 		return;
 	}
 
-	spot->classname = "info_player_start";
+	G_SetClassname(spot, "info_player_start");
 
 	VectorCopy(self->s.origin, spot->s.origin);
 	spot->s.angles[YAW] = self->s.angles[YAW];
@@ -216,14 +216,14 @@ SP_info_player_start(edict_t *self)
 
 	/* Call function to hack unnamed spawn points */
 	self->think = SP_CreateUnnamedSpawn;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	if (coop->value &&
 		Q_stricmp(level.mapname, "security") == 0)
 	{
 		/* invoke one of our gross, ugly, disgusting hacks */
 		self->think = SP_CreateCoopSpots;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 
 	/* Fix coop spawn points */
@@ -294,7 +294,7 @@ SP_info_player_coop(edict_t *self)
 	{
 		/* invoke one of our gross, ugly, disgusting hacks */
 		self->think = SP_FixCoopSpots;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -866,9 +866,9 @@ TossClientWeapon(edict_t *self)
 		drop->spawnflags |= DROPPED_PLAYER_ITEM;
 
 		drop->touch = Touch_Item;
-		drop->nextthink = level.time +
+		G_SetNextThink(drop, level.time +
 						(self->client->quad_framenum -
-						   level.framenum) * FRAMETIME;
+						   level.framenum) * FRAMETIME);
 		drop->think = G_FreeEdict;
 	}
 
@@ -880,8 +880,8 @@ TossClientWeapon(edict_t *self)
 		drop->spawnflags |= DROPPED_PLAYER_ITEM;
 
 		drop->touch = Touch_Item;
-		drop->nextthink = level.time + (self->client->quadfire_framenum -
-						   level.framenum) * FRAMETIME;
+		G_SetNextThink(drop, level.time + (self->client->quadfire_framenum -
+						   level.framenum) * FRAMETIME);
 		drop->think = G_FreeEdict;
 	}
 }
@@ -1882,7 +1882,7 @@ InitBodyQue(void)
 		for (i = 0; i < BODY_QUEUE_SIZE; i++)
 		{
 			ent = G_Spawn();
-			ent->classname = "bodyque";
+			G_SetClassname(ent, "bodyque");
 		}
 	}
 }
@@ -1949,6 +1949,8 @@ CopyToBodyQue(edict_t *ent)
 	body->die = body_die;
 	body->takedamage = DAMAGE_YES;
 
+	/* the body was asleep while it was empty */
+	G_WakeEdict(body);
 	gi.linkentity(body);
 }
 
@@ -2460,7 +2462,7 @@ PutClientInServer(edict_t *ent)
 	ent->movetype = MOVETYPE_WALK;
 	ent->viewheight = 22;
 	ent->inuse = true;
-	ent->classname = "player";
+	G_SetClassname(ent, "player");
 	ent->mass = 200;
 	ent->solid = SOLID_BBOX;
 	ent->deadflag = DEAD_NO;
@@ -2728,7 +2730,7 @@ ClientBegin(edict_t *ent)
 		   except for the persistant data that was initialized at
 		   ClientConnect() time */
 		G_InitEdict(ent);
-		ent->classname = "player";
+		G_SetClassname(ent, "player");
 		InitClientResp(ent->client);
 		PutClientInServer(ent);
 	}
@@ -3014,7 +3016,7 @@ ClientDisconnect(edict_t *ent)
 	ent->s.modelindex = 0;
 	ent->solid = SOLID_NOT;
 	ent->inuse = false;
-	ent->classname = "disconnected";
+	G_SetClassname(ent, "disconnected");
 	ent->client->pers.connected = false;
 
 	playernum = ent - g_edicts - 1;
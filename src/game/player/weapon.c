@@ -208,7 +208,7 @@ PlayerNoise_Spawn(edict_t *who, int type)
 		return NULL;
 	}
 
-	noise->classname = "player_noise";
+	G_SetClassname(noise, "player_noise");
 	noise->spawnflags = type;
 	VectorSet(noise->mins, -8, -8, -8);
 	VectorSet(noise->maxs, 8, 8, 8);
@@ -294,6 +294,9 @@ InitGame(void)
 	gamerules = gi.cvar("gamerules", "0", CVAR_LATCH);			//PGM
 	g_footsteps = gi.cvar("g_footsteps", "1", CVAR_ARCHIVE);
 	g_monsterfootsteps = gi.cvar("g_monsterfootsteps", "0", CVAR_ARCHIVE);
+	g_monster_lod = gi.cvar("g_monster_lod", "1", CVAR_ARCHIVE);
+	g_sight_validate = gi.cvar("g_sight_validate", "0", 0);
+	g_perception = gi.cvar("g_perception", "1", CVAR_ARCHIVE);
 	g_fix_triggered = gi.cvar("g_fix_triggered", "0", 0);
 	g_commanderbody_nogod = gi.cvar("g_commanderbody_nogod", "0", CVAR_ARCHIVE);
 
@@ -1269,6 +1272,7 @@ ReadLevel(const char *filename)
 	/* wipe all the entities */
 	memset(g_edicts, 0, game.maxentities * sizeof(g_edicts[0]));
 	globals.num_edicts = maxclients->value + 1;
+	G_ClearNames();
 
 	/* check edict size */
 	if (fread(&i, sizeof(i), 1, f) != 1)
@@ -1317,6 +1321,7 @@ ReadLevel(const char *filename)
 
 		ent = &g_edicts[entnum];
 		ReadEdict(f, ent);
+		G_LinkNames(ent);
 
 		/* let the server rebuild world links for this ent */
 		memset(&ent->area, 0, sizeof(ent->area));
@@ -1325,6 +1330,12 @@ ReadLevel(const char *filename)
 
 	fclose(f);
 
+	/* the free edicts are the gaps between the loaded ones */
+	G_ClearFreeEdicts();
+	G_ClearThinks();
+	M_ClearLOD();
+	AI_ClearPerception();
+
 	/* mark all clients as unconnected */
 	for (i = 0; i < maxclients->value; i++)
 	{
@@ -1348,7 +1359,7 @@ ReadLevel(const char *filename)
 		{
 			if (strcmp(ent->classname, "target_crosslevel_target") == 0)
 			{
-				ent->nextthink = level.time + ent->delay;
+				G_SetNextThink(ent, level.time + ent->delay);
 			}
 		}
 	}
@@ -0,0 +1,1263 @@
+/*
+ * Copyright (C) 1997-2001 Id Software, Inc.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+ * 02111-1307, USA.
+ *
+ * =======================================================================
+ *
+ * q2loadgen, a headless load generator for server scaling tests. It
+ * connects a number of synthetic clients to a server, sends random or
+ * scripted movement commands and measures the snapshot rate, the
+ * snapshot size and the round trip time per client. Optionally it
+ * floods the server with status queries from a second address, to
+ * check that real clients still get in. It shares the netchan and
+ * the message code with the engine, everything else is stubbed out
+ * below. Only IPv4 is supported.
+ *
+ * =======================================================================
+ */
+
+#include "../common/header/common.h"
+#include "../common/unzip/miniz/miniz.h"
+
+#include <unistd.h>
+#include <errno.h>
+#include <getopt.h>
+#include <poll.h>
+#include <time.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#define CMD_BACKUP 64 /* must be a power of two */
+#define MAX_SCRIPT_CMDS 4096
+#define RESEND_TIME 1000
+
+typedef enum
+{
+	lg_challenging,     /* waiting for a challenge */
+	lg_connecting,      /* waiting for client_connect */
+	lg_connected,       /* netchan is up, waiting for serverdata */
+	lg_active           /* begin was sent, sending moves */
+} lgstate_t;
+
+typedef struct
+{
+	int frames;         /* snapshots received */
+	int bytes;          /* bytes of all sequenced packets */
+	int maxsize;        /* biggest snapshot packet */
+	int rttsum;
+	int rttcount;
+	int rttmax;
+	int dropped;        /* packets dropped by the netchan */
+} lgstats_t;
+
+/* tails of the compressed frames, see CL_ParseZFrame() */
+typedef struct
+{
+	byte dict[UPDATE_BACKUP][ZFRAME_DICT_SIZE];
+	int dictlen[UPDATE_BACKUP];
+	int dictframe[UPDATE_BACKUP];
+} lgzdict_t;
+
+typedef struct
+{
+	int num;
+	int sock;
+	int qport;
+	lgstate_t state;
+	int lastconnect;
+
+	netchan_t netchan;
+	int protocol;
+	int spawncount;
+	int serverframe;
+	lgzdict_t *zdict;
+
+	usercmd_t cmds[CMD_BACKUP];
+	int cmd_time[CMD_BACKUP];
+	int lastack;
+	int script;
+
+	lgstats_t interval;
+	lgstats_t total;
+} lgclient_t;
+
+static lgclient_t *clients;
+static int numclients = 16;
+static int cmdrate = 30;
+static int verbose;
+static int zframe;
+
+/* the status query flood, only the socket
+   of the pseudo client is used */
+static lgclient_t flooder;
+static int floodrate;
+static int floodsent;
+static int floodanswered;
+
+static netadr_t server_adr;
+
+static usercmd_t script_cmds[MAX_SCRIPT_CMDS];
+static int script_numcmds;
+
+/* the current time, read by the netchan */
+int curtime;
+
+/* the netchan writes the global qport, it's
+   set to the current clients one before use */
+static cvar_t lg_qport = {"qport", "0"};
+static cvar_t lg_null = {"null", "0"};
+
+/* the client the netchan is sending for */
+static lgclient_t *lg_current;
+
+/* ======================================================================= */
+
+/* Stubs for the engine functions used by the shared code */
+
+void
+Com_Printf(const char *fmt, ...)
+{
+	va_list argptr;
+
+	va_start(argptr, fmt);
+	vprintf(fmt, argptr);
+	va_end(argptr);
+}
+
+void
+Com_DPrintf(const char *fmt, ...)
+{
+	va_list argptr;
+
+	if (!verbose)
+	{
+		return;
+	}
+
+	va_start(argptr, fmt);
+	vprintf(fmt, argptr);
+	va_end(argptr);
+}
+
+void
+Com_Error(int code, const char *fmt, ...)
+{
+	va_list argptr;
+
+	va_start(argptr, fmt);
+	vfprintf(stderr, fmt, argptr);
+	va_end(argptr);
+
+	exit(1);
+}
+
+void
+Sys_Error(const char *error, ...)
+{
+	va_list argptr;
+
+	va_start(argptr, error);
+	vfprintf(stderr, error, argptr);
+	va_end(argptr);
+
+	exit(1);
+}
+
+cvar_t *
+Cvar_Get(const char *var_name, const char *var_value, int flags)
+{
+	if (!strcmp(var_name, "qport"))
+	{
+		return &lg_qport;
+	}
+
+	return &lg_null;
+}
+
+char *
+NET_AdrToString(netadr_t a)
+{
+	static char s[64];
+
+	Com_sprintf(s, sizeof(s), "%i.%i.%i.%i:%i", a.ip[0], a.ip[1],
+			a.ip[2], a.ip[3], ntohs(a.port));
+
+	return s;
+}
+
+void
+NET_SendPacket(netsrc_t sock, int length, void *data, netadr_t to)
+{
+	struct sockaddr_in addr;
+
+	if (!lg_current)
+	{
+		return;
+	}
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = to.port;
+	memcpy(&addr.sin_addr, to.ip, 4);
+
+	if (sendto(lg_current->sock, data, length, 0,
+			(struct sockaddr *)&addr, sizeof(addr)) == -1)
+	{
+		Com_DPrintf("client %i: sendto: %s\n", lg_current->num,
+				strerror(errno));
+	}
+}
+
+/* ======================================================================= */
+
+static int
+LG_Milliseconds(void)
+{
+	static struct timespec base;
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	if (!base.tv_sec)
+	{
+		base = now;
+	}
+
+	return (now.tv_sec - base.tv_sec) * 1000 +
+		(now.tv_nsec - base.tv_nsec) / 1000000;
+}
+
+static qboolean
+LG_StringToAdr(const char *s, netadr_t *a)
+{
+	char copy[128];
+	char *port;
+	struct addrinfo hints, *res;
+
+	Q_strlcpy(copy, s, sizeof(copy));
+
+	port = strchr(copy, ':');
+
+	if (port)
+	{
+		*port++ = '\0';
+	}
+
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_DGRAM;
+
+	if (getaddrinfo(copy, NULL, &hints, &res))
+	{
+		return false;
+	}
+
+	memset(a, 0, sizeof(*a));
+	a->type = NA_IP;
+	memcpy(a->ip, &((struct sockaddr_in *)res->ai_addr)->sin_addr, 4);
+	a->port = htons(port ? (int)strtol(port, NULL, 10) : PORT_SERVER);
+
+	freeaddrinfo(res);
+
+	return true;
+}
+
+static void
+LG_OutOfBandPrint(lgclient_t *cl, const char *format, ...)
+{
+	char string[MAX_MSGLEN - 4];
+	va_list argptr;
+
+	va_start(argptr, format);
+	vsnprintf(string, sizeof(string), format, argptr);
+	va_end(argptr);
+
+	lg_current = cl;
+	Netchan_OutOfBand(NS_CLIENT, server_adr, strlen(string), (byte *)string);
+}
+
+static void
+LG_Transmit(lgclient_t *cl, int length, byte *data)
+{
+	lg_current = cl;
+	lg_qport.value = cl->qport;
+	Netchan_Transmit(&cl->netchan, length, data);
+}
+
+static void
+LG_StringCmd(lgclient_t *cl, const char *cmd)
+{
+	MSG_WriteByte(&cl->netchan.message, clc_stringcmd);
+	MSG_WriteString(&cl->netchan.message, cmd);
+}
+
+/* ======================================================================= */
+
+/*
+ * Loads a movement script. One command per line:
+ * msec forward side up yaw pitch buttons
+ */
+static qboolean
+LG_LoadScript(const char *name)
+{
+	char line[256];
+	usercmd_t *cmd;
+	int msec, forward, side, up, buttons;
+	float yaw, pitch;
+	FILE *f;
+
+	f = fopen(name, "r");
+
+	if (!f)
+	{
+		fprintf(stderr, "Couldn't open %s: %s\n", name, strerror(errno));
+		return false;
+	}
+
+	while (fgets(line, sizeof(line), f) && (script_numcmds < MAX_SCRIPT_CMDS))
+	{
+		if ((line[0] == '#') || (line[0] == '\n'))
+		{
+			continue;
+		}
+
+		if (sscanf(line, "%i %i %i %i %f %f %i", &msec, &forward, &side,
+				&up, &yaw, &pitch, &buttons) != 7)
+		{
+			continue;
+		}
+
+		cmd = &script_cmds[script_numcmds++];
+		cmd->msec = msec;
+		cmd->forwardmove = forward;
+		cmd->sidemove = side;
+		cmd->upmove = up;
+		cmd->angles[YAW] = ANGLE2SHORT(yaw);
+		cmd->angles[PITCH] = ANGLE2SHORT(pitch);
+		cmd->buttons = buttons;
+	}
+
+	fclose(f);
+
+	if (!script_numcmds)
+	{
+		fprintf(stderr, "%s contains no commands\n", name);
+		return false;
+	}
+
+	return true;
+}
+
+/*
+ * Fills in the next user command, either from the
+ * script or some random running around and shooting.
+ */
+static void
+LG_BuildCmd(lgclient_t *cl, usercmd_t *cmd, const usercmd_t *last, int msec)
+{
+	if (script_numcmds)
+	{
+		*cmd = script_cmds[cl->script++ % script_numcmds];
+		return;
+	}
+
+	*cmd = *last;
+	cmd->msec = msec;
+	cmd->upmove = 0;
+	cmd->buttons = 0;
+	cmd->impulse = 0;
+
+	/* change direction every now and then */
+	if ((randk() % 30) == 0)
+	{
+		cmd->forwardmove = (randk() % 3 - 1) * 400;
+		cmd->sidemove = (randk() % 3 - 1) * 400;
+	}
+
+	cmd->angles[YAW] += (short)((randk() % 2001) - 1000);
+	cmd->angles[PITCH] = ANGLE2SHORT(crandk() * 30);
+
+	if ((randk() % 50) == 0)
+	{
+		cmd->upmove = 200;
+	}
+
+	if ((randk() % 4) == 0)
+	{
+		cmd->buttons |= BUTTON_ATTACK;
+	}
+}
+
+static void
+LG_SendMove(lgclient_t *cl, int msec)
+{
+	sizebuf_t buf;
+	byte data[128];
+	usercmd_t nullcmd;
+	usercmd_t *cmd, *oldcmd;
+	int checksumIndex;
+	int i;
+
+	i = cl->netchan.outgoing_sequence & (CMD_BACKUP - 1);
+	LG_BuildCmd(cl, &cl->cmds[i],
+			&cl->cmds[(cl->netchan.outgoing_sequence - 1) & (CMD_BACKUP - 1)], msec);
+	cl->cmd_time[i] = curtime;
+
+	SZ_Init(&buf, data, sizeof(data));
+
+	MSG_WriteByte(&buf, clc_move);
+
+	checksumIndex = buf.cursize;
+	MSG_WriteByte(&buf, 0);
+
+	MSG_WriteLong(&buf, cl->serverframe);
+
+	memset(&nullcmd, 0, sizeof(nullcmd));
+	cmd = &cl->cmds[(cl->netchan.outgoing_sequence - 2) & (CMD_BACKUP - 1)];
+	MSG_WriteDeltaUsercmd(&buf, &nullcmd, cmd);
+	oldcmd = cmd;
+
+	cmd = &cl->cmds[(cl->netchan.outgoing_sequence - 1) & (CMD_BACKUP - 1)];
+	MSG_WriteDeltaUsercmd(&buf, oldcmd, cmd);
+	oldcmd = cmd;
+
+	cmd = &cl->cmds[cl->netchan.outgoing_sequence & (CMD_BACKUP - 1)];
+	MSG_WriteDeltaUsercmd(&buf, oldcmd, cmd);
+
+	buf.data[checksumIndex] = COM_BlockSequenceCRCByte(
+			buf.data + checksumIndex + 1, buf.cursize - checksumIndex - 1,
+			cl->netchan.outgoing_sequence);
+
+	LG_Transmit(cl, buf.cursize, buf.data);
+}
+
+static void
+LG_Reconnect(lgclient_t *cl)
+{
+	int i;
+
+	for (i = 0; i < CMD_BACKUP; i++)
+	{
+		cl->cmd_time[i] = -1;
+	}
+
+	cl->state = lg_connected;
+	cl->serverframe = -1;
+	LG_StringCmd(cl, "new");
+}
+
+/* ======================================================================= */
+
+static void
+LG_ParseStuffText(lgclient_t *cl, char *text)
+{
+	char *line, *next;
+	int spawncount;
+
+	for (line = text; line && *line; line = next)
+	{
+		next = strchr(line, '\n');
+
+		if (next)
+		{
+			*next++ = '\0';
+		}
+
+		Com_DPrintf("client %i: stufftext: %s\n", cl->num, line);
+
+		if (sscanf(line, "cmd configstrings %i", &spawncount) == 1)
+		{
+			/* We don't need the configstrings and baselines,
+			   go straight into the game. */
+			LG_StringCmd(cl, va("begin %i\n", spawncount));
+			cl->state = lg_active;
+		}
+		else if (!strncmp(line, "cmd ", 4))
+		{
+			LG_StringCmd(cl, line + 4);
+		}
+		else if (!strcmp(line, "reconnect"))
+		{
+			LG_Reconnect(cl);
+		}
+	}
+}
+
+/*
+ * Inflates a compressed frame far enough to get the frame
+ * number, and keeps its tail as dictionary for the next.
+ */
+static qboolean
+LG_ParseZFrame(lgclient_t *cl, sizebuf_t *msg)
+{
+	static byte data[ZFRAME_DICT_SIZE + MAX_ZFRAME_SIZE];
+	static tinfl_decompressor inflator;
+	int dictframe, size, csize, dictlen, slot, len;
+	size_t inlen, outlen;
+	sizebuf_t frame;
+	byte *in, *out;
+
+	dictframe = MSG_ReadLong(msg);
+	size = MSG_ReadLong(msg);
+	csize = MSG_ReadShort(msg);
+
+	if (!cl->zdict || (size <= 0) || (size > MAX_ZFRAME_SIZE) ||
+		(csize <= 0) || (msg->readcount + csize > msg->cursize))
+	{
+		Com_DPrintf("client %i: bad compressed frame\n", cl->num);
+		return false;
+	}
+
+	in = msg->data + msg->readcount;
+	msg->readcount += csize;
+
+	dictlen = 0;
+
+	if (dictframe > 0)
+	{
+		slot = dictframe & UPDATE_MASK;
+
+		if (cl->zdict->dictframe[slot] != dictframe)
+		{
+			Com_DPrintf("client %i: compressed frame dictionary too old\n",
+					cl->num);
+			return false;
+		}
+
+		dictlen = cl->zdict->dictlen[slot];
+		memcpy(data, cl->zdict->dict[slot], dictlen);
+	}
+
+	tinfl_init(&inflator);
+	out = data + dictlen;
+	inlen = csize;
+	outlen = sizeof(data) - dictlen;
+
+	if ((tinfl_decompress(&inflator, in, &inlen, data, out, &outlen,
+			TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF) != TINFL_STATUS_DONE) ||
+		(outlen != size) || (size < 5) || (out[0] != svc_frame))
+	{
+		Com_DPrintf("client %i: couldn't inflate compressed frame\n",
+				cl->num);
+		return false;
+	}
+
+	SZ_Init(&frame, out, size);
+	frame.cursize = size;
+	MSG_ReadByte(&frame);
+	cl->serverframe = MSG_ReadLong(&frame);
+
+	slot = cl->serverframe & UPDATE_MASK;
+	len = size < ZFRAME_DICT_SIZE ? size : ZFRAME_DICT_SIZE;
+	memcpy(cl->zdict->dict[slot], out + size - len, len);
+	cl->zdict->dictlen[slot] = len;
+	cl->zdict->dictframe[slot] = cl->serverframe;
+
+	return true;
+}
+
+/*
+ * Parses the server message up to the frame, everything
+ * behind it is entity data and unreliable multicasts which
+ * don't matter for us. Returns true if a frame was found.
+ */
+static qboolean
+LG_ParseServerMessage(lgclient_t *cl, sizebuf_t *msg)
+{
+	char *s;
+	int cmd, flags, size;
+
+	while (1)
+	{
+		if (msg->readcount > msg->cursize)
+		{
+			Com_DPrintf("client %i: bad server message\n", cl->num);
+			return false;
+		}
+
+		cmd = MSG_ReadByte(msg);
+
+		if (cmd == -1)
+		{
+			return false;
+		}
+
+		switch (cmd)
+		{
+			case svc_nop:
+				break;
+
+			case svc_disconnect:
+				Com_Printf("client %i: disconnected by server\n", cl->num);
+				cl->state = lg_challenging;
+				cl->lastconnect = -RESEND_TIME;
+				return false;
+
+			case svc_reconnect:
+				LG_Reconnect(cl);
+				break;
+
+			case svc_print:
+				MSG_ReadByte(msg);
+				s = MSG_ReadString(msg);
+				Com_DPrintf("client %i: %s", cl->num, s);
+				break;
+
+			case svc_centerprint:
+			case svc_layout:
+				MSG_ReadString(msg);
+				break;
+
+			case svc_stufftext:
+				LG_ParseStuffText(cl, MSG_ReadString(msg));
+				break;
+
+			case svc_serverdata:
+				cl->protocol = MSG_ReadLong(msg);
+				cl->spawncount = MSG_ReadLong(msg);
+				MSG_ReadByte(msg);
+				MSG_ReadString(msg);
+				MSG_ReadShort(msg);
+				MSG_ReadString(msg);
+				cl->serverframe = -1;
+				break;
+
+			case svc_configstring:
+				MSG_ReadShort(msg);
+				MSG_ReadString(msg);
+				break;
+
+			case svc_inventory:
+				msg->readcount += MAX_ITEMS * 2;
+				break;
+
+			case svc_muzzleflash:
+			case svc_muzzleflash2:
+				MSG_ReadShort(msg);
+				MSG_ReadByte(msg);
+				break;
+
+			case svc_sound:
+				flags = MSG_ReadByte(msg);
+
+				if (IS_QII97_PROTOCOL(cl->protocol))
+				{
+					MSG_ReadByte(msg);
+				}
+				else
+				{
+					MSG_ReadShort(msg);
+				}
+
+				if (flags & SND_VOLUME)
+				{
+					MSG_ReadByte(msg);
+				}
+
+				if (flags & SND_ATTENUATION)
+				{
+					MSG_ReadByte(msg);
+				}
+
+				if (flags & SND_OFFSET)
+				{
+					MSG_ReadByte(msg);
+				}
+
+				if (flags & SND_ENT)
+				{
+					MSG_ReadShort(msg);
+				}
+
+				if (flags & SND_POS)
+				{
+					vec3_t pos;
+
+					MSG_ReadPos(msg, pos, cl->protocol);
+				}
+
+				break;
+
+			case svc_download:
+				/* size, percent, the data if there is any.
+				   -1 means the download was refused. */
+				size = MSG_ReadShort(msg);
+				MSG_ReadByte(msg);
+
+				if (size > 0)
+				{
+					msg->readcount += size;
+				}
+
+				break;
+
+			case svc_frame:
+				cl->serverframe = MSG_ReadLong(msg);
+				return true;
+
+			case svc_zframe:
+				return LG_ParseZFrame(cl, msg);
+
+			default:
+				/* temp entities and such, can't skip them
+				   without parsing them completely */
+				Com_DPrintf("client %i: unhandled svc %i\n", cl->num, cmd);
+				return false;
+		}
+	}
+}
+
+static void
+LG_ConnectionlessPacket(lgclient_t *cl, sizebuf_t *msg)
+{
+	char userinfo[MAX_INFO_STRING];
+	const char *c;
+	char *s;
+
+	MSG_BeginReading(msg);
+	MSG_ReadLong(msg); /* skip the -1 */
+
+	s = MSG_ReadStringLine(msg);
+	c = COM_Parse(&s);
+
+	if (!strcmp(c, "challenge") && (cl->state == lg_challenging))
+	{
+		userinfo[0] = '\0';
+		Info_SetValueForKey(userinfo, "name", va("loadgen%i", cl->num));
+		Info_SetValueForKey(userinfo, "skin", "male/grunt");
+		Info_SetValueForKey(userinfo, "rate", "25000");
+		Info_SetValueForKey(userinfo, "msg", "1");
+		Info_SetValueForKey(userinfo, "hand", "0");
+		Info_SetValueForKey(userinfo, "fov", "90");
+
+		LG_OutOfBandPrint(cl, "connect %i %i %i \"%s\"%s fragments\n", PROTOCOL_VERSION,
+				cl->qport, (int)strtol(COM_Parse(&s), NULL, 10), userinfo,
+				zframe ? " zframe" : "");
+
+		cl->state = lg_connecting;
+		cl->lastconnect = curtime;
+	}
+	else if (!strcmp(c, "client_connect") && (cl->state == lg_connecting))
+	{
+		Netchan_Setup(NS_CLIENT, &cl->netchan, server_adr, cl->qport);
+
+		while (s)
+		{
+			if (!strcmp(COM_Parse(&s), "fragments"))
+			{
+				cl->netchan.fragments = true;
+			}
+		}
+
+		cl->lastack = 0;
+		LG_Reconnect(cl);
+	}
+	else if (!strcmp(c, "print"))
+	{
+		Com_Printf("client %i: %s", cl->num, MSG_ReadString(msg));
+	}
+}
+
+static void
+LG_ReadPackets(lgclient_t *cl)
+{
+	static byte data[MAX_MSGLEN];
+	struct sockaddr_in from;
+	socklen_t fromlen;
+	sizebuf_t msg;
+	int ret, ack, rtt;
+
+	while (1)
+	{
+		fromlen = sizeof(from);
+		ret = recvfrom(cl->sock, data, sizeof(data), MSG_DONTWAIT,
+				(struct sockaddr *)&from, &fromlen);
+
+		if (ret <= 0)
+		{
+			return;
+		}
+
+		SZ_Init(&msg, data, sizeof(data));
+		msg.cursize = ret;
+
+		if (*(int *)data == -1)
+		{
+			LG_ConnectionlessPacket(cl, &msg);
+			continue;
+		}
+
+		if (cl->state < lg_connected)
+		{
+			continue;
+		}
+
+		lg_current = cl;
+
+		if (!Netchan_Process(&cl->netchan, &msg))
+		{
+			continue;
+		}
+
+		cl->interval.bytes += msg.cursize;
+		cl->interval.dropped += cl->netchan.dropped;
+
+		/* round trip time of the last acknowledged move */
+		ack = cl->netchan.incoming_acknowledged;
+
+		if ((ack > cl->lastack) &&
+			(cl->netchan.outgoing_sequence - ack < CMD_BACKUP) &&
+			(cl->cmd_time[ack & (CMD_BACKUP - 1)] >= 0))
+		{
+			rtt = curtime - cl->cmd_time[ack & (CMD_BACKUP - 1)];
+			cl->lastack = ack;
+
+			cl->interval.rttsum += rtt;
+			cl->interval.rttcount++;
+
+			if (rtt > cl->interval.rttmax)
+			{
+				cl->interval.rttmax = rtt;
+			}
+		}
+
+		if (LG_ParseServerMessage(cl, &msg))
+		{
+			cl->interval.frames++;
+
+			if (msg.cursize > cl->interval.maxsize)
+			{
+				cl->interval.maxsize = msg.cursize;
+			}
+		}
+	}
+}
+
+static void
+LG_SendCommands(lgclient_t *cl, int msec)
+{
+	switch (cl->state)
+	{
+		case lg_challenging:
+			if (curtime - cl->lastconnect >= RESEND_TIME)
+			{
+				cl->lastconnect = curtime;
+				LG_OutOfBandPrint(cl, "getchallenge\n");
+			}
+
+			break;
+
+		case lg_connecting:
+			if (curtime - cl->lastconnect >= RESEND_TIME)
+			{
+				/* start over */
+				cl->state = lg_challenging;
+				cl->lastconnect = -RESEND_TIME;
+			}
+
+			break;
+
+		case lg_connected:
+			if (cl->netchan.message.cursize ||
+				(curtime - cl->netchan.last_sent > RESEND_TIME))
+			{
+				LG_Transmit(cl, 0, NULL);
+			}
+
+			break;
+
+		case lg_active:
+			LG_SendMove(cl, msec);
+			break;
+	}
+}
+
+/* ======================================================================= */
+
+static void
+LG_AddStats(lgstats_t *to, const lgstats_t *from)
+{
+	to->frames += from->frames;
+	to->bytes += from->bytes;
+	to->rttsum += from->rttsum;
+	to->rttcount += from->rttcount;
+	to->dropped += from->dropped;
+
+	if (from->maxsize > to->maxsize)
+	{
+		to->maxsize = from->maxsize;
+	}
+
+	if (from->rttmax > to->rttmax)
+	{
+		to->rttmax = from->rttmax;
+	}
+}
+
+static void
+LG_PrintStats(const char *label, const lgstats_t *s, int active, float seconds)
+{
+	printf("%-10s %6i %8.1f %8.0f %8i %7.1f %7i %7i\n", label, active,
+			active ? s->frames / seconds / active : 0,
+			s->frames ? (float)s->bytes / s->frames : 0,
+			s->maxsize,
+			s->rttcount ? (float)s->rttsum / s->rttcount : 0,
+			s->rttmax, s->dropped);
+}
+
+static void
+LG_PrintHeader(const char *label)
+{
+	printf("%-10s %6s %8s %8s %8s %7s %7s %7s\n", label, "active",
+			"snap/s", "avgsize", "maxsize", "rtt", "maxrtt", "drops");
+}
+
+static void
+LG_Report(float seconds)
+{
+	lgstats_t sum;
+	int i, active;
+
+	memset(&sum, 0, sizeof(sum));
+	active = 0;
+
+	if (verbose)
+	{
+		LG_PrintHeader("client");
+	}
+
+	for (i = 0; i < numclients; i++)
+	{
+		if (clients[i].state == lg_active)
+		{
+			active++;
+		}
+
+		if (verbose)
+		{
+			LG_PrintStats(va("%i", i), &clients[i].interval,
+					clients[i].state == lg_active, seconds);
+		}
+
+		LG_AddStats(&sum, &clients[i].interval);
+		LG_AddStats(&clients[i].total, &clients[i].interval);
+		memset(&clients[i].interval, 0, sizeof(lgstats_t));
+	}
+
+	if (!verbose)
+	{
+		LG_PrintHeader("");
+	}
+
+	LG_PrintStats("all", &sum, active, seconds);
+	fflush(stdout);
+}
+
+static qboolean
+LG_OpenFlood(const char *source)
+{
+	struct sockaddr_in addr;
+
+	flooder.num = -1;
+	flooder.sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+	if (flooder.sock == -1)
+	{
+		fprintf(stderr, "socket: %s\n", strerror(errno));
+		return false;
+	}
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+
+	if (source && (inet_pton(AF_INET, source, &addr.sin_addr) != 1))
+	{
+		fprintf(stderr, "Bad flood source address %s\n", source);
+		return false;
+	}
+
+	if (bind(flooder.sock, (struct sockaddr *)&addr, sizeof(addr)) == -1)
+	{
+		fprintf(stderr, "bind: %s\n", strerror(errno));
+		return false;
+	}
+
+	return true;
+}
+
+/*
+ * Sends the status queries due since the start
+ */
+static void
+LG_Flood(int elapsed)
+{
+	int due;
+
+	due = (int)((long long)elapsed * floodrate / 1000) - floodsent;
+
+	while (due-- > 0)
+	{
+		LG_OutOfBandPrint(&flooder, "status\n");
+		floodsent++;
+	}
+}
+
+static void
+LG_ReadFlood(void)
+{
+	byte buf[MAX_MSGLEN];
+
+	while (recv(flooder.sock, buf, sizeof(buf), MSG_DONTWAIT) > 0)
+	{
+		floodanswered++;
+	}
+}
+
+static void
+LG_Usage(const char *name)
+{
+	printf("Usage: %s [options] [server[:port]]\n", name);
+	printf("  -n <clients>   number of clients, default 16\n");
+	printf("  -r <rate>      move commands per second, default 30\n");
+	printf("  -i <seconds>   report interval, default 5\n");
+	printf("  -t <seconds>   run time, default forever\n");
+	printf("  -s <file>      replay a movement script instead of random moves,\n");
+	printf("                 one 'msec forward side up yaw pitch buttons' per line\n");
+	printf("  -f <rate>      flood the server with status queries per second\n");
+	printf("  -b <address>   source address of the flood, like 127.0.0.2\n");
+	printf("  -z             ask for compressed frames\n");
+	printf("  -v             verbose, per client stats\n");
+}
+
+int
+main(int argc, char **argv)
+{
+	struct sockaddr_in addr;
+	int interval = 5;
+	int runtime = 0;
+	int lastreport, lastcmd, start;
+	int i, c, msec;
+	struct pollfd *fds;
+	byte final[32];
+	char *floodsource = NULL;
+
+	while ((c = getopt(argc, argv, "n:r:i:t:s:f:b:zvh")) != -1)
+	{
+		switch (c)
+		{
+			case 'n':
+				numclients = (int)strtol(optarg, NULL, 10);
+				break;
+			case 'r':
+				cmdrate = (int)strtol(optarg, NULL, 10);
+				break;
+			case 'i':
+				interval = (int)strtol(optarg, NULL, 10);
+				break;
+			case 't':
+				runtime = (int)strtol(optarg, NULL, 10);
+				break;
+			case 's':
+				if (!LG_LoadScript(optarg))
+				{
+					return 1;
+				}
+				break;
+			case 'f':
+				floodrate = (int)strtol(optarg, NULL, 10);
+				break;
+			case 'b':
+				floodsource = optarg;
+				break;
+			case 'z':
+				zframe = 1;
+				break;
+			case 'v':
+				verbose = 1;
+				break;
+			default:
+				LG_Usage(argv[0]);
+				return 1;
+		}
+	}
+
+	if ((numclients < 1) || (cmdrate < 1) || (cmdrate > 1000) || (interval < 1) ||
+		(floodrate < 0))
+	{
+		LG_Usage(argv[0]);
+		return 1;
+	}
+
+	if (!LG_StringToAdr((optind < argc) ? argv[optind] : "127.0.0.1", &server_adr))
+	{
+		fprintf(stderr, "Couldn't resolve %s\n", argv[optind]);
+		return 1;
+	}
+
+	randk_seed();
+	Netchan_Init();
+
+	clients = calloc(numclients, sizeof(lgclient_t));
+	fds = calloc(numclients + 1, sizeof(struct pollfd));
+
+	if (!clients || !fds)
+	{
+		fprintf(stderr, "Couldn't allocate %i clients\n", numclients);
+		return 1;
+	}
+
+	for (i = 0; i < numclients; i++)
+	{
+		clients[i].num = i;
+		clients[i].qport = (randk() & 0x7fff) ^ i;
+		clients[i].state = lg_challenging;
+		clients[i].lastconnect = -RESEND_TIME;
+		clients[i].serverframe = -1;
+		clients[i].script = i * 7;
+
+		if (zframe)
+		{
+			clients[i].zdict = calloc(1, sizeof(lgzdict_t));
+
+			if (!clients[i].zdict)
+			{
+				fprintf(stderr, "Couldn't allocate %i clients\n", numclients);
+				return 1;
+			}
+		}
+
+		clients[i].sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+		if (clients[i].sock == -1)
+		{
+			fprintf(stderr, "socket: %s\n", strerror(errno));
+			return 1;
+		}
+
+		memset(&addr, 0, sizeof(addr));
+		addr.sin_family = AF_INET;
+
+		if (bind(clients[i].sock, (struct sockaddr *)&addr, sizeof(addr)) == -1)
+		{
+			fprintf(stderr, "bind: %s\n", strerror(errno));
+			return 1;
+		}
+
+		fds[i].fd = clients[i].sock;
+		fds[i].events = POLLIN;
+	}
+
+	if (floodrate)
+	{
+		if (!LG_OpenFlood(floodsource))
+		{
+			return 1;
+		}
+
+		fds[numclients].fd = flooder.sock;
+		fds[numclients].events = POLLIN;
+	}
+
+	printf("Connecting %i clients to %s\n", numclients,
+			NET_AdrToString(server_adr));
+
+	msec = 1000 / cmdrate;
+	start = lastreport = lastcmd = curtime = LG_Milliseconds();
+
+	while (!runtime || (curtime - start < runtime * 1000))
+	{
+		poll(fds, numclients + (floodrate ? 1 : 0),
+				msec - (curtime - lastcmd) > 0 ?
+				msec - (curtime - lastcmd) : 0);
+
+		curtime = LG_Milliseconds();
+
+		for (i = 0; i < numclients; i++)
+		{
+			if (fds[i].revents & POLLIN)
+			{
+				LG_ReadPackets(&clients[i]);
+			}
+		}
+
+		if (floodrate)
+		{
+			if (fds[numclients].revents & POLLIN)
+			{
+				LG_ReadFlood();
+			}
+
+			LG_Flood(curtime - start);
+		}
+
+		if (curtime - lastcmd >= msec)
+		{
+			lastcmd = curtime;
+
+			for (i = 0; i < numclients; i++)
+			{
+				LG_SendCommands(&clients[i], msec);
+			}
+		}
+
+		if (curtime - lastreport >= interval * 1000)
+		{
+			LG_Report((curtime - lastreport) / 1000.0f);
+			lastreport = curtime;
+		}
+	}
+
+	/* totals over the whole run */
+	LG_Report((curtime - lastreport) / 1000.0f);
+
+	final[0] = clc_stringcmd;
+	Q_strlcpy((char *)final + 1, "disconnect", sizeof(final) - 1);
+
+	printf("\nTotal over %i seconds:\n", (curtime - start) / 1000);
+	LG_PrintHeader("client");
+
+	for (i = 0; i < numclients; i++)
+	{
+		LG_PrintStats(va("%i", i), &clients[i].total, 1,
+				(curtime - start) / 1000.0f);
+
+		/* disconnect, several times in case one gets lost */
+		if (clients[i].state >= lg_connected)
+		{
+			LG_Transmit(&clients[i], strlen((char *)final), final);
+			LG_Transmit(&clients[i], strlen((char *)final), final);
+			LG_Transmit(&clients[i], strlen((char *)final), final);
+		}
+
+		close(clients[i].sock);
+	}
+
+	if (floodrate)
+	{
+		printf("\nFlood: %i status queries sent, %i answered\n",
+				floodsent, floodanswered);
+		close(flooder.sock);
+	}
+
+	free(fds);
+	free(clients);
+
+	return 0;
+}
@@ -0,0 +1,1633 @@
+/*
+ * Copyright (C) 1997-2001 Id Software, Inc.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+ * 02111-1307, USA.
+ *
+ * =======================================================================
+ *
+ * q2relay, a spectator relay. It subscribes to the multiview stream of
+ * a server (see sv_relay.c) and looks like a normal server to its
+ * viewers. Each viewer follows one player, +attack switches to the next
+ * one, 'cmd follow <num>' picks one. The frame for a followed player is
+ * built once per server frame and sent to all viewers following them,
+ * the server doesn't know about the viewers at all. Viewers get no PVS
+ * culling and no rate limiting, the relay is meant to run close to
+ * them. It shares the netchan and the message code with the engine,
+ * everything else is stubbed out below. Only IPv4 is supported.
+ *
+ * =======================================================================
+ */
+
+#include "../common/header/common.h"
+
+#include <unistd.h>
+#include <errno.h>
+#include <getopt.h>
+#include <poll.h>
+#include <time.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#define PORT_RELAY 27920
+#define RESEND_TIME 1000
+#define KEEPALIVE_TIME 2000
+#define SERVER_TIMEOUT 10000
+#define VIEWER_TIMEOUT 30000
+
+/* configstrings per message to a viewer, about
+   the server's margin for the reliable message */
+#define VIEWER_CHUNK (MAX_MSGLEN - 1024)
+
+/* the playernum the viewers get, its entity is never sent */
+#define VIEWER_PLAYERNUM (MAX_CLIENTS - 1)
+
+typedef struct
+{
+	int spawncount;     /* 0 if not complete */
+	int version;        /* configstrings version of the server */
+	int protocol;
+	char gamedir[MAX_QPATH];
+	char levelname[256];
+
+	/* by their index in the protocol */
+	char *configstrings[MAX_CONFIGSTRINGS];
+} rgamestate_t;
+
+typedef enum
+{
+	rv_free,
+	rv_connected,       /* getting the gamestate */
+	rv_active           /* spawned, getting frames */
+} rvstate_t;
+
+typedef struct
+{
+	rvstate_t state;
+	char name[32];
+	netadr_t adr;
+	int qport;
+	netchan_t netchan;
+	int lastmessage;
+
+	int follow;         /* playernum, -1 for the first one */
+	int buttons;
+} rviewer_t;
+
+/* a record of the last frame */
+typedef struct
+{
+	int num;
+	byte *data;
+	int len;
+} rrecord_t;
+
+typedef struct
+{
+	int framesin;
+	int bytesin;
+	int framesout;
+	int bytesout;
+} rstats_t;
+
+static netadr_t server_adr;
+static char *password = "";
+static int verbose;
+
+static int upstream;        /* socket to the server */
+static int downstream;      /* socket of the viewers */
+
+static int lastkeepalive;
+static int lastserver;      /* last packet from the server */
+static qboolean subscribed;
+
+static rgamestate_t current;    /* served to the viewers */
+static rgamestate_t pending;    /* being fetched */
+static int fetch_part = -1;     /* -1 if not fetching */
+static int fetch_start;
+static int fetch_time;
+
+static rviewer_t *viewers;
+static int maxviewers = 256;
+static int challenge_secret;
+
+/* the frame being put together from its parts and the
+   last complete one, the records point into the latter */
+static byte frame_bufs[2][MAX_RELAY_FRAME];
+static byte *frame_parts = frame_bufs[0];
+static byte *frame_data = frame_bufs[1];
+static int frame_partsnum = -1;  /* -1 after a lost part */
+static int frame_partslen;
+
+static int frame_num;
+static rrecord_t frame_players[MAX_CLIENTS];
+static int frame_numplayers;
+static rrecord_t *frame_entities;  /* grows, the server may have more than MAX_EDICTS */
+static int frame_maxentities;
+static int frame_numentities;
+static byte *frame_multicast;
+static int frame_multicastlen;
+
+/* the frames per followed player, built on demand */
+static byte *pov_data[MAX_CLIENTS];
+static int pov_len[MAX_CLIENTS];
+static int pov_frame[MAX_CLIENTS];
+static int pov_overflowed;  /* spawncount of the last warning */
+
+static rstats_t stats;
+
+/* the current time, read by the netchan */
+int curtime;
+
+static cvar_t r_qport = {"qport", "0"};
+static cvar_t r_null = {"null", "0"};
+
+/* ======================================================================= */
+
+/* Stubs for the engine functions used by the shared code */
+
+void
+Com_Printf(const char *fmt, ...)
+{
+	va_list argptr;
+
+	va_start(argptr, fmt);
+	vprintf(fmt, argptr);
+	va_end(argptr);
+}
+
+void
+Com_DPrintf(const char *fmt, ...)
+{
+	va_list argptr;
+
+	if (!verbose)
+	{
+		return;
+	}
+
+	va_start(argptr, fmt);
+	vprintf(fmt, argptr);
+	va_end(argptr);
+}
+
+void
+Com_Error(int code, const char *fmt, ...)
+{
+	va_list argptr;
+
+	va_start(argptr, fmt);
+	vfprintf(stderr, fmt, argptr);
+	va_end(argptr);
+
+	exit(1);
+}
+
+void
+Sys_Error(const char *error, ...)
+{
+	va_list argptr;
+
+	va_start(argptr, error);
+	vfprintf(stderr, error, argptr);
+	va_end(argptr);
+
+	exit(1);
+}
+
+cvar_t *
+Cvar_Get(const char *var_name, const char *var_value, int flags)
+{
+	if (!strcmp(var_name, "qport"))
+	{
+		return &r_qport;
+	}
+
+	return &r_null;
+}
+
+char *
+NET_AdrToString(netadr_t a)
+{
+	static char s[64];
+
+	Com_sprintf(s, sizeof(s), "%i.%i.%i.%i:%i", a.ip[0], a.ip[1],
+			a.ip[2], a.ip[3], ntohs(a.port));
+
+	return s;
+}
+
+/*
+ * NS_CLIENT is the connection to the
+ * server, NS_SERVER the one to the viewers
+ */
+void
+NET_SendPacket(netsrc_t sock, int length, void *data, netadr_t to)
+{
+	struct sockaddr_in addr;
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = to.port;
+	memcpy(&addr.sin_addr, to.ip, 4);
+
+	if (sock == NS_SERVER)
+	{
+		stats.bytesout += length;
+	}
+
+	if (sendto((sock == NS_SERVER) ? downstream : upstream, data, length, 0,
+			(struct sockaddr *)&addr, sizeof(addr)) == -1)
+	{
+		Com_DPrintf("sendto %s: %s\n", NET_AdrToString(to), strerror(errno));
+	}
+}
+
+/* ======================================================================= */
+
+static int
+R_Milliseconds(void)
+{
+	static struct timespec base;
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	if (!base.tv_sec)
+	{
+		base = now;
+	}
+
+	return (now.tv_sec - base.tv_sec) * 1000 +
+		(now.tv_nsec - base.tv_nsec) / 1000000;
+}
+
+static qboolean
+R_StringToAdr(const char *s, netadr_t *a)
+{
+	char copy[128];
+	char *port;
+	struct addrinfo hints, *res;
+
+	Q_strlcpy(copy, s, sizeof(copy));
+
+	port = strchr(copy, ':');
+
+	if (port)
+	{
+		*port++ = '\0';
+	}
+
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_DGRAM;
+
+	if (getaddrinfo(copy, NULL, &hints, &res))
+	{
+		return false;
+	}
+
+	memset(a, 0, sizeof(*a));
+	a->type = NA_IP;
+	memcpy(a->ip, &((struct sockaddr_in *)res->ai_addr)->sin_addr, 4);
+	a->port = htons(port ? (int)strtol(port, NULL, 10) : PORT_SERVER);
+
+	freeaddrinfo(res);
+
+	return true;
+}
+
+static qboolean
+R_CompareAdr(netadr_t a, netadr_t b)
+{
+	return !memcmp(a.ip, b.ip, 4) && (a.port == b.port);
+}
+
+static void
+R_OutOfBandPrint(netsrc_t sock, netadr_t adr, const char *format, ...)
+{
+	char string[MAX_MSGLEN - 4];
+	va_list argptr;
+
+	va_start(argptr, format);
+	vsnprintf(string, sizeof(string), format, argptr);
+	va_end(argptr);
+
+	Netchan_OutOfBand(sock, adr, strlen(string), (byte *)string);
+}
+
+static int
+R_Challenge(netadr_t adr)
+{
+	unsigned hash;
+	int i;
+
+	hash = challenge_secret;
+
+	for (i = 0; i < 4; i++)
+	{
+		hash = hash * 31 + adr.ip[i];
+	}
+
+	return hash & 0x7fffffff;
+}
+
+/* ======================================================================= */
+
+static void
+R_FreeGamestate(rgamestate_t *gs)
+{
+	int i;
+
+	for (i = 0; i < MAX_CONFIGSTRINGS; i++)
+	{
+		free(gs->configstrings[i]);
+	}
+
+	memset(gs, 0, sizeof(*gs));
+}
+
+static void
+R_ViewerPrint(rviewer_t *v, const char *s)
+{
+	MSG_WriteByte(&v->netchan.message, svc_print);
+	MSG_WriteByte(&v->netchan.message, PRINT_HIGH);
+	MSG_WriteString(&v->netchan.message, s);
+}
+
+static void
+R_ViewerStuff(rviewer_t *v, const char *s)
+{
+	MSG_WriteByte(&v->netchan.message, svc_stufftext);
+	MSG_WriteString(&v->netchan.message, s);
+}
+
+static void
+R_StuffAll(const char *s)
+{
+	int i;
+
+	for (i = 0; i < maxviewers; i++)
+	{
+		if (viewers[i].state != rv_free)
+		{
+			R_ViewerStuff(&viewers[i], s);
+		}
+	}
+}
+
+static void
+R_StartFetch(void)
+{
+	R_FreeGamestate(&pending);
+
+	fetch_part = 0;
+	fetch_start = 0;
+	fetch_time = -RESEND_TIME;
+}
+
+static void
+R_RequestSignon(void)
+{
+	if ((fetch_part < 0) || (curtime - fetch_time < RESEND_TIME))
+	{
+		return;
+	}
+
+	fetch_time = curtime;
+	R_OutOfBandPrint(NS_CLIENT, server_adr, "relaysignon %i %i\n",
+			fetch_part, fetch_start);
+}
+
+/*
+ * Sends the configstrings that changed to the spawned viewers,
+ * the ones still connecting get them with the gamestate.
+ */
+static void
+R_UpdateConfigstrings(void)
+{
+	rviewer_t *v;
+	const char *old, *new;
+	int i, j;
+
+	for (i = 0; i < MAX_CONFIGSTRINGS; i++)
+	{
+		old = current.configstrings[i] ? current.configstrings[i] : "";
+		new = pending.configstrings[i] ? pending.configstrings[i] : "";
+
+		if (!strcmp(old, new))
+		{
+			continue;
+		}
+
+		for (j = 0, v = viewers; j < maxviewers; j++, v++)
+		{
+			if (v->state != rv_active)
+			{
+				continue;
+			}
+
+			if (v->netchan.message.cursize + strlen(new) + 4 >
+				v->netchan.message.maxsize)
+			{
+				/* way behind, let it start over */
+				v->state = rv_connected;
+				SZ_Clear(&v->netchan.message);
+				R_ViewerStuff(v, "reconnect\n");
+				continue;
+			}
+
+			MSG_WriteByte(&v->netchan.message, svc_configstring);
+			MSG_WriteConfigString(&v->netchan.message, i, new);
+		}
+	}
+}
+
+static void
+R_GamestateComplete(void)
+{
+	rgamestate_t old;
+	int i;
+
+	fetch_part = -1;
+
+	if (pending.spawncount == current.spawncount)
+	{
+		R_UpdateConfigstrings();
+	}
+	else
+	{
+		Com_Printf("Got the gamestate of %s\n", pending.levelname);
+
+		for (i = 0; i < maxviewers; i++)
+		{
+			if (viewers[i].state == rv_active)
+			{
+				viewers[i].state = rv_connected;
+			}
+		}
+
+		R_StuffAll("reconnect\n");
+	}
+
+	old = current;
+	current = pending;
+	memset(&pending, 0, sizeof(pending));
+	R_FreeGamestate(&old);
+}
+
+static qboolean
+R_ParseConfigstrings(sizebuf_t *msg)
+{
+	int index;
+	char *s;
+
+	while (msg->readcount < msg->cursize)
+	{
+		if (MSG_ReadByte(msg) != svc_configstring)
+		{
+			return false;
+		}
+
+		index = MSG_ReadShort(msg);
+		s = MSG_ReadString(msg);
+
+		if ((index < 0) || (index >= MAX_CONFIGSTRINGS))
+		{
+			return false;
+		}
+
+		free(pending.configstrings[index]);
+		pending.configstrings[index] = strdup(s);
+	}
+
+	return msg->readcount == msg->cursize;
+}
+
+static void
+R_ParseSignon(sizebuf_t *msg)
+{
+	int spawncount, version, part, start, next, total;
+
+	spawncount = MSG_ReadLong(msg);
+	version = MSG_ReadLong(msg);
+	part = MSG_ReadByte(msg);
+	start = MSG_ReadLong(msg);
+	next = MSG_ReadLong(msg);
+	total = MSG_ReadLong(msg);
+
+	if ((part != fetch_part) || (start != fetch_start))
+	{
+		return; /* a late duplicate */
+	}
+
+	if (part == 0)
+	{
+		pending.spawncount = spawncount;
+		pending.version = version;
+		pending.protocol = MSG_ReadLong(msg);
+		Q_strlcpy(pending.gamedir, MSG_ReadString(msg),
+				sizeof(pending.gamedir));
+		Q_strlcpy(pending.levelname, MSG_ReadString(msg),
+				sizeof(pending.levelname));
+	}
+	else if (spawncount != pending.spawncount)
+	{
+		/* the map changed while fetching */
+		R_StartFetch();
+		return;
+	}
+	else if ((next <= start) && (next < total))
+	{
+		Com_Printf("Gamestate item too big, giving up\n");
+		fetch_part = -1;
+		return;
+	}
+	else if (!R_ParseConfigstrings(msg))
+	{
+		Com_Printf("Bad gamestate chunk, starting over\n");
+		R_StartFetch();
+		return;
+	}
+
+	if (next >= total)
+	{
+		fetch_part++;
+		fetch_start = 0;
+	}
+	else
+	{
+		fetch_start = next;
+	}
+
+	if (fetch_part > 1)
+	{
+		R_GamestateComplete();
+		return;
+	}
+
+	/* request the next one right away */
+	fetch_time = -RESEND_TIME;
+	R_RequestSignon();
+}
+
+/* ======================================================================= */
+
+/*
+ * Returns the index of the player in the last frame, or -1
+ */
+static int
+R_FindPlayer(int playernum)
+{
+	int i;
+
+	for (i = 0; i < frame_numplayers; i++)
+	{
+		if (frame_players[i].num == playernum)
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/*
+ * Builds the viewer frame for the followed player once
+ * per server frame. Everything besides the playerstate
+ * and the followed players own entity is the same.
+ */
+static qboolean
+R_BuildPOV(int player)
+{
+	static byte areabits[MAX_MAP_AREAS / 8];
+	sizebuf_t msg;
+	int num, i;
+
+	num = frame_players[player].num;
+
+	if (pov_frame[num] == frame_num)
+	{
+		return pov_len[num] > 0;
+	}
+
+	if (!pov_data[num])
+	{
+		pov_data[num] = malloc(MAX_MSGLEN);
+
+		if (!pov_data[num])
+		{
+			Com_Error(ERR_FATAL, "Couldn't allocate a frame\n");
+		}
+	}
+
+	SZ_Init(&msg, pov_data[num], MAX_MSGLEN);
+	msg.allowoverflow = true;
+
+	MSG_WriteByte(&msg, svc_frame);
+	MSG_WriteLong(&msg, frame_num);
+	MSG_WriteLong(&msg, -1); /* no delta */
+	MSG_WriteByte(&msg, 0);
+
+	/* no area culling */
+	memset(areabits, 0xff, sizeof(areabits));
+	MSG_WriteByte(&msg, sizeof(areabits));
+	SZ_Write(&msg, areabits, sizeof(areabits));
+
+	SZ_Write(&msg, frame_players[player].data, frame_players[player].len);
+
+	MSG_WriteByte(&msg, svc_packetentities);
+
+	for (i = 0; i < frame_numentities; i++)
+	{
+		if (frame_entities[i].num != num + 1)
+		{
+			SZ_Write(&msg, frame_entities[i].data, frame_entities[i].len);
+		}
+	}
+
+	MSG_WriteShort(&msg, 0); /* end of packetentities */
+
+	SZ_Write(&msg, frame_multicast, frame_multicastlen);
+
+	pov_frame[num] = frame_num;
+	pov_len[num] = msg.overflowed ? 0 : msg.cursize;
+
+	/* a viewer can't take more than a message */
+	if (msg.overflowed && (pov_overflowed != current.spawncount))
+	{
+		Com_Printf("WARNING: frame for player %i overflowed, not sent.\n",
+				num);
+		pov_overflowed = current.spawncount;
+	}
+
+	return pov_len[num] > 0;
+}
+
+static void
+R_SendFrames(void)
+{
+	rviewer_t *v;
+	int i, player;
+
+	for (i = 0, v = viewers; i < maxviewers; i++, v++)
+	{
+		if ((v->state != rv_active) || !frame_numplayers)
+		{
+			continue;
+		}
+
+		player = (v->follow >= 0) ? R_FindPlayer(v->follow) : -1;
+
+		if (player < 0)
+		{
+			/* gone or not chosen yet */
+			player = 0;
+			v->follow = frame_players[0].num;
+		}
+
+		if (R_BuildPOV(player))
+		{
+			Netchan_Transmit(&v->netchan, pov_len[v->follow],
+					pov_data[v->follow]);
+			stats.framesout++;
+		}
+	}
+}
+
+static qboolean
+R_ReadRecord(sizebuf_t *msg, rrecord_t *r, int num)
+{
+	r->num = num;
+	r->len = MSG_ReadShort(msg);
+	r->data = msg->data + msg->readcount;
+	msg->readcount += r->len;
+
+	return (r->len >= 0) && (msg->readcount <= msg->cursize);
+}
+
+static void
+R_ParseFrame(sizebuf_t *msg)
+{
+	rrecord_t *records;
+	int i;
+
+	frame_num = MSG_ReadLong(msg);
+	frame_numplayers = MSG_ReadShort(msg);
+
+	if ((frame_numplayers < 0) || (frame_numplayers > MAX_CLIENTS))
+	{
+		frame_numplayers = 0;
+		return;
+	}
+
+	for (i = 0; i < frame_numplayers; i++)
+	{
+		if (!R_ReadRecord(msg, &frame_players[i], MSG_ReadByte(msg)))
+		{
+			frame_numplayers = 0;
+			return;
+		}
+	}
+
+	frame_numentities = MSG_ReadShort(msg);
+
+	if (frame_numentities < 0)
+	{
+		frame_numplayers = 0;
+		return;
+	}
+
+	if (frame_numentities > frame_maxentities)
+	{
+		records = realloc(frame_entities,
+				frame_numentities * sizeof(rrecord_t));
+
+		if (!records)
+		{
+			Com_Error(ERR_FATAL, "Couldn't allocate the entities\n");
+		}
+
+		frame_entities = records;
+		frame_maxentities = frame_numentities;
+	}
+
+	for (i = 0; i < frame_numentities; i++)
+	{
+		if (!R_ReadRecord(msg, &frame_entities[i], MSG_ReadShort(msg)))
+		{
+			frame_numplayers = 0;
+			return;
+		}
+	}
+
+	frame_multicastlen = MSG_ReadShort(msg);
+	frame_multicast = msg->data + msg->readcount;
+
+	if ((frame_multicastlen < 0) ||
+		(msg->readcount + frame_multicastlen > msg->cursize))
+	{
+		frame_numplayers = 0;
+		return;
+	}
+
+	stats.framesin++;
+
+	R_SendFrames();
+}
+
+/*
+ * Puts the parts of a frame together, they must come
+ * in order. The frame is parsed with the last part.
+ */
+static void
+R_ParseFramePart(sizebuf_t *msg)
+{
+	int spawncount, version, num, offset, total, len;
+	sizebuf_t frame;
+	byte *swap;
+
+	spawncount = MSG_ReadLong(msg);
+	version = MSG_ReadLong(msg);
+
+	if (spawncount != current.spawncount)
+	{
+		/* a new map, or we just started */
+		if (fetch_part < 0)
+		{
+			if (current.spawncount)
+			{
+				R_StuffAll("changing\n");
+			}
+
+			R_StartFetch();
+		}
+
+		return;
+	}
+
+	if ((version != current.version) && (fetch_part < 0))
+	{
+		R_StartFetch();
+	}
+
+	num = MSG_ReadLong(msg);
+	offset = MSG_ReadLong(msg);
+	total = MSG_ReadLong(msg);
+	len = msg->cursize - msg->readcount;
+
+	if (offset == 0)
+	{
+		frame_partsnum = num;
+		frame_partslen = 0;
+	}
+
+	if ((num != frame_partsnum) || (offset != frame_partslen) ||
+		(len < 0) || (total > MAX_RELAY_FRAME) || (offset + len > total))
+	{
+		/* lost or out of order, wait for the next frame */
+		frame_partsnum = -1;
+		return;
+	}
+
+	memcpy(frame_parts + offset, msg->data + msg->readcount, len);
+	frame_partslen += len;
+
+	if (frame_partslen < total)
+	{
+		return;
+	}
+
+	frame_partsnum = -1;
+
+	swap = frame_data;
+	frame_data = frame_parts;
+	frame_parts = swap;
+
+	SZ_Init(&frame, frame_data, total);
+	frame.cursize = total;
+
+	R_ParseFrame(&frame);
+}
+
+static void
+R_ServerPacket(sizebuf_t *msg)
+{
+	const char *c;
+	char *s;
+
+	if (*(int *)msg->data != -1)
+	{
+		return;
+	}
+
+	MSG_BeginReading(msg);
+	MSG_ReadLong(msg); /* skip the -1 */
+
+	s = MSG_ReadStringLine(msg);
+	c = COM_Parse(&s);
+
+	lastserver = curtime;
+
+	if (!strcmp(c, "relayframe"))
+	{
+		R_ParseFramePart(msg);
+	}
+	else if (!strcmp(c, "relaysignon"))
+	{
+		R_ParseSignon(msg);
+	}
+	else if (!strcmp(c, "relay_ok"))
+	{
+		if (!subscribed)
+		{
+			Com_Printf("Subscribed to %s\n", NET_AdrToString(server_adr));
+			subscribed = true;
+		}
+	}
+	else if (!strcmp(c, "print"))
+	{
+		Com_Printf("%s: %s", NET_AdrToString(server_adr),
+				MSG_ReadString(msg));
+	}
+}
+
+/* ======================================================================= */
+
+static void
+R_DropViewer(rviewer_t *v, const char *reason)
+{
+	byte final[1];
+
+	Com_Printf("%s %s\n", v->name, reason);
+
+	/* a few times, in case one gets lost */
+	final[0] = svc_disconnect;
+	Netchan_Transmit(&v->netchan, 1, final);
+	Netchan_Transmit(&v->netchan, 1, final);
+
+	v->state = rv_free;
+}
+
+static void
+R_SendServerdata(rviewer_t *v)
+{
+	if (!current.spawncount)
+	{
+		/* reconnected when the gamestate is there */
+		R_ViewerPrint(v, "Waiting for the server...\n");
+		return;
+	}
+
+	v->state = rv_connected;
+
+	MSG_WriteByte(&v->netchan.message, svc_serverdata);
+	MSG_WriteLong(&v->netchan.message, current.protocol);
+	MSG_WriteLong(&v->netchan.message, current.spawncount);
+	MSG_WriteByte(&v->netchan.message, 0);
+	MSG_WriteString(&v->netchan.message, current.gamedir);
+	MSG_WriteShort(&v->netchan.message, VIEWER_PLAYERNUM);
+	MSG_WriteString(&v->netchan.message, current.levelname);
+
+	R_ViewerStuff(v, va("cmd configstrings %i 0\n", current.spawncount));
+}
+
+static void
+R_SendConfigstrings(rviewer_t *v, int start)
+{
+	sizebuf_t *msg;
+	const char *cs;
+
+	msg = &v->netchan.message;
+
+	while (start < MAX_CONFIGSTRINGS)
+	{
+		cs = current.configstrings[start];
+
+		if (cs)
+		{
+			if (msg->cursize + strlen(cs) + 4 > VIEWER_CHUNK)
+			{
+				break;
+			}
+
+			MSG_WriteByte(msg, svc_configstring);
+			MSG_WriteConfigString(msg, start, cs);
+		}
+
+		start++;
+	}
+
+	/* there are no baselines, the entities
+	   are always sent without a delta */
+	if (start == MAX_CONFIGSTRINGS)
+	{
+		R_ViewerStuff(v, va("precache %i\n", current.spawncount));
+	}
+	else
+	{
+		R_ViewerStuff(v, va("cmd configstrings %i %i\n",
+				current.spawncount, start));
+	}
+}
+
+static const char *
+R_PlayerName(int playernum)
+{
+	static char name[32];
+	const char *cs;
+	char *p;
+	int index;
+
+	/* the configstrings are stored by their
+	   index in the protocol of the server */
+	index = P_ConvertConfigStringTo(CS_PLAYERSKINS + playernum,
+			current.protocol);
+	cs = ((index >= 0) && (index < MAX_CONFIGSTRINGS)) ?
+		current.configstrings[index] : NULL;
+
+	Q_strlcpy(name, cs ? cs : va("player %i", playernum), sizeof(name));
+
+	p = strchr(name, '\\');
+
+	if (p)
+	{
+		*p = '\0';
+	}
+
+	return name;
+}
+
+static void
+R_Follow(rviewer_t *v, int playernum)
+{
+	v->follow = playernum;
+	R_ViewerPrint(v, va("Following %s\n", R_PlayerName(playernum)));
+}
+
+static void
+R_FollowNext(rviewer_t *v)
+{
+	int i, next;
+
+	if (!frame_numplayers)
+	{
+		return;
+	}
+
+	/* the players are sorted by their number */
+	next = frame_players[0].num;
+
+	for (i = 0; i < frame_numplayers; i++)
+	{
+		if (frame_players[i].num > v->follow)
+		{
+			next = frame_players[i].num;
+			break;
+		}
+	}
+
+	R_Follow(v, next);
+}
+
+static void
+R_Players(rviewer_t *v)
+{
+	int i;
+
+	for (i = 0; i < frame_numplayers; i++)
+	{
+		R_ViewerPrint(v, va("%3i %s\n", frame_players[i].num,
+				R_PlayerName(frame_players[i].num)));
+	}
+}
+
+static void
+R_ViewerCommand(rviewer_t *v, char *s)
+{
+	char c[32];
+	int arg1, arg2;
+
+	Q_strlcpy(c, COM_Parse(&s), sizeof(c));
+	arg1 = (int)strtol(COM_Parse(&s), NULL, 10);
+	arg2 = (int)strtol(COM_Parse(&s), NULL, 10);
+
+	Com_DPrintf("%s: %s %i %i\n", v->name, c, arg1, arg2);
+
+	if (!strcmp(c, "new"))
+	{
+		R_SendServerdata(v);
+	}
+	else if (!strcmp(c, "configstrings") || !strcmp(c, "begin"))
+	{
+		if ((v->state != rv_connected) || (arg1 != current.spawncount))
+		{
+			/* from a different level */
+			R_SendServerdata(v);
+		}
+		else if (!strcmp(c, "configstrings"))
+		{
+			R_SendConfigstrings(v, (arg2 > 0) ? arg2 : 0);
+		}
+		else
+		{
+			v->state = rv_active;
+			v->follow = -1;
+			R_ViewerPrint(v, "Press attack to follow the next player.\n");
+		}
+	}
+	else if (!strcmp(c, "follow") && (v->state == rv_active))
+	{
+		if (R_FindPlayer(arg1) >= 0)
+		{
+			R_Follow(v, arg1);
+		}
+		else
+		{
+			R_Players(v);
+		}
+	}
+	else if (!strcmp(c, "players"))
+	{
+		R_Players(v);
+	}
+	else if (!strcmp(c, "disconnect"))
+	{
+		R_DropViewer(v, "disconnected");
+	}
+}
+
+static void
+R_ParseMove(rviewer_t *v, sizebuf_t *msg)
+{
+	usercmd_t nullcmd, oldest, oldcmd, newcmd;
+
+	MSG_ReadByte(msg); /* checksum */
+	MSG_ReadLong(msg); /* last frame, we don't delta */
+
+	memset(&nullcmd, 0, sizeof(nullcmd));
+	MSG_ReadDeltaUsercmd(msg, &nullcmd, &oldest);
+	MSG_ReadDeltaUsercmd(msg, &oldest, &oldcmd);
+	MSG_ReadDeltaUsercmd(msg, &oldcmd, &newcmd);
+
+	if (v->state != rv_active)
+	{
+		return;
+	}
+
+	if ((newcmd.buttons & BUTTON_ATTACK) && !(v->buttons & BUTTON_ATTACK))
+	{
+		R_FollowNext(v);
+	}
+
+	v->buttons = newcmd.buttons;
+}
+
+static void
+R_ViewerMessage(rviewer_t *v, sizebuf_t *msg)
+{
+	int c;
+
+	while (v->state != rv_free)
+	{
+		if (msg->readcount > msg->cursize)
+		{
+			R_DropViewer(v, "sent a bad message");
+			return;
+		}
+
+		c = MSG_ReadByte(msg);
+
+		if (c == -1)
+		{
+			return;
+		}
+
+		switch (c)
+		{
+			case clc_nop:
+				break;
+
+			case clc_userinfo:
+				MSG_ReadString(msg);
+				break;
+
+			case clc_move:
+				R_ParseMove(v, msg);
+				break;
+
+			case clc_stringcmd:
+				R_ViewerCommand(v, MSG_ReadString(msg));
+				break;
+
+			default:
+				/* can't skip unknown commands */
+				return;
+		}
+	}
+}
+
+static void
+R_ViewerConnect(netadr_t from, char *s)
+{
+	char userinfo[MAX_INFO_STRING];
+	rviewer_t *v, *slot;
+	int version, qport, challenge, i;
+	qboolean fragments;
+	const char *c;
+
+	version = (int)strtol(COM_Parse(&s), NULL, 10);
+	qport = (int)strtol(COM_Parse(&s), NULL, 10);
+	challenge = (int)strtol(COM_Parse(&s), NULL, 10);
+	Q_strlcpy(userinfo, COM_Parse(&s), sizeof(userinfo));
+
+	/* optional features, only fragments are supported */
+	fragments = false;
+
+	while (s)
+	{
+		c = COM_Parse(&s);
+
+		if (!strcmp(c, "fragments"))
+		{
+			fragments = true;
+		}
+	}
+
+	if (version != PROTOCOL_VERSION)
+	{
+		R_OutOfBandPrint(NS_SERVER, from,
+				"print\nServer is protocol version 34.\n");
+		return;
+	}
+
+	if (challenge != R_Challenge(from))
+	{
+		R_OutOfBandPrint(NS_SERVER, from, "print\nBad challenge.\n");
+		return;
+	}
+
+	slot = NULL;
+
+	for (i = 0, v = viewers; i < maxviewers; i++, v++)
+	{
+		/* a reconnect replaces the old one */
+		if ((v->state != rv_free) && !memcmp(v->adr.ip, from.ip, 4) &&
+			((v->qport == qport) || (v->adr.port == from.port)))
+		{
+			slot = v;
+			break;
+		}
+
+		if ((v->state == rv_free) && !slot)
+		{
+			slot = v;
+		}
+	}
+
+	if (!slot)
+	{
+		R_OutOfBandPrint(NS_SERVER, from, "print\nRelay is full.\n");
+		return;
+	}
+
+	memset(slot, 0, sizeof(*slot));
+	slot->state = rv_connected;
+	slot->adr = from;
+	slot->qport = qport;
+	slot->lastmessage = curtime;
+	slot->follow = -1;
+	Q_strlcpy(slot->name, Info_ValueForKey(userinfo, "name"),
+			sizeof(slot->name));
+
+	Netchan_Setup(NS_SERVER, &slot->netchan, from, qport);
+	slot->netchan.fragments = fragments;
+	R_OutOfBandPrint(NS_SERVER, from, "client_connect%s",
+			fragments ? " fragments" : "");
+
+	Com_Printf("%s connected from %s\n", slot->name, NET_AdrToString(from));
+}
+
+static void
+R_ViewerPacket(netadr_t from, sizebuf_t *msg)
+{
+	rviewer_t *v;
+	const char *c;
+	char *s;
+	int qport, i;
+
+	if (*(int *)msg->data == -1)
+	{
+		MSG_BeginReading(msg);
+		MSG_ReadLong(msg); /* skip the -1 */
+
+		s = MSG_ReadStringLine(msg);
+		c = COM_Parse(&s);
+
+		if (!strcmp(c, "getchallenge"))
+		{
+			R_OutOfBandPrint(NS_SERVER, from, "challenge %i p=34",
+					R_Challenge(from));
+		}
+		else if (!strcmp(c, "connect"))
+		{
+			R_ViewerConnect(from, s);
+		}
+		else if (!strcmp(c, "ping"))
+		{
+			R_OutOfBandPrint(NS_SERVER, from, "ack");
+		}
+
+		return;
+	}
+
+	if (msg->cursize < 10)
+	{
+		return;
+	}
+
+	/* the qport is behind the sequence numbers */
+	qport = msg->data[8] | (msg->data[9] << 8);
+
+	for (i = 0, v = viewers; i < maxviewers; i++, v++)
+	{
+		if ((v->state == rv_free) || memcmp(v->adr.ip, from.ip, 4) ||
+			(v->qport != qport))
+		{
+			continue;
+		}
+
+		/* some routers change the port */
+		if (v->netchan.remote_address.port != from.port)
+		{
+			v->netchan.remote_address.port = from.port;
+			v->adr.port = from.port;
+		}
+
+		if (Netchan_Process(&v->netchan, msg))
+		{
+			v->lastmessage = curtime;
+			R_ViewerMessage(v, msg);
+		}
+
+		return;
+	}
+}
+
+/*
+ * Sends the pending reliable data and keeps the
+ * viewers waiting for a frame from timing out.
+ */
+static void
+R_CheckViewers(void)
+{
+	rviewer_t *v;
+	int i;
+
+	for (i = 0, v = viewers; i < maxviewers; i++, v++)
+	{
+		if (v->state == rv_free)
+		{
+			continue;
+		}
+
+		if (curtime - v->lastmessage > VIEWER_TIMEOUT)
+		{
+			R_DropViewer(v, "timed out");
+			continue;
+		}
+
+		if (v->netchan.message.overflowed)
+		{
+			SZ_Clear(&v->netchan.message);
+			R_DropViewer(v, "overflowed");
+			continue;
+		}
+
+		if (v->netchan.message.cursize ||
+			(curtime - v->netchan.last_sent > RESEND_TIME))
+		{
+			Netchan_Transmit(&v->netchan, 0, NULL);
+		}
+	}
+}
+
+/* ======================================================================= */
+
+static void
+R_ReadPackets(int sock)
+{
+	static byte data[MAX_MSGLEN];
+	struct sockaddr_in addr;
+	socklen_t addrlen;
+	netadr_t from;
+	sizebuf_t msg;
+	int ret;
+
+	while (1)
+	{
+		addrlen = sizeof(addr);
+		ret = recvfrom(sock, data, sizeof(data), MSG_DONTWAIT,
+				(struct sockaddr *)&addr, &addrlen);
+
+		if (ret <= 0)
+		{
+			return;
+		}
+
+		if (ret < 4)
+		{
+			continue;
+		}
+
+		memset(&from, 0, sizeof(from));
+		from.type = NA_IP;
+		memcpy(from.ip, &addr.sin_addr, 4);
+		from.port = addr.sin_port;
+
+		SZ_Init(&msg, data, sizeof(data));
+		msg.cursize = ret;
+
+		if (sock == upstream)
+		{
+			if (R_CompareAdr(from, server_adr))
+			{
+				stats.bytesin += ret;
+				R_ServerPacket(&msg);
+			}
+		}
+		else
+		{
+			R_ViewerPacket(from, &msg);
+		}
+	}
+}
+
+static void
+R_CheckServer(void)
+{
+	if (curtime - lastkeepalive >= (subscribed ? KEEPALIVE_TIME : RESEND_TIME))
+	{
+		lastkeepalive = curtime;
+		R_OutOfBandPrint(NS_CLIENT, server_adr, "relay %s\n", password);
+	}
+
+	if (subscribed && (curtime - lastserver > SERVER_TIMEOUT))
+	{
+		Com_Printf("Lost the server, resubscribing\n");
+		subscribed = false;
+	}
+
+	R_RequestSignon();
+}
+
+static void
+R_Report(float seconds)
+{
+	int i, connected, active;
+
+	connected = active = 0;
+
+	for (i = 0; i < maxviewers; i++)
+	{
+		if (viewers[i].state == rv_active)
+		{
+			active++;
+		}
+		else if (viewers[i].state == rv_connected)
+		{
+			connected++;
+		}
+	}
+
+	printf("viewers %i (%i connecting)  frames in %.1f/s %.1f KB/s"
+			"  out %.1f/s %.1f KB/s\n", active, connected,
+			stats.framesin / seconds, stats.bytesin / seconds / 1024,
+			stats.framesout / seconds, stats.bytesout / seconds / 1024);
+	fflush(stdout);
+
+	memset(&stats, 0, sizeof(stats));
+}
+
+static int
+R_OpenSocket(int port)
+{
+	struct sockaddr_in addr;
+	int sock;
+
+	sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+	if (sock == -1)
+	{
+		fprintf(stderr, "socket: %s\n", strerror(errno));
+		return -1;
+	}
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(port);
+
+	if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) == -1)
+	{
+		fprintf(stderr, "bind: %s\n", strerror(errno));
+		close(sock);
+		return -1;
+	}
+
+	return sock;
+}
+
+static void
+R_Usage(const char *name)
+{
+	printf("Usage: %s [options] server[:port]\n", name);
+	printf("  -w <password>  the sv_relay_password of the server\n");
+	printf("  -p <port>      port for the viewers, default %i\n", PORT_RELAY);
+	printf("  -m <viewers>   maximum number of viewers, default 256\n");
+	printf("  -i <seconds>   report interval, default 10, 0 for none\n");
+	printf("  -t <seconds>   run time, default forever\n");
+	printf("  -v             verbose\n");
+}
+
+int
+main(int argc, char **argv)
+{
+	struct pollfd fds[2];
+	int port = PORT_RELAY;
+	int interval = 10;
+	int runtime = 0;
+	int start, lastreport, c, i;
+
+	while ((c = getopt(argc, argv, "w:p:m:i:t:vh")) != -1)
+	{
+		switch (c)
+		{
+			case 'w':
+				password = optarg;
+				break;
+			case 'p':
+				port = (int)strtol(optarg, NULL, 10);
+				break;
+			case 'm':
+				maxviewers = (int)strtol(optarg, NULL, 10);
+				break;
+			case 'i':
+				interval = (int)strtol(optarg, NULL, 10);
+				break;
+			case 't':
+				runtime = (int)strtol(optarg, NULL, 10);
+				break;
+			case 'v':
+				verbose = 1;
+				break;
+			default:
+				R_Usage(argv[0]);
+				return 1;
+		}
+	}
+
+	if ((optind >= argc) || (maxviewers < 1) || (interval < 0))
+	{
+		R_Usage(argv[0]);
+		return 1;
+	}
+
+	if (!R_StringToAdr(argv[optind], &server_adr))
+	{
+		fprintf(stderr, "Couldn't resolve %s\n", argv[optind]);
+		return 1;
+	}
+
+	randk_seed();
+	Netchan_Init();
+	challenge_secret = randk();
+
+	viewers = calloc(maxviewers, sizeof(rviewer_t));
+
+	if (!viewers)
+	{
+		fprintf(stderr, "Couldn't allocate %i viewers\n", maxviewers);
+		return 1;
+	}
+
+	upstream = R_OpenSocket(0);
+	downstream = R_OpenSocket(port);
+
+	if ((upstream == -1) || (downstream == -1))
+	{
+		return 1;
+	}
+
+	fds[0].fd = upstream;
+	fds[0].events = POLLIN;
+	fds[1].fd = downstream;
+	fds[1].events = POLLIN;
+
+	for (i = 0; i < MAX_CLIENTS; i++)
+	{
+		pov_frame[i] = -1;
+	}
+
+	printf("Relaying %s to port %i\n", NET_AdrToString(server_adr), port);
+
+	start = lastreport = curtime = R_Milliseconds();
+	lastkeepalive = -RESEND_TIME;
+
+	while (!runtime || (curtime - start < runtime * 1000))
+	{
+		poll(fds, 2, 100);
+
+		curtime = R_Milliseconds();
+
+		if (fds[0].revents & POLLIN)
+		{
+			R_ReadPackets(upstream);
+		}
+
+		if (fds[1].revents & POLLIN)
+		{
+			R_ReadPackets(downstream);
+		}
+
+		R_CheckServer();
+		R_CheckViewers();
+
+		if (interval && (curtime - lastreport >= interval * 1000))
+		{
+			R_Report((curtime - lastreport) / 1000.0f);
+			lastreport = curtime;
+		}
+	}
+
+	for (i = 0; i < maxviewers; i++)
+	{
+		if (viewers[i].state != rv_free)
+		{
+			R_DropViewer(&viewers[i], "dropped, relay shutting down");
+		}
+	}
+
+	R_FreeGamestate(&current);
+	R_FreeGamestate(&pending);
+
+	close(upstream);
+	close(downstream);
+	free(viewers);
+
+	return 0;
+}
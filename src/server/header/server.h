@@ -45,6 +45,9 @@
  * savegames would be broken. */
 #define MAX_SAVE_TOKEN_CHARS 128
 
+/* buckets of the configstring name hash, power of two */
+#define CS_HASH_SIZE 1024
+
 
 #define SV_OUTPUTBUF_LENGTH (MAX_MSGLEN - 16)
 #define EDICT_NUM(n) ((edict_t *)((byte *)ge->edicts + ge->edict_size * (n)))
@@ -77,6 +80,9 @@ typedef struct
 
 	stringlist_t configstrings_overflow;
 	char configstrings[MAX_CONFIGSTRINGS][MAX_CONFIGSTRING];
+	int configstrings_version;       /* bumped on each change after loading */
+	unsigned short configstrings_hash[CS_HASH_SIZE];          /* index + 1, 0 ends the chain */
+	unsigned short configstrings_hashnext[MAX_CONFIGSTRINGS];
 	entity_xstate_t *baselines;
 	int numbaselines;
 
@@ -106,10 +112,45 @@ typedef struct
 	player_state_t ps;
 	int origin[3];                          /* extended ps.origin to 28.3 format */
 	int num_entities;
-	int first_entity;                       /* into the circular sv_packet_entities[] */
+	int first_entity;                       /* into the circular svs.client_entities[] */
+	int framenum;                           /* server frame it was built in */
 	int senttime;                           /* for ping calculations */
 } client_frame_t;
 
+/* Entity states of one server frame. Every state is
+   stored once and shared by all client frames built
+   in that frame, it's released when the frame falls
+   out of UPDATE_BACKUP and the pool gets reused. */
+typedef struct
+{
+	int framenum;
+	int spawncount;
+	int num_states;
+	int max_states;
+	entity_xstate_t *states;                /* [max_states] */
+} entitypool_t;
+
+/* A file being downloaded, shared by all clients
+   downloading it at the same time */
+typedef struct svdownload_s
+{
+	char name[MAX_QPATH];
+	byte *data;
+	int size;
+	int refcount;
+	qboolean protectedpak;              /* loaded from a protected pak */
+	struct svdownload_s *next;
+} svdownload_t;
+
+/* Tails of the last compressed frames of a client,
+   used as preset dictionary for the next ones */
+typedef struct
+{
+	byte dict[UPDATE_BACKUP][ZFRAME_DICT_SIZE];
+	int dictlen[UPDATE_BACKUP];
+	int dictframe[UPDATE_BACKUP];      /* -1 if not compressed */
+} zframedict_t;
+
 typedef struct client_s
 {
 	client_state_t state;
@@ -138,7 +179,7 @@ typedef struct client_s
 
 	client_frame_t frames[UPDATE_BACKUP];     /* updates can be delta'd from here */
 
-	byte *download;                     /* file being downloaded */
+	svdownload_t *download;             /* file being downloaded */
 	int downloadsize;                   /* total bytes (can't use EOF because of paks) */
 	int downloadcount;                  /* bytes sent */
 
@@ -149,6 +190,17 @@ typedef struct client_s
 
 	netchan_t netchan;
 	int protocol;
+
+	qboolean zframe;                    /* accepts compressed frames */
+	zframedict_t *zdict;                /* kept with the slot */
+
+	/* position cache for SV_Multicast, refreshed when
+	   the origin changes. The second cluster is 32 units
+	   higher and only set if the client is in water. */
+	int multicast_map;
+	vec3_t multicast_origin;
+	int multicast_cluster[2];
+	int multicast_area[2];
 } client_t;
 
 typedef struct
@@ -171,7 +223,8 @@ typedef struct
 	client_t *clients;                  /* [maxclients->value]; */
 	int num_client_entities;            /* maxclients->value*UPDATE_BACKUP*MAX_PACKET_ENTITIES */
 	int next_client_entities;           /* next client_entity to use */
-	entity_xstate_t *client_entities;    /* [num_client_entities] */
+	int *client_entities;               /* [num_client_entities], into entity_pools */
+	entitypool_t entity_pools[UPDATE_BACKUP];
 
 	int last_heartbeat;
 
@@ -203,6 +256,7 @@ extern cvar_t *sv_noreload;                 /* don't reload level state when ree
 extern cvar_t *sv_airaccelerate;            /* don't reload level state when reentering */
 											/* development tool */
 extern cvar_t *sv_enforcetime;
+extern cvar_t *sv_compressframes;
 extern cvar_t *sv_downloadserver;			/* Download server. */
 extern cvar_t *sv_language;			/* Localization. */
 
@@ -212,6 +266,9 @@ extern edict_t *sv_player;
 void SV_FinalMessage(char *message, qboolean reconnect);
 void SV_DropClient(client_t *drop);
 
+void SV_HashConfigstring(int index);
+void SV_UnhashConfigstring(int index);
+void SV_RehashConfigstrings(void);
 int SV_ModelIndex(const char *name);
 int SV_SoundIndex(const char *name);
 int SV_ImageIndex(const char *name);
@@ -255,6 +312,10 @@ int SV_GetRecomendedProtocol(void);
 
 void SV_Nextserver(void);
 void SV_ExecuteClientMessage(client_t *cl);
+void SV_FreeGamestate(void);
+int SV_WriteConfigstrings(sizebuf_t *msg, int protocol, int start, int limit);
+void SV_CloseDownload(client_t *cl);
+void SV_FreeDownloads(void);
 
 void SV_ReadLevelFile(void);
 char *SV_StatusString(void);
@@ -262,8 +323,25 @@ void SV_ConnectionlessPacket(void);
 
 void SV_WriteFrameToClient(client_t *client, sizebuf_t *msg);
 void SV_RecordDemoMessage(void);
+void SV_WriteRelayFrame(sizebuf_t *msg, int protocol);
+
+/* server demo writer */
+void SV_DemoInit(void);
+qboolean SV_DemoOpen(const char *name);
+void SV_DemoWriteMessage(const sizebuf_t *msg);
+void SV_DemoClose(void);
+void SV_BeginClientFrames(void);
+void SV_FreeEntityPools(void);
 void SV_BuildClientFrame(client_t *client);
 
+/* spectator relay stream */
+void SV_RelayInit(void);
+qboolean SV_RelayActive(void);
+qboolean SV_IsRelay(netadr_t adr);
+void SV_RelayFrame(void);
+void SVC_Relay(void);
+void SVC_RelaySignon(void);
+
 extern game_export_t *ge;
 
 void SV_ClearBaselines(void);
@@ -301,6 +379,14 @@ int SV_PointContents(vec3_t p);
 
 trace_t SV_Trace(const vec3_t start, const vec3_t mins, const vec3_t maxs,
 		const vec3_t end, const edict_t *passedict, int contentmask);
+trace_t SV_TraceReentrant(const vec3_t start, const vec3_t mins,
+		const vec3_t maxs, const vec3_t end, const edict_t *passedict,
+		int contentmask);
+
+/* worker threads for the game */
+void SV_InitWorkers(void);
+void SV_StopWorkers(void);
+void SV_RunParallel(void (*func)(void *data, int index), void *data, int count);
 
 /* loadtime optimizations */
 
@@ -310,5 +396,27 @@ trace_t SV_Trace(const vec3_t start, const vec3_t mins, const vec3_t maxs,
 
 int SV_Optimizations(void);
 
+/* server frame profiler */
+
+typedef enum
+{
+	SVP_READPACKETS,
+	SVP_RUNGAMEFRAME,
+	SVP_SENDCLIENTMESSAGES,
+	SVP_SENDPREPCLIENTMESSAGES,
+	SVP_RECORDDEMOMESSAGE,
+	SVP_RELAYFRAME,
+	SVP_COMPRESSFRAMES,
+	SVP_FRAME,
+
+	SVP_NUM_PHASES
+} svprofile_phase_t;
+
+void SV_ProfileInit(void);
+void SV_ProfileShutdown(void);
+void SV_ProfileBegin(svprofile_phase_t phase);
+void SV_ProfileEnd(svprofile_phase_t phase);
+void SV_ProfileFrame(void);
+
 #endif
 
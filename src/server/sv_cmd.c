@@ -557,7 +557,6 @@ SV_ServerRecord_f(void)
 	char name[MAX_OSPATH];
 	byte buf_data[32768];
 	sizebuf_t buf;
-	int len;
 	int i;
 
 	if (Cmd_Argc() != 2)
@@ -586,23 +585,6 @@ SV_ServerRecord_f(void)
 		return;
 	}
 
-	/* open the demo file */
-	Com_sprintf(name, sizeof(name), "%s/demos/%s.dm2", FS_Gamedir(), Cmd_Argv(1));
-
-	Com_Printf("recording to %s.\n", name);
-	FS_CreatePath(name);
-	svs.demofile = Q_fopen(name, "wb");
-
-	if (!svs.demofile)
-	{
-		Com_Printf("ERROR: couldn't open.\n");
-		return;
-	}
-
-	/* setup a buffer to catch all multicasts */
-	SZ_Init(&svs.demo_multicast, svs.demo_multicast_buf,
-			sizeof(svs.demo_multicast_buf));
-
 	/* write a single giant fake message with all the startup info */
 	SZ_Init(&buf, buf_data, sizeof(buf_data));
 
@@ -628,24 +610,29 @@ SV_ServerRecord_f(void)
 
 			/* i in native server range */
 			MSG_WriteConfigString(&buf,
-				P_ConvertConfigStringTo(i, sv_client->protocol),
+				P_ConvertConfigStringTo(i, SV_GetRecomendedProtocol()),
 				sv.configstrings[i]);
 
 			if (buf.cursize + 67 >= buf.maxsize)
 			{
 				Com_Printf("not enough buffer space available.\n");
-				fclose(svs.demofile);
-				svs.demofile = NULL;
 				return;
 			}
 		}
 	}
 
+	/* open the demo file */
+	Com_sprintf(name, sizeof(name), "%s/demos/%s", FS_Gamedir(), Cmd_Argv(1));
+
+	if (!SV_DemoOpen(name))
+	{
+		Com_Printf("ERROR: couldn't open.\n");
+		return;
+	}
+
 	/* write it to the demo file */
 	Com_DPrintf("signon message length: %i\n", buf.cursize);
-	len = LittleLong(buf.cursize);
-	fwrite(&len, 4, 1, svs.demofile);
-	fwrite(buf.data, buf.cursize, 1, svs.demofile);
+	SV_DemoWriteMessage(&buf);
 }
 
 /*
@@ -660,8 +647,7 @@ SV_ServerStop_f(void)
 		return;
 	}
 
-	fclose(svs.demofile);
-	svs.demofile = NULL;
+	SV_DemoClose();
 	Com_Printf("Recording completed.\n");
 }
 
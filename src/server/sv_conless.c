@@ -28,6 +28,26 @@
 
 extern cvar_t *hostname;
 extern cvar_t *rcon_password;
+extern cvar_t *sv_ratelimit;
+extern cvar_t *sv_ratelimit_burst;
+
+/* Token buckets for connectionless packets, one per source
+   address. Addresses sharing a slot just replace each other,
+   which at worst gives a flooder a fresh bucket. */
+#define RATELIMIT_SLOTS 1024 /* must be a power of two */
+#define RATELIMIT_REPORT 10000 /* msec between drop reports */
+
+typedef struct
+{
+	netadrtype_t type;
+	byte ip[8];
+	int tokens; /* in 1/1000 packets */
+	int time; /* of the last refill */
+} ratelimit_t;
+
+static ratelimit_t sv_ratelimits[RATELIMIT_SLOTS];
+static int sv_ratelimit_dropped;
+static int sv_ratelimit_lastreport;
 
 /*
  * Responds with all the info that qplug or qspy can see
@@ -38,6 +58,66 @@ SVC_Status(void)
 	Netchan_OutOfBandPrint(NS_SERVER, net_from, "print\n%s", SV_StatusString());
 }
 
+/*
+ * Returns true if the packet from adr exceeds its
+ * rate and should be dropped. Keyed by the IPv4
+ * address or the /64 network for IPv6.
+ */
+static qboolean
+SV_RateLimited(netadr_t adr)
+{
+	ratelimit_t *r;
+	unsigned hash;
+	long long tokens;
+	int i, len, now, rate, burst;
+
+	if ((sv_ratelimit->value <= 0) || (adr.type == NA_LOOPBACK))
+	{
+		return false;
+	}
+
+	rate = (int)sv_ratelimit->value;
+	burst = (sv_ratelimit_burst->value > 1) ?
+		(int)sv_ratelimit_burst->value * 1000 : 1000;
+
+	len = (adr.type == NA_IP6) ? 8 : 4;
+	hash = adr.type;
+
+	for (i = 0; i < len; i++)
+	{
+		hash = hash * 31 + adr.ip[i];
+	}
+
+	r = &sv_ratelimits[hash & (RATELIMIT_SLOTS - 1)];
+	now = Sys_Milliseconds();
+
+	if ((r->type != adr.type) || memcmp(r->ip, adr.ip, len) ||
+		(now < r->time))
+	{
+		r->type = adr.type;
+		memset(r->ip, 0, sizeof(r->ip));
+		memcpy(r->ip, adr.ip, len);
+		r->tokens = burst;
+	}
+	else
+	{
+		tokens = r->tokens + (long long)(now - r->time) * rate;
+		r->tokens = (tokens > burst) ? burst : (int)tokens;
+	}
+
+	r->time = now;
+
+	if (r->tokens < 1000)
+	{
+		sv_ratelimit_dropped++;
+		return true;
+	}
+
+	r->tokens -= 1000;
+
+	return false;
+}
+
 static void
 SVC_Ack(void)
 {
@@ -52,6 +132,8 @@ static void
 SVC_Info(void)
 {
 	char string[64];
+	static char info[64];
+	static int info_spawncount, info_framenum = -1;
 	int i, count;
 	int version;
 
@@ -67,6 +149,12 @@ SVC_Info(void)
 		Com_sprintf(string, sizeof(string), "%s: wrong version\n",
 				hostname->string);
 	}
+	else if ((info_framenum == sv.framenum) &&
+		(info_spawncount == svs.spawncount) && sv.state)
+	{
+		/* already built during this server frame */
+		Q_strlcpy(string, info, sizeof(string));
+	}
 	else
 	{
 		count = 0;
@@ -82,6 +170,10 @@ SVC_Info(void)
 		Com_sprintf(string, sizeof(string), "%16s %8s %2i/%2i\n",
 				hostname->string, sv.name, count,
 				(int)maxclients->value);
+
+		Q_strlcpy(info, string, sizeof(info));
+		info_framenum = sv.framenum;
+		info_spawncount = svs.spawncount;
 	}
 
 	Netchan_OutOfBandPrint(NS_SERVER, net_from, "info\n%s", string);
@@ -154,6 +246,8 @@ SVC_DirectConnect(void)
 	client_t *cl, *newcl;
 	client_t temp;
 	edict_t *ent;
+	zframedict_t *zdict;
+	qboolean zframe, fragments;
 	int version;
 	int qport;
 	int challenge;
@@ -177,6 +271,24 @@ SVC_DirectConnect(void)
 
 	Q_strlcpy(userinfo, Cmd_Argv(4), sizeof(userinfo));
 
+	/* optional features requested by the client. Compressed
+	   frames and fragments don't pay off over the loopback. */
+	zframe = false;
+	fragments = false;
+
+	for (i = 5; i < Cmd_Argc(); i++)
+	{
+		if (!strcmp(Cmd_Argv(i), "zframe"))
+		{
+			zframe = (sv_compressframes->value > 0) &&
+				!NET_IsLocalAddress(adr);
+		}
+		else if (!strcmp(Cmd_Argv(i), "fragments"))
+		{
+			fragments = !NET_IsLocalAddress(adr);
+		}
+	}
+
 	/* force the IP key/value pair so the game can filter based on ip */
 	Info_SetValueForKey(userinfo, "ip", NET_AdrToString(net_from));
 
@@ -269,7 +381,9 @@ gotnewcl:
 
 	/* build a new connection  accept the new client this
 	   is the only place a client_t is ever initialized */
+	zdict = newcl->zdict;
 	*newcl = temp;
+	newcl->zdict = zdict;
 	sv_client = newcl;
 	ent = CL_EDICT(newcl);
 	newcl->challenge = challenge; /* save challenge for checksumming */
@@ -297,17 +411,36 @@ gotnewcl:
 	Q_strlcpy(newcl->userinfo, userinfo, sizeof(newcl->userinfo));
 	SV_UserinfoChanged(newcl);
 
+	if (zframe)
+	{
+		if (!newcl->zdict)
+		{
+			newcl->zdict = Z_Malloc(sizeof(zframedict_t));
+		}
+
+		for (i = 0; i < UPDATE_BACKUP; i++)
+		{
+			newcl->zdict->dictframe[i] = -1;
+		}
+
+		newcl->zframe = true;
+	}
+
 	/* send the connect packet to the client */
 	if (sv_downloadserver->string[0])
 	{
-		Netchan_OutOfBandPrint(NS_SERVER, adr, "client_connect dlserver=%s", sv_downloadserver->string);
+		Netchan_OutOfBandPrint(NS_SERVER, adr, "client_connect dlserver=%s%s%s",
+				sv_downloadserver->string, zframe ? " zframe" : "",
+				fragments ? " fragments" : "");
 	}
 	else
 	{
-		Netchan_OutOfBandPrint(NS_SERVER, adr, "client_connect");
+		Netchan_OutOfBandPrint(NS_SERVER, adr, "client_connect%s%s",
+				zframe ? " zframe" : "", fragments ? " fragments" : "");
 	}
 
 	Netchan_Setup(NS_SERVER, &newcl->netchan, adr, qport);
+	newcl->netchan.fragments = fragments;
 
 	newcl->state = cs_connected;
 
@@ -392,6 +525,20 @@ SV_ConnectionlessPacket(void)
 	char *s;
 	char *c;
 
+	/* relays pull the gamestate in bursts */
+	if (!SV_IsRelay(net_from) && SV_RateLimited(net_from))
+	{
+		if (Sys_Milliseconds() - sv_ratelimit_lastreport > RATELIMIT_REPORT)
+		{
+			Com_Printf("Dropped %i connectionless packets, last from %s\n",
+					sv_ratelimit_dropped, NET_AdrToString(net_from));
+			sv_ratelimit_lastreport = Sys_Milliseconds();
+			sv_ratelimit_dropped = 0;
+		}
+
+		return;
+	}
+
 	MSG_BeginReading(&net_message);
 	MSG_ReadLong(&net_message); /* skip the -1 marker */
 
@@ -430,6 +577,14 @@ SV_ConnectionlessPacket(void)
 	{
 		SVC_RemoteCommand();
 	}
+	else if (!strcmp(c, "relay"))
+	{
+		SVC_Relay();
+	}
+	else if (!strcmp(c, "relaysignon"))
+	{
+		SVC_RelaySignon();
+	}
 	else
 	{
 		Com_Printf("bad connectionless packet from %s:\n%s\n",
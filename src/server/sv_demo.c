@@ -0,0 +1,335 @@
+/*
+ * Copyright (C) 1997-2001 Id Software, Inc.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+ * 02111-1307, USA.
+ *
+ * =======================================================================
+ *
+ * Server demo writer. The messages recorded by 'serverrecord' are
+ * appended to an in-memory ring and written to disk by a background
+ * thread, so disk stalls don't end up in the server frame time. If
+ * sv_demo_compress is set the demo is written as gzip file.
+ *
+ * =======================================================================
+ */
+
+#include "header/server.h"
+#include "../common/unzip/miniz/miniz.h"
+
+/* Several seconds of a busy server,
+   must hold at least one message. */
+#define DEMO_RING_SIZE (4 * 1024 * 1024)
+
+typedef struct
+{
+	FILE *file;
+
+	/* ring buffer, head and tail are
+	   running byte counts */
+	byte *ring;
+	size_t head;
+	size_t tail;
+
+	sys_mutex_t *lock;
+	sys_cond_t *cond;
+	sys_thread_t *thread;
+	qboolean shutdown;
+
+	/* gzip state, NULL if not compressing */
+	tdefl_compressor *deflate;
+	mz_ulong crc;
+	unsigned insize;
+
+	/* set by the writer, reported by
+	   the main thread when closing */
+	qboolean error;
+	int stalls;
+} demowriter_t;
+
+static demowriter_t demo;
+static cvar_t *sv_demo_compress;
+
+static mz_bool
+SV_DemoPutBuf(const void *buf, int len, void *user)
+{
+	demowriter_t *w = user;
+
+	if (fwrite(buf, len, 1, w->file) != 1)
+	{
+		w->error = true;
+	}
+
+	return MZ_TRUE;
+}
+
+/*
+ * Writes a block to disk. Called by the writer
+ * thread, or by the main thread if there's none.
+ */
+static void
+SV_DemoWriteBlock(demowriter_t *w, const byte *data, size_t len)
+{
+	if (w->deflate)
+	{
+		w->crc = mz_crc32(w->crc, data, len);
+		w->insize += len;
+		tdefl_compress_buffer(w->deflate, data, len, TDEFL_NO_FLUSH);
+	}
+	else if (fwrite(data, len, 1, w->file) != 1)
+	{
+		w->error = true;
+	}
+}
+
+static void
+SV_DemoThread(void *data)
+{
+	demowriter_t *w = data;
+	size_t start, len;
+
+	Sys_LockMutex(w->lock);
+
+	while (1)
+	{
+		while ((w->head == w->tail) && !w->shutdown)
+		{
+			Sys_WaitCond(w->cond, w->lock);
+		}
+
+		if (w->head == w->tail)
+		{
+			break; /* shutdown and everything written */
+		}
+
+		/* the main thread never touches the
+		   range between tail and head */
+		start = w->tail % DEMO_RING_SIZE;
+		len = w->head - w->tail;
+
+		if (start + len > DEMO_RING_SIZE)
+		{
+			len = DEMO_RING_SIZE - start;
+		}
+
+		Sys_UnlockMutex(w->lock);
+		SV_DemoWriteBlock(w, w->ring + start, len);
+		Sys_LockMutex(w->lock);
+
+		w->tail += len;
+		Sys_SignalCond(w->cond);
+	}
+
+	Sys_UnlockMutex(w->lock);
+}
+
+/*
+ * Appends data to the ring. Blocks if the writer
+ * thread can't keep up, which should never happen.
+ */
+static void
+SV_DemoAppend(const void *data, size_t len)
+{
+	demowriter_t *w = &demo;
+	size_t start, part;
+
+	if (!w->thread)
+	{
+		SV_DemoWriteBlock(w, data, len);
+		return;
+	}
+
+	Sys_LockMutex(w->lock);
+
+	if (DEMO_RING_SIZE - (w->head - w->tail) < len)
+	{
+		w->stalls++;
+
+		while (DEMO_RING_SIZE - (w->head - w->tail) < len)
+		{
+			Sys_WaitCond(w->cond, w->lock);
+		}
+	}
+
+	start = w->head % DEMO_RING_SIZE;
+	part = len;
+
+	if (start + part > DEMO_RING_SIZE)
+	{
+		part = DEMO_RING_SIZE - start;
+	}
+
+	memcpy(w->ring + start, data, part);
+	memcpy(w->ring, (const byte *)data + part, len - part);
+
+	w->head += len;
+	Sys_SignalCond(w->cond);
+
+	Sys_UnlockMutex(w->lock);
+}
+
+/*
+ * Writes a message, prefixed by its length
+ */
+void
+SV_DemoWriteMessage(const sizebuf_t *msg)
+{
+	int len;
+
+	if (!svs.demofile)
+	{
+		return;
+	}
+
+	len = LittleLong(msg->cursize);
+	SV_DemoAppend(&len, 4);
+	SV_DemoAppend(msg->data, msg->cursize);
+}
+
+/*
+ * Opens a demo file and starts the writer thread.
+ * The name is without the extension.
+ */
+qboolean
+SV_DemoOpen(const char *name)
+{
+	static const byte gzheader[10] = {
+		0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff
+	};
+	char path[MAX_OSPATH];
+	demowriter_t *w = &demo;
+
+	memset(w, 0, sizeof(*w));
+
+	Com_sprintf(path, sizeof(path), "%s.dm2%s", name,
+			sv_demo_compress->value ? ".gz" : "");
+
+	Com_Printf("recording to %s.\n", path);
+	FS_CreatePath(path);
+	w->file = Q_fopen(path, "wb");
+
+	if (!w->file)
+	{
+		return false;
+	}
+
+	if (sv_demo_compress->value)
+	{
+		w->deflate = malloc(sizeof(tdefl_compressor));
+
+		if (!w->deflate)
+		{
+			fclose(w->file);
+			return false;
+		}
+
+		/* negative window bits for raw deflate,
+		   the gzip framing is written by us */
+		tdefl_init(w->deflate, SV_DemoPutBuf, w,
+				tdefl_create_comp_flags_from_zip_params(
+					MZ_DEFAULT_LEVEL, -MZ_DEFAULT_WINDOW_BITS,
+					MZ_DEFAULT_STRATEGY));
+
+		w->crc = MZ_CRC32_INIT;
+		fwrite(gzheader, sizeof(gzheader), 1, w->file);
+	}
+
+	w->ring = malloc(DEMO_RING_SIZE);
+	w->lock = Sys_CreateMutex();
+	w->cond = Sys_CreateCond();
+
+	if (w->ring && w->lock && w->cond)
+	{
+		w->thread = Sys_CreateThread(SV_DemoThread, w);
+	}
+
+	if (!w->thread)
+	{
+		Com_Printf("Couldn't start the demo writer, writing synchronously.\n");
+	}
+
+	svs.demofile = w->file;
+
+	return true;
+}
+
+/*
+ * Flushes all pending data and closes the demo
+ */
+void
+SV_DemoClose(void)
+{
+	demowriter_t *w = &demo;
+	byte trailer[8];
+
+	if (!svs.demofile)
+	{
+		return;
+	}
+
+	if (w->thread)
+	{
+		Sys_LockMutex(w->lock);
+		w->shutdown = true;
+		Sys_SignalCond(w->cond);
+		Sys_UnlockMutex(w->lock);
+
+		Sys_WaitThread(w->thread);
+	}
+
+	if (w->deflate)
+	{
+		tdefl_compress_buffer(w->deflate, NULL, 0, TDEFL_FINISH);
+
+		trailer[0] = w->crc & 0xff;
+		trailer[1] = (w->crc >> 8) & 0xff;
+		trailer[2] = (w->crc >> 16) & 0xff;
+		trailer[3] = (w->crc >> 24) & 0xff;
+		trailer[4] = w->insize & 0xff;
+		trailer[5] = (w->insize >> 8) & 0xff;
+		trailer[6] = (w->insize >> 16) & 0xff;
+		trailer[7] = (w->insize >> 24) & 0xff;
+		SV_DemoPutBuf(trailer, sizeof(trailer), w);
+
+		free(w->deflate);
+	}
+
+	if (w->error)
+	{
+		Com_Printf("WARNING: error while writing the demo, it's incomplete.\n");
+	}
+
+	if (w->stalls)
+	{
+		Com_Printf("WARNING: demo writer couldn't keep up %i times.\n",
+				w->stalls);
+	}
+
+	fclose(w->file);
+
+	Sys_DestroyCond(w->cond);
+	Sys_DestroyMutex(w->lock);
+	free(w->ring);
+
+	memset(w, 0, sizeof(*w));
+	svs.demofile = NULL;
+}
+
+void
+SV_DemoInit(void)
+{
+	sv_demo_compress = Cvar_Get("sv_demo_compress", "0", 0);
+}
@@ -33,6 +33,45 @@
 // DG: is casted to int32_t* in SV_FatPVS() so align accordingly
 static YQ2_ALIGNAS_TYPE(int32_t) byte fatpvs[65536 / 8];
 
+/* where the state of an edict went in the pool of the
+   current frame, [1] is the non solid one for the owner */
+typedef struct
+{
+	int sequence;
+	int index[2];
+} entityslot_t;
+
+/* grows with the edicts, the game may have more than MAX_EDICTS */
+static entityslot_t *sv_entityslots;
+static int sv_numentityslots;
+static int sv_entitysequence;
+
+/*
+ * Checks that a client frame was built in the given
+ * server frame and that its entity states are still
+ * in the pool.
+ */
+static qboolean
+SV_EntityPoolValid(const client_frame_t *frame, int framenum)
+{
+	const entitypool_t *pool;
+
+	pool = &svs.entity_pools[framenum & UPDATE_MASK];
+
+	return (frame->framenum == framenum) &&
+		(pool->framenum == framenum) &&
+		(pool->spawncount == svs.spawncount);
+}
+
+/*
+ * Returns the entity states of a client frame.
+ */
+static const entity_xstate_t *
+SV_FrameEntityStates(const client_frame_t *frame)
+{
+	return svs.entity_pools[frame->framenum & UPDATE_MASK].states;
+}
+
 /*
  * Writes a delta update of an entity_state_t list to the message.
  */
@@ -40,7 +79,8 @@ static void
 SV_EmitPacketEntities(client_frame_t *from, client_frame_t *to, sizebuf_t *msg,
 	int protocol)
 {
-	entity_xstate_t *oldent, *newent;
+	const entity_xstate_t *oldent, *newent;
+	const entity_xstate_t *fromstates, *tostates;
 	int oldindex, newindex;
 	int from_num_entities;
 
@@ -49,12 +89,16 @@ SV_EmitPacketEntities(client_frame_t *from, client_frame_t *to, sizebuf_t *msg,
 	if (!from)
 	{
 		from_num_entities = 0;
+		fromstates = NULL;
 	}
 	else
 	{
 		from_num_entities = from->num_entities;
+		fromstates = SV_FrameEntityStates(from);
 	}
 
+	tostates = SV_FrameEntityStates(to);
+
 	newindex = 0;
 	oldindex = 0;
 	newent = NULL;
@@ -76,8 +120,8 @@ SV_EmitPacketEntities(client_frame_t *from, client_frame_t *to, sizebuf_t *msg,
 		}
 		else
 		{
-			newent = &svs.client_entities[(to->first_entity +
-					 newindex) % svs.num_client_entities];
+			newent = &tostates[svs.client_entities[(to->first_entity +
+					 newindex) % svs.num_client_entities]];
 			newnum = newent->number;
 		}
 
@@ -87,8 +131,8 @@ SV_EmitPacketEntities(client_frame_t *from, client_frame_t *to, sizebuf_t *msg,
 		}
 		else
 		{
-			oldent = &svs.client_entities[(from->first_entity +
-					 oldindex) % svs.num_client_entities];
+			oldent = &fromstates[svs.client_entities[(from->first_entity +
+					 oldindex) % svs.num_client_entities]];
 			oldnum = oldent->number;
 		}
 
@@ -470,6 +514,13 @@ SV_WriteFrameToClient(client_t *client, sizebuf_t *msg)
 		oldframe = NULL;
 		lastframe = -1;
 	}
+	else if (!SV_EntityPoolValid(&client->frames[client->lastframe & UPDATE_MASK],
+				client->lastframe))
+	{
+		/* the frame was never built or its states are gone */
+		oldframe = NULL;
+		lastframe = -1;
+	}
 	else
 	{
 		/* we have a valid message to delta from */
@@ -557,6 +608,145 @@ SV_FatPVS(vec3_t org)
 	}
 }
 
+/*
+ * Starts a new round of client frames. Entity
+ * states are looked up again from here on.
+ */
+void
+SV_BeginClientFrames(void)
+{
+	sv_entitysequence++;
+}
+
+void
+SV_FreeEntityPools(void)
+{
+	int i;
+
+	for (i = 0; i < UPDATE_BACKUP; i++)
+	{
+		if (svs.entity_pools[i].states)
+		{
+			Z_Free(svs.entity_pools[i].states);
+		}
+	}
+
+	memset(svs.entity_pools, 0, sizeof(svs.entity_pools));
+
+	if (sv_entityslots)
+	{
+		Z_Free(sv_entityslots);
+		sv_entityslots = NULL;
+	}
+
+	sv_numentityslots = 0;
+}
+
+static entityslot_t *
+SV_EntitySlot(int e)
+{
+	int i, num;
+
+	if (e >= sv_numentityslots)
+	{
+		num = (int)NextPow2gt(e);
+
+		if (num < MAX_EDICTS)
+		{
+			num = MAX_EDICTS;
+		}
+
+		sv_entityslots = Z_Realloc(sv_entityslots, num * sizeof(entityslot_t));
+
+		/* the new slots hold nothing of this round */
+		for (i = sv_numentityslots; i < num; i++)
+		{
+			sv_entityslots[i].sequence = sv_entitysequence - 1;
+		}
+
+		sv_numentityslots = num;
+	}
+
+	return &sv_entityslots[e];
+}
+
+/*
+ * Returns the pool of the current server frame. The pool
+ * of the frame UPDATE_BACKUP frames ago is reused, nothing
+ * can delta from it anymore.
+ */
+static entitypool_t *
+SV_CurrentEntityPool(void)
+{
+	entitypool_t *pool;
+
+	pool = &svs.entity_pools[sv.framenum & UPDATE_MASK];
+
+	if ((pool->framenum != sv.framenum) ||
+		(pool->spawncount != svs.spawncount))
+	{
+		pool->framenum = sv.framenum;
+		pool->spawncount = svs.spawncount;
+		pool->num_states = 0;
+
+		/* anything looked up so far is in another pool */
+		sv_entitysequence++;
+	}
+
+	return pool;
+}
+
+/*
+ * Returns the index of the entity state in the
+ * pool, it's added if no client got it so far.
+ */
+static int
+SV_PoolEntityState(entitypool_t *pool, edict_t *ent, int e,
+	qboolean nonsolid)
+{
+	entityslot_t *slot;
+	entity_xstate_t *state;
+
+	slot = SV_EntitySlot(e);
+
+	if (slot->sequence != sv_entitysequence)
+	{
+		slot->sequence = sv_entitysequence;
+		slot->index[0] = -1;
+		slot->index[1] = -1;
+	}
+
+	if (slot->index[nonsolid] >= 0)
+	{
+		return slot->index[nonsolid];
+	}
+
+	if (pool->num_states == pool->max_states)
+	{
+		pool->max_states = pool->max_states ? pool->max_states * 2 : 256;
+		pool->states = Z_Realloc(pool->states,
+				pool->max_states * sizeof(entity_xstate_t));
+	}
+
+	if (ent->s.number != e)
+	{
+		Com_DPrintf("FIXING ENT->S.NUMBER!!!\n");
+		ent->s.number = e;
+	}
+
+	state = &pool->states[pool->num_states];
+	SV_GetEntityState(ent, state);
+
+	if (nonsolid)
+	{
+		state->solid = 0;
+	}
+
+	slot->index[nonsolid] = pool->num_states;
+
+	return pool->num_states++;
+}
+
 /*
  * Decides which entities are going to be visible to the client, and
  * copies off the playerstat and areabits.
@@ -569,6 +759,7 @@ SV_BuildClientFrame(client_t *client)
 	edict_t *ent;
 	edict_t *clent;
 	client_frame_t *frame;
+	entitypool_t *pool;
 	int l;
 	int clientarea, clientcluster;
 	int leafnum;
@@ -585,7 +776,7 @@ SV_BuildClientFrame(client_t *client)
 	/* this is the frame we are creating */
 	frame = &client->frames[sv.framenum & UPDATE_MASK];
 
-	frame->senttime = svs.realtime; /* save it for ping calc later */
+	frame->senttime = Sys_Milliseconds(); /* save it for ping calc later */
 
 	if (IS_QII97_PROTOCOL(client->protocol))
 	{
@@ -626,11 +817,12 @@ SV_BuildClientFrame(client_t *client)
 	/* build up the list of visible entities */
 	frame->num_entities = 0;
 	frame->first_entity = svs.next_client_entities;
+	frame->framenum = sv.framenum;
+
+	pool = SV_CurrentEntityPool();
 
 	for (e = 1; e < ge->num_edicts; e++)
 	{
-		entity_xstate_t *state;
-
 		ent = EDICT_NUM(e);
 
 		/* ignore ents without visible models */
@@ -720,23 +912,11 @@ SV_BuildClientFrame(client_t *client)
 			}
 		}
 
-		/* add it to the circular client_entities array */
-		state = &svs.client_entities[svs.next_client_entities %
-				svs.num_client_entities];
-
-		if (ent->s.number != e)
-		{
-			Com_DPrintf("FIXING ENT->S.NUMBER!!!\n");
-			ent->s.number = e;
-		}
-
-		SV_GetEntityState(ent, state);
-
-		/* don't mark players missiles as solid */
-		if (ent->owner == clent)
-		{
-			state->solid = 0;
-		}
+		/* add it to the circular client_entities array, players
+		   missiles aren't marked as solid for their owner */
+		svs.client_entities[svs.next_client_entities %
+				svs.num_client_entities] =
+			SV_PoolEntityState(pool, ent, e, ent->owner == clent);
 
 		svs.next_client_entities++;
 		frame->num_entities++;
@@ -755,7 +935,6 @@ SV_RecordDemoMessage(void)
 	entity_xstate_t nostate;
 	sizebuf_t buf;
 	byte buf_data[32768];
-	int len;
 
 	if (!svs.demofile)
 	{
@@ -795,13 +974,124 @@ SV_RecordDemoMessage(void)
 
 	MSG_WriteShort(&buf, 0); /* end of packetentities */
 
-	/* now add the accumulated multicast information */
+	/* now add the accumulated multicast information,
+	   it's cleared by SV_Frame() after the relay got it */
 	SZ_Write(&buf, svs.demo_multicast.data, svs.demo_multicast.cursize);
-	SZ_Clear(&svs.demo_multicast);
 
 	/* now write the entire message to the file, prefixed by the length */
-	len = LittleLong(buf.cursize);
-	fwrite(&len, 4, 1, svs.demofile);
-	fwrite(buf.data, buf.cursize, 1, svs.demofile);
+	SV_DemoWriteMessage(&buf);
+}
+
+/*
+ * Overwrites a short written before, unless
+ * the message overflowed in between.
+ */
+static void
+SV_PatchShort(sizebuf_t *msg, int pos, int c)
+{
+	if (pos + 2 <= msg->cursize)
+	{
+		msg->data[pos] = c & 0xff;
+		msg->data[pos + 1] = (c >> 8) & 0xff;
+	}
+}
+
+/*
+ * Writes the multiview frame for the spectator relay. Unlike a client
+ * frame it holds the playerstates of all players and all entities
+ * without PVS culling, each one as a separate record. So the relay can
+ * pick the playerstate of the followed player and leave out its entity
+ * without parsing anything. Everything is sent without deltas, a lost
+ * frame is just replaced by the next one.
+ */
+void
+SV_WriteRelayFrame(sizebuf_t *msg, int protocol)
+{
+	client_frame_t frame;
+	entity_xstate_t nostate, state;
+	client_t *cl;
+	edict_t *ent;
+	int i, e, count, countpos, lenpos;
+
+	memset(&nostate, 0, sizeof(nostate));
+
+	MSG_WriteLong(msg, sv.framenum);
+
+	/* the playerstates, frozen since the
+	   viewers can't predict them */
+	countpos = msg->cursize;
+	MSG_WriteShort(msg, 0);
+	count = 0;
+
+	for (i = 0, cl = svs.clients; i < maxclients->value; i++, cl++)
+	{
+		ent = CL_EDICT(cl);
+
+		if ((cl->state != cs_spawned) || !ent->client)
+		{
+			continue;
+		}
+
+		memset(&frame, 0, sizeof(frame));
+		frame.ps = ent->client->ps;
+		frame.ps.pmove.pm_type = PM_FREEZE;
+		frame.ps.pmove.pm_flags |= PMF_NO_PREDICTION;
+
+		if (IS_QII97_PROTOCOL(protocol))
+		{
+			VectorCopy(ent->s.origin, frame.origin);
+		}
+		else
+		{
+			for (e = 0; e < 3; e++)
+			{
+				frame.origin[e] = ent->s.origin[e] * 8;
+			}
+		}
+
+		MSG_WriteByte(msg, i);
+		lenpos = msg->cursize;
+		MSG_WriteShort(msg, 0);
+		SV_WritePlayerstateToClient(NULL, &frame, msg, protocol);
+		SV_PatchShort(msg, lenpos, msg->cursize - lenpos - 2);
+
+		count++;
+	}
+
+	SV_PatchShort(msg, countpos, count);
+
+	/* the entities, same as for server demos */
+	countpos = msg->cursize;
+	MSG_WriteShort(msg, 0);
+	count = 0;
+
+	for (e = 1; e < ge->num_edicts; e++)
+	{
+		ent = EDICT_NUM(e);
+
+		if (!ent->inuse || !ent->s.number ||
+			(ent->svflags & SVF_NOCLIENT) ||
+			!(ent->s.modelindex || ent->s.effects || ent->s.sound ||
+				ent->s.event))
+		{
+			continue;
+		}
+
+		SV_GetEntityState(ent, &state);
+
+		MSG_WriteShort(msg, e);
+		lenpos = msg->cursize;
+		MSG_WriteShort(msg, 0);
+		MSG_WriteDeltaEntity(&nostate, &state, msg, false, true, protocol);
+		SV_PatchShort(msg, lenpos, msg->cursize - lenpos - 2);
+
+		count++;
+	}
+
+	SV_PatchShort(msg, countpos, count);
+
+	/* the multicasts of this frame */
+	MSG_WriteShort(msg, svs.demo_multicast.cursize);
+	SZ_Write(msg, svs.demo_multicast.data, svs.demo_multicast.cursize);
 }
 
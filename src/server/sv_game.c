@@ -214,7 +214,20 @@ PF_Configstring(int index, const char *val)
 	}
 
 	/* change the string in sv */
+	SV_UnhashConfigstring(internal_index);
 	strcpy(sv.configstrings[internal_index], val);
+	sv.configstrings_version++;
+
+	/* long strings like the statusbar run
+	   into the following configstrings */
+	if (strlen(val) >= MAX_CONFIGSTRING)
+	{
+		SV_RehashConfigstrings();
+	}
+	else
+	{
+		SV_HashConfigstring(internal_index);
+	}
 
 	if (sv.state != ss_loading)
 	{
@@ -499,6 +512,8 @@ SV_InitGameProgs(void)
 	import.unlinkentity = SV_UnlinkEdict;
 	import.BoxEdicts = SV_AreaEdicts;
 	import.trace = SV_Trace;
+	import.TraceReentrant = SV_TraceReentrant;
+	import.RunParallel = SV_RunParallel;
 	import.pointcontents = SV_PointContents;
 	import.setmodel = PF_setmodel;
 	import.inPVS = PF_inPVS;
@@ -556,6 +571,10 @@ SV_InitGameProgs(void)
 	import.LocalizationUIMessage = SV_LocalizationUIMessage;
 	import.TagRealloc = Z_TagRealloc;
 
+	/* tells the game how many of the imports are there */
+	Cvar_FullSet(GAME_IMPORT_SIZE_CVAR, va("%i", (int)sizeof(import)),
+			CVAR_NOSET);
+
 	ge = (game_export_t *)Sys_GetGameAPI(&import);
 
 	if (!ge)
@@ -56,10 +56,89 @@ SV_AllocBaseline(int entnum)
 	return &sv.baselines[entnum];
 }
 
+static unsigned
+SV_ConfigstringHash(const char *name)
+{
+	unsigned hash = 0;
+
+	while (*name)
+	{
+		hash = hash * 31 + (byte)*name++;
+	}
+
+	return hash & (CS_HASH_SIZE - 1);
+}
+
+/*
+ * Adds a configstring to the name hash, must
+ * be called after the string was changed.
+ */
+void
+SV_HashConfigstring(int index)
+{
+	unsigned hash;
+
+	if (!sv.configstrings[index][0])
+	{
+		return;
+	}
+
+	hash = SV_ConfigstringHash(sv.configstrings[index]);
+	sv.configstrings_hashnext[index] = sv.configstrings_hash[hash];
+	sv.configstrings_hash[hash] = index + 1;
+}
+
+/*
+ * Removes a configstring from the name hash, must
+ * be called before the string is changed.
+ */
+void
+SV_UnhashConfigstring(int index)
+{
+	unsigned short *link;
+
+	if (!sv.configstrings[index][0])
+	{
+		return;
+	}
+
+	link = &sv.configstrings_hash[SV_ConfigstringHash(sv.configstrings[index])];
+
+	while (*link)
+	{
+		if (*link == index + 1)
+		{
+			*link = sv.configstrings_hashnext[index];
+			sv.configstrings_hashnext[index] = 0;
+			return;
+		}
+
+		link = &sv.configstrings_hashnext[*link - 1];
+	}
+}
+
+/*
+ * Rebuilds the name hash after the configstrings
+ * were written directly, e.g. by loading a savegame.
+ */
+void
+SV_RehashConfigstrings(void)
+{
+	int i;
+
+	memset(sv.configstrings_hash, 0, sizeof(sv.configstrings_hash));
+	memset(sv.configstrings_hashnext, 0, sizeof(sv.configstrings_hashnext));
+
+	for (i = 0; i < MAX_CONFIGSTRINGS; i++)
+	{
+		SV_HashConfigstring(i);
+	}
+}
+
 static int
 SV_FindIndex(const char *name, int start, int max, qboolean create)
 {
-	int i, protocol;
+	int i, index, found, protocol;
 
 	if (!name || !name[0])
 	{
@@ -68,19 +147,35 @@ SV_FindIndex(const char *name, int start, int max, qboolean create)
 
 	protocol = sv_client ? sv_client->protocol : PROTOCOL_VERSION;
 
-	for (i = 1; i < max && sv.configstrings[start + i][0]; i++)
+	/* the same name can be in several ranges, or even
+	   twice in one if set by the game. Take the lowest. */
+	found = max;
+
+	for (index = sv.configstrings_hash[SV_ConfigstringHash(name)]; index;
+		 index = sv.configstrings_hashnext[index - 1])
 	{
-		if (!strcmp(sv.configstrings[start + i], name))
+		i = index - 1 - start;
+
+		if ((i > 0) && (i < found) && !strcmp(sv.configstrings[index - 1], name))
 		{
-			return i;
+			found = i;
 		}
 	}
 
+	if (found < max)
+	{
+		return found;
+	}
+
 	if (!create)
 	{
 		return 0;
 	}
 
+	for (i = 1; i < max && sv.configstrings[start + i][0]; i++)
+	{
+	}
+
 	if (i == max)
 	{
 		if (!StringList_IsInList(&sv.configstrings_overflow, name))
@@ -97,6 +192,8 @@ SV_FindIndex(const char *name, int start, int max, qboolean create)
 	}
 
 	Q_strlcpy(sv.configstrings[start + i], name, sizeof(sv.configstrings[start + i]));
+	SV_HashConfigstring(start + i);
+	sv.configstrings_version++;
 
 	if (sv.state != ss_loading)
 	{
@@ -342,6 +439,9 @@ SV_SpawnServer(char *server, char *spawnpoint, server_state_t serverstate,
 		sv.models[i + 1] = CM_InlineModel(sv.configstrings[CS_MODELS + 1 + i]);
 	}
 
+	/* the strings above were written directly */
+	SV_RehashConfigstrings();
+
 	/* spawn the rest of the entities on the map */
 	sv.state = ss_loading;
 	Com_SetServerState(sv.state);
@@ -526,7 +626,11 @@ SV_InitGame(void)
 	svs.spawncount = randk();
 	svs.clients = Z_Malloc(sizeof(client_t) * maxclients->value);
 	svs.num_client_entities = maxclients->value * UPDATE_BACKUP * 64;
-	svs.client_entities = Z_Malloc( sizeof(entity_xstate_t) * svs.num_client_entities);
+	svs.client_entities = Z_Malloc(sizeof(int) * svs.num_client_entities);
+
+	/* catches all multicasts for server demos and relays */
+	SZ_Init(&svs.demo_multicast, svs.demo_multicast_buf,
+			sizeof(svs.demo_multicast_buf));
 
 	/* init network stuff */
 	if (dedicated->value)
@@ -55,6 +55,33 @@ cvar_t *public_server; /* should heartbeats be sent */
 cvar_t *sv_entfile; /* External entity files. */
 cvar_t *sv_downloadserver; /* Download server. */
 cvar_t *sv_language; /* Server message language. */
+cvar_t *sv_ratelimit; /* connectionless packets per second and address */
+cvar_t *sv_ratelimit_burst;
+cvar_t *sv_compressframes; /* compress frames bigger than this */
+static cvar_t *sv_pacing; /* dedicated server blocks until the next frame */
+
+/* sub millisecond part of the server time, only used if paced */
+static int sv_frameusec;
+
+/* seconds without clients before the game is suspended */
+static cvar_t *sv_hibernate;
+static int sv_lastactive; /* svs.realtime a client was last seen */
+static qboolean sv_hibernating;
+
+/* msec to sleep between checks while hibernating,
+   packets still wake the server immediately */
+#define HIBERNATE_SLEEP 1000
+
+/* Only q2ded has the paced main loop */
+static qboolean
+SV_Paced(void)
+{
+#ifdef DEDICATED_ONLY
+	return sv_pacing->value != 0;
+#else
+	return false;
+#endif
+}
 
 /*
  * Called when the player is totally leaving the server, either willingly
@@ -74,11 +101,7 @@ SV_DropClient(client_t *drop)
 		ge->ClientDisconnect(CL_EDICT(drop));
 	}
 
-	if (drop->download)
-	{
-		FS_FreeFile(drop->download);
-		drop->download = NULL;
-	}
+	SV_CloseDownload(drop);
 
 	drop->state = cs_zombie; /* become free in a few seconds */
 	drop->name[0] = 0;
@@ -92,11 +115,23 @@ SV_StatusString(void)
 {
 	char player[1024];
 	static char status[MAX_MSGLEN - 16];
+	static int status_spawncount, status_framenum = -1;
 	int i;
 	client_t *cl;
 	int statusLength;
 	int playerLength;
 
+	/* status queries can come in floods, build
+	   the string at most once per server frame */
+	if ((status_framenum == sv.framenum) &&
+		(status_spawncount == svs.spawncount) && sv.state)
+	{
+		return status;
+	}
+
+	status_framenum = sv.framenum;
+	status_spawncount = svs.spawncount;
+
 	strcpy(status, Cvar_Serverinfo());
 	Q_strlcat(status, "\n", sizeof(status));
 	statusLength = (int)strlen(status);
@@ -367,6 +402,64 @@ SV_RunGameFrame(void)
 #endif
 }
 
+/*
+ * Returns true if the game should be suspended, because no
+ * client was connected for sv_hibernate seconds. The game time
+ * stands still while hibernating, the server clock moves on.
+ */
+static qboolean
+SV_CheckHibernate(void)
+{
+	qboolean active;
+	int i;
+
+	active = (sv_hibernate->value <= 0) || (sv.state != ss_game) ||
+		svs.demofile || (sv_lastactive > svs.realtime);
+
+	for (i = 0; i < maxclients->value && !active; i++)
+	{
+		if (svs.clients[i].state != cs_free)
+		{
+			active = true;
+		}
+	}
+
+	if (active)
+	{
+		sv_lastactive = svs.realtime;
+
+		if (sv_hibernating)
+		{
+			Com_Printf("Client connected, leaving hibernation.\n");
+			sv_hibernating = false;
+		}
+
+		return false;
+	}
+
+	if (svs.realtime - sv_lastactive < sv_hibernate->value * 1000)
+	{
+		return false;
+	}
+
+	if (!sv_hibernating)
+	{
+		Com_Printf("No clients for %i seconds, hibernating.\n",
+				(int)sv_hibernate->value);
+		sv_hibernating = true;
+	}
+
+	/* keep the frame clock in step, so there's
+	   nothing to catch up when a client connects */
+	if (svs.realtime / 100 > sv.framenum)
+	{
+		sv.framenum = svs.realtime / 100;
+		sv.time = sv.framenum * 100;
+	}
+
+	return true;
+}
+
 int
 SV_Optimizations(void)
 {
@@ -398,8 +491,22 @@ SV_Frame(int usec)
 		return;
 	}
 
+	/* the paced loop wakes up right in time, so
+	   keep the remainder to not lose time */
+	if (SV_Paced())
+	{
+		usec += sv_frameusec;
+		sv_frameusec = usec % 1000;
+	}
+	else
+	{
+		sv_frameusec = 0;
+	}
+
 	svs.realtime += usec / 1000;
 
+	SV_ProfileBegin(SVP_FRAME);
+
 	/* keep the random time dependent */
 	randk();
 
@@ -407,7 +514,9 @@ SV_Frame(int usec)
 	SV_CheckTimeouts();
 
 	/* get packets from clients */
+	SV_ProfileBegin(SVP_READPACKETS);
 	SV_ReadPackets();
+	SV_ProfileEnd(SVP_READPACKETS);
 
 	/* send messages more often to new clients getting ready for spawning in
 	   speeds up the process of sending configstrings, entty deltas, etc.
@@ -416,7 +525,23 @@ SV_Frame(int usec)
 
 	if (opt_sendrate)
 	{
+		SV_ProfileBegin(SVP_SENDPREPCLIENTMESSAGES);
 		SV_SendPrepClientMessages();
+		SV_ProfileEnd(SVP_SENDPREPCLIENTMESSAGES);
+	}
+
+	/* nobody there, only answer packets */
+	if (SV_CheckHibernate())
+	{
+		Master_Heartbeat();
+		SV_ProfileEnd(SVP_FRAME);
+
+		if (!SV_Paced())
+		{
+			NET_Sleep(HIBERNATE_SLEEP);
+		}
+
+		return;
 	}
 
 	/* move autonomous things around if enough time has passed */
@@ -433,7 +558,16 @@ SV_Frame(int usec)
 			svs.realtime = sv.time - 100;
 		}
 
-		NET_Sleep(sv.time - svs.realtime);
+		/* the phases above are accounted to the next
+		   simulated frame, the sleep isn't */
+		SV_ProfileEnd(SVP_FRAME);
+
+		/* if paced the main loop sleeps, see SV_FrameWait() */
+		if (!SV_Paced())
+		{
+			NET_Sleep(sv.time - svs.realtime);
+		}
+
 		return;
 	}
 
@@ -444,25 +578,67 @@ SV_Frame(int usec)
 	SV_GiveMsec();
 
 	/* let everything in the world think and move */
+	SV_ProfileBegin(SVP_RUNGAMEFRAME);
 	SV_RunGameFrame();
+	SV_ProfileEnd(SVP_RUNGAMEFRAME);
 
 	/* send messages back to the clients that had packets read this frame */
+	SV_ProfileBegin(SVP_SENDCLIENTMESSAGES);
 	SV_SendClientMessages();
+	SV_ProfileEnd(SVP_SENDCLIENTMESSAGES);
 
 	/* if not optimizing, send all messages here */
 	if (!opt_sendrate)
 	{
+		SV_ProfileBegin(SVP_SENDPREPCLIENTMESSAGES);
 		SV_SendPrepClientMessages();
+		SV_ProfileEnd(SVP_SENDPREPCLIENTMESSAGES);
 	}
 
 	/* save the entire world state if recording a serverdemo */
+	SV_ProfileBegin(SVP_RECORDDEMOMESSAGE);
 	SV_RecordDemoMessage();
+	SV_ProfileEnd(SVP_RECORDDEMOMESSAGE);
+
+	/* send the multiview frame to the spectator relays */
+	SV_ProfileBegin(SVP_RELAYFRAME);
+	SV_RelayFrame();
+	SV_ProfileEnd(SVP_RELAYFRAME);
+
+	SZ_Clear(&svs.demo_multicast);
 
 	/* send a heartbeat to the master if needed */
 	Master_Heartbeat();
 
 	/* clear teleport flags, etc for next frame */
 	SV_PrepWorldFrame();
+
+	SV_ProfileEnd(SVP_FRAME);
+	SV_ProfileFrame();
+}
+
+/*
+ * Returns the microseconds until the next server frame
+ * is due, or -1 if the main loop shouldn't block on it.
+ */
+int
+SV_FrameWait(void)
+{
+	int wait;
+
+	if (!svs.initialized || !SV_Paced() || sv_timedemo->value)
+	{
+		return -1;
+	}
+
+	if (sv_hibernating)
+	{
+		return HIBERNATE_SLEEP * 1000;
+	}
+
+	wait = (sv.time - svs.realtime) * 1000 - sv_frameusec;
+
+	return (wait > 0) ? wait : 0;
 }
 
 /*
@@ -602,6 +778,10 @@ SV_Init(void)
 {
 	SV_SendInitBuffers();
 	SV_InitOperatorCommands();
+	SV_ProfileInit();
+	SV_DemoInit();
+	SV_RelayInit();
+	SV_InitWorkers();
 
 	sv_optimize_sp_loadtime = Cvar_Get("sv_optimize_sp_loadtime", "7", 0);
 	sv_optimize_mp_loadtime = Cvar_Get("sv_optimize_mp_loadtime", "0", 0);
@@ -631,6 +811,11 @@ SV_Init(void)
 	allow_download_maps = Cvar_Get("allow_download_maps", "1", CVAR_ARCHIVE);
 	sv_downloadserver = Cvar_Get("sv_downloadserver", "", 0);
 	sv_language = Cvar_Get("language", "english", CVAR_ARCHIVE);
+	sv_ratelimit = Cvar_Get("sv_ratelimit", "10", 0);
+	sv_ratelimit_burst = Cvar_Get("sv_ratelimit_burst", "20", 0);
+	sv_pacing = Cvar_Get("sv_pacing", "0", 0);
+	sv_hibernate = Cvar_Get("sv_hibernate", "0", 0);
+	sv_compressframes = Cvar_Get("sv_compressframes", "0", 0);
 
 	sv_noreload = Cvar_Get("sv_noreload", "0", 0);
 
@@ -719,6 +904,8 @@ SV_ClearBaselines(void)
 void
 SV_Shutdown(char *finalmsg, qboolean reconnect)
 {
+	int i;
+
 	if (svs.clients)
 	{
 		SV_FinalMessage(finalmsg, reconnect);
@@ -726,6 +913,8 @@ SV_Shutdown(char *finalmsg, qboolean reconnect)
 
 	Master_Shutdown();
 	SV_ShutdownGameProgs();
+	SV_StopWorkers();
+	SV_ProfileShutdown();
 
 	/* free current level */
 	if (sv.demofile)
@@ -742,8 +931,18 @@ SV_Shutdown(char *finalmsg, qboolean reconnect)
 	sv_client = NULL;
 
 	/* free server static data */
+	SV_FreeDownloads();
+
 	if (svs.clients)
 	{
+		for (i = 0; i < maxclients->value; i++)
+		{
+			if (svs.clients[i].zdict)
+			{
+				Z_Free(svs.clients[i].zdict);
+			}
+		}
+
 		Z_Free(svs.clients);
 	}
 
@@ -752,10 +951,10 @@ SV_Shutdown(char *finalmsg, qboolean reconnect)
 		Z_Free(svs.client_entities);
 	}
 
-	if (svs.demofile)
-	{
-		fclose(svs.demofile);
-	}
+	SV_FreeEntityPools();
+
+	SV_DemoClose();
+	SV_FreeGamestate();
 
 	memset(&svs, 0, sizeof(svs));
 
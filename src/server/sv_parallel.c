@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 1997-2001 Id Software, Inc.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+ * 02111-1307, USA.
+ *
+ *
+ * =======================================================================
+ *
+ * Worker threads for the game. SV_RunParallel() runs a function for
+ * a number of indices on the workers and on the main thread and
+ * returns when all of them are done. The game uses it for stages
+ * that only read the world, so the function may only call engine
+ * functions that are reentrant like SV_TraceReentrant().
+ *
+ * =======================================================================
+ */
+
+#include "header/server.h"
+
+#define MAX_SV_WORKERS 16
+
+typedef struct
+{
+	sys_mutex_t *mutex;
+	sys_cond_t *cond;
+	sys_thread_t *threads[MAX_SV_WORKERS];
+	int numthreads;
+	qboolean quit;
+
+	/* the current run */
+	void (*func)(void *data, int index);
+	void *data;
+	int count;
+	int next; /* next index to take */
+	int running; /* workers still in this run */
+	int run; /* counts the runs */
+} workerpool_t;
+
+static workerpool_t sv_pool;
+static cvar_t *sv_workers;
+
+/*
+ * Runs indices until there are no more. The
+ * mutex is held when called and on return.
+ */
+static void
+SV_RunIndices(void)
+{
+	int index;
+
+	while (sv_pool.next < sv_pool.count)
+	{
+		index = sv_pool.next++;
+
+		Sys_UnlockMutex(sv_pool.mutex);
+		sv_pool.func(sv_pool.data, index);
+		Sys_LockMutex(sv_pool.mutex);
+	}
+}
+
+static void
+SV_WorkerThread(void *arg)
+{
+	int run = 0;
+
+	Sys_LockMutex(sv_pool.mutex);
+
+	while (1)
+	{
+		while (!sv_pool.quit && (sv_pool.run == run))
+		{
+			Sys_WaitCond(sv_pool.cond, sv_pool.mutex);
+		}
+
+		if (sv_pool.quit)
+		{
+			break;
+		}
+
+		run = sv_pool.run;
+
+		SV_RunIndices();
+
+		sv_pool.running--;
+
+		if (!sv_pool.running)
+		{
+			Sys_SignalCond(sv_pool.cond);
+		}
+	}
+
+	Sys_UnlockMutex(sv_pool.mutex);
+}
+
+void
+SV_StopWorkers(void)
+{
+	int i;
+
+	if (!sv_pool.mutex)
+	{
+		return;
+	}
+
+	Sys_LockMutex(sv_pool.mutex);
+	sv_pool.quit = true;
+	Sys_SignalCond(sv_pool.cond);
+	Sys_UnlockMutex(sv_pool.mutex);
+
+	for (i = 0; i < sv_pool.numthreads; i++)
+	{
+		Sys_WaitThread(sv_pool.threads[i]);
+	}
+
+	Sys_DestroyCond(sv_pool.cond);
+	Sys_DestroyMutex(sv_pool.mutex);
+
+	memset(&sv_pool, 0, sizeof(sv_pool));
+}
+
+static void
+SV_StartWorkers(void)
+{
+	int i, num;
+
+	num = Q_clamp((int)sv_workers->value, 0, MAX_SV_WORKERS);
+
+	if (!num)
+	{
+		return;
+	}
+
+	sv_pool.mutex = Sys_CreateMutex();
+	sv_pool.cond = Sys_CreateCond();
+
+	if (!sv_pool.mutex || !sv_pool.cond)
+	{
+		SV_StopWorkers();
+		return;
+	}
+
+	for (i = 0; i < num; i++)
+	{
+		sv_pool.threads[i] = Sys_CreateThread(SV_WorkerThread, NULL);
+
+		if (!sv_pool.threads[i])
+		{
+			break;
+		}
+
+		sv_pool.numthreads++;
+	}
+
+	if (!sv_pool.numthreads)
+	{
+		SV_StopWorkers();
+		return;
+	}
+
+	Com_DPrintf("%s: %i worker threads\n", __func__, sv_pool.numthreads);
+}
+
+/*
+ * Calls func(data, index) for every index below count, spread
+ * over the workers, and returns when all calls are done.
+ */
+void
+SV_RunParallel(void (*func)(void *data, int index), void *data, int count)
+{
+	int i;
+
+	if (!func || (count <= 0))
+	{
+		return;
+	}
+
+	if (sv_workers->modified)
+	{
+		sv_workers->modified = false;
+
+		SV_StopWorkers();
+		SV_StartWorkers();
+	}
+
+	if (!sv_pool.numthreads)
+	{
+		for (i = 0; i < count; i++)
+		{
+			func(data, i);
+		}
+
+		return;
+	}
+
+	Sys_LockMutex(sv_pool.mutex);
+
+	sv_pool.func = func;
+	sv_pool.data = data;
+	sv_pool.count = count;
+	sv_pool.next = 0;
+	sv_pool.running = sv_pool.numthreads;
+	sv_pool.run++;
+
+	Sys_SignalCond(sv_pool.cond);
+
+	/* the main thread helps out */
+	SV_RunIndices();
+
+	while (sv_pool.running)
+	{
+		Sys_WaitCond(sv_pool.cond, sv_pool.mutex);
+	}
+
+	sv_pool.func = NULL;
+	sv_pool.data = NULL;
+
+	Sys_UnlockMutex(sv_pool.mutex);
+}
+
+void
+SV_InitWorkers(void)
+{
+	sv_workers = Cvar_Get("sv_workers", "2", CVAR_ARCHIVE);
+
+	/* started with the first run */
+	sv_workers->modified = true;
+}
@@ -0,0 +1,290 @@
+/*
+ * Copyright (C) 1997-2001 Id Software, Inc.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+ * 02111-1307, USA.
+ *
+ * =======================================================================
+ *
+ * Server frame profiler. Times the phases of SV_Frame() and keeps
+ * the last SV_PROFILE_SAMPLES server frames around. Reported by the
+ * 'serverprofile' command and optionally logged into a CSV file.
+ *
+ * =======================================================================
+ */
+
+#include "header/server.h"
+
+/* ~100 seconds at 10hz, must be a power of two */
+#define SV_PROFILE_SAMPLES 1024
+
+static const char *sv_profile_names[SVP_NUM_PHASES] = {
+	"readpackets",
+	"rungameframe",
+	"sendclientmessages",
+	"sendprepclientmessages",
+	"recorddemomessage",
+	"relayframe",
+	"compressframes",
+	"frame"
+};
+
+static cvar_t *sv_profile;
+static cvar_t *sv_profile_log;
+
+/* time spent in each phase during the current server frame */
+static long long sv_profile_start[SVP_NUM_PHASES];
+static int sv_profile_accum[SVP_NUM_PHASES];
+
+/* ring of per frame samples in microseconds */
+static int sv_profile_samples[SVP_NUM_PHASES][SV_PROFILE_SAMPLES];
+static unsigned sv_profile_frames;
+
+static FILE *sv_profile_logfile;
+static unsigned sv_profile_logframes;
+static int sv_profile_lastlog;
+
+void
+SV_ProfileBegin(svprofile_phase_t phase)
+{
+	if (!sv_profile->value)
+	{
+		return;
+	}
+
+	sv_profile_start[phase] = Sys_Microseconds();
+}
+
+void
+SV_ProfileEnd(svprofile_phase_t phase)
+{
+	if (!sv_profile->value || !sv_profile_start[phase])
+	{
+		return;
+	}
+
+	sv_profile_accum[phase] += (int)(Sys_Microseconds() - sv_profile_start[phase]);
+	sv_profile_start[phase] = 0;
+}
+
+static int
+SV_ProfileCompare(const void *a, const void *b)
+{
+	return *(const int *)a - *(const int *)b;
+}
+
+/*
+ * Calculates the median, the 99th percentile and
+ * the maximum over the last 'count' frames.
+ */
+static void
+SV_ProfileStats(svprofile_phase_t phase, unsigned count,
+		int *p50, int *p99, int *max)
+{
+	static int sorted[SV_PROFILE_SAMPLES];
+	unsigned i;
+
+	if (count > sv_profile_frames)
+	{
+		count = sv_profile_frames;
+	}
+
+	if (count > SV_PROFILE_SAMPLES)
+	{
+		count = SV_PROFILE_SAMPLES;
+	}
+
+	if (!count)
+	{
+		*p50 = *p99 = *max = 0;
+		return;
+	}
+
+	for (i = 0; i < count; i++)
+	{
+		sorted[i] = sv_profile_samples[phase]
+			[(sv_profile_frames - count + i) & (SV_PROFILE_SAMPLES - 1)];
+	}
+
+	qsort(sorted, count, sizeof(int), SV_ProfileCompare);
+
+	*p50 = sorted[(count - 1) * 50 / 100];
+	*p99 = sorted[(count - 1) * 99 / 100];
+	*max = sorted[count - 1];
+}
+
+static void
+SV_ProfileCloseLog(void)
+{
+	if (sv_profile_logfile)
+	{
+		fclose(sv_profile_logfile);
+		sv_profile_logfile = NULL;
+	}
+}
+
+static void
+SV_ProfileWriteLog(void)
+{
+	char name[MAX_OSPATH];
+	int i, p50, p99, max;
+	unsigned count;
+	int now;
+
+	now = Sys_Milliseconds();
+
+	if (!sv_profile_logfile)
+	{
+		Com_sprintf(name, sizeof(name), "%s/sv_profile.csv", FS_Gamedir());
+		FS_CreatePath(name);
+
+		sv_profile_logfile = Q_fopen(name, "a");
+
+		if (!sv_profile_logfile)
+		{
+			Com_Printf("%s: couldn't open %s, disabling log\n", __func__, name);
+			Cvar_Set("sv_profile_log", "0");
+			return;
+		}
+
+		/* header only for new files */
+		fseek(sv_profile_logfile, 0, SEEK_END);
+
+		if (ftell(sv_profile_logfile) == 0)
+		{
+			fprintf(sv_profile_logfile, "time,map,frames");
+
+			for (i = 0; i < SVP_NUM_PHASES; i++)
+			{
+				fprintf(sv_profile_logfile, ",%s_p50,%s_p99,%s_max",
+						sv_profile_names[i], sv_profile_names[i],
+						sv_profile_names[i]);
+			}
+
+			fprintf(sv_profile_logfile, "\n");
+		}
+
+		sv_profile_lastlog = now;
+		sv_profile_logframes = sv_profile_frames;
+		return;
+	}
+
+	if (now - sv_profile_lastlog < sv_profile_log->value * 1000)
+	{
+		return;
+	}
+
+	/* only the frames since the last line */
+	count = sv_profile_frames - sv_profile_logframes;
+
+	fprintf(sv_profile_logfile, "%i,%s,%u", now, sv.name, count);
+
+	for (i = 0; i < SVP_NUM_PHASES; i++)
+	{
+		SV_ProfileStats(i, count, &p50, &p99, &max);
+		fprintf(sv_profile_logfile, ",%i,%i,%i", p50, p99, max);
+	}
+
+	fprintf(sv_profile_logfile, "\n");
+	fflush(sv_profile_logfile);
+
+	sv_profile_lastlog = now;
+	sv_profile_logframes = sv_profile_frames;
+}
+
+/*
+ * Called at the end of each simulated server frame,
+ * commits the accumulated phase times as one sample.
+ */
+void
+SV_ProfileFrame(void)
+{
+	int i;
+
+	if (!sv_profile->value)
+	{
+		SV_ProfileCloseLog();
+		return;
+	}
+
+	for (i = 0; i < SVP_NUM_PHASES; i++)
+	{
+		sv_profile_samples[i][sv_profile_frames & (SV_PROFILE_SAMPLES - 1)] =
+			sv_profile_accum[i];
+		sv_profile_accum[i] = 0;
+	}
+
+	sv_profile_frames++;
+
+	if (sv_profile_log->value > 0)
+	{
+		SV_ProfileWriteLog();
+	}
+	else
+	{
+		SV_ProfileCloseLog();
+	}
+}
+
+static void
+SV_ServerProfile_f(void)
+{
+	int i, p50, p99, max;
+
+	if ((Cmd_Argc() == 2) && !strcmp(Cmd_Argv(1), "reset"))
+	{
+		memset(sv_profile_samples, 0, sizeof(sv_profile_samples));
+		sv_profile_frames = 0;
+		sv_profile_logframes = 0;
+		Com_Printf("Server profile reset.\n");
+		return;
+	}
+
+	if (!sv_profile->value)
+	{
+		Com_Printf("Profiling is disabled, set sv_profile to 1.\n");
+		return;
+	}
+
+	Com_Printf("Last %u server frames, times in usec:\n",
+			(sv_profile_frames < SV_PROFILE_SAMPLES) ?
+				sv_profile_frames : SV_PROFILE_SAMPLES);
+	Com_Printf("phase                       p50      p99      max\n");
+	Com_Printf("------------------------ -------- -------- --------\n");
+
+	for (i = 0; i < SVP_NUM_PHASES; i++)
+	{
+		SV_ProfileStats(i, SV_PROFILE_SAMPLES, &p50, &p99, &max);
+		Com_Printf("%-24s %8i %8i %8i\n", sv_profile_names[i], p50, p99, max);
+	}
+}
+
+void
+SV_ProfileInit(void)
+{
+	sv_profile = Cvar_Get("sv_profile", "0", 0);
+	sv_profile_log = Cvar_Get("sv_profile_log", "0", 0);
+
+	Cmd_AddCommand("serverprofile", SV_ServerProfile_f);
+}
+
+void
+SV_ProfileShutdown(void)
+{
+	SV_ProfileCloseLog();
+	memset(sv_profile_start, 0, sizeof(sv_profile_start));
+	memset(sv_profile_accum, 0, sizeof(sv_profile_accum));
+}
@@ -0,0 +1,303 @@
+/*
+ * Copyright (C) 1997-2001 Id Software, Inc.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+ * 02111-1307, USA.
+ *
+ * =======================================================================
+ *
+ * Spectator relay stream. A relay (q2relay) subscribes with the relay
+ * password and gets one multiview frame per server frame, holding all
+ * players and all entities. The relay fans it out to its viewers, so
+ * spectators don't cost the server more than this one frame. Frames
+ * are sent without deltas and the relay pulls the gamestate on its
+ * own, so everything here are plain connectionless packets:
+ *
+ *  relay <password>            subscribe, or keep the subscription
+ *  relaysignon <part> <start>  gamestate, part 0 is the serverdata,
+ *                              1 the configstrings
+ *
+ * There are no baselines, the entities are sent as if they were zero
+ * before, like in server demos. A frame is sent in FRAGMENT_SIZE parts,
+ * each with the frame number, its offset and the frame size. A lost
+ * part loses the frame.
+ *
+ * =======================================================================
+ */
+
+#include "header/server.h"
+
+#define MAX_RELAYS 4
+#define RELAY_TIMEOUT 15000 /* msec without a keepalive */
+
+/* a chunk must fit into one message to a viewer */
+#define RELAY_SIGNON_LIMIT (MAX_MSGLEN - 1024)
+
+typedef struct
+{
+	qboolean active;
+	netadr_t adr;
+	int lastseen;
+} relay_t;
+
+static relay_t sv_relays[MAX_RELAYS];
+static int sv_numrelays;
+static int sv_relay_overflowed; /* spawncount of the last warning */
+
+static cvar_t *sv_relay_password;
+
+static byte sv_relay_buf[MAX_MSGLEN];
+static byte sv_relay_frame[MAX_RELAY_FRAME];
+
+qboolean
+SV_RelayActive(void)
+{
+	return sv_numrelays > 0;
+}
+
+qboolean
+SV_IsRelay(netadr_t adr)
+{
+	int i;
+
+	if (!sv_numrelays)
+	{
+		return false;
+	}
+
+	for (i = 0; i < MAX_RELAYS; i++)
+	{
+		if (sv_relays[i].active && NET_CompareAdr(sv_relays[i].adr, adr))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+ * Subscribes a relay. Relays resend this every
+ * few seconds, the answer tells them we're alive.
+ */
+void
+SVC_Relay(void)
+{
+	relay_t *r, *slot;
+	int i;
+
+	if (!sv_relay_password->string[0] ||
+		strcmp(Cmd_Argv(1), sv_relay_password->string))
+	{
+		Com_Printf("Bad relay password from %s\n", NET_AdrToString(net_from));
+		Netchan_OutOfBandPrint(NS_SERVER, net_from,
+				"print\nBad relay password.\n");
+		return;
+	}
+
+	slot = NULL;
+
+	for (i = 0, r = sv_relays; i < MAX_RELAYS; i++, r++)
+	{
+		if (r->active && NET_CompareAdr(r->adr, net_from))
+		{
+			slot = r;
+			break;
+		}
+
+		if (!r->active && !slot)
+		{
+			slot = r;
+		}
+	}
+
+	if (!slot)
+	{
+		Netchan_OutOfBandPrint(NS_SERVER, net_from,
+				"print\nToo many relays.\n");
+		return;
+	}
+
+	if (!slot->active)
+	{
+		Com_Printf("Relay %s subscribed\n", NET_AdrToString(net_from));
+
+		slot->active = true;
+		slot->adr = net_from;
+		sv_numrelays++;
+	}
+
+	slot->lastseen = Sys_Milliseconds();
+
+	Netchan_OutOfBandPrint(NS_SERVER, net_from, "relay_ok %i",
+			svs.spawncount);
+}
+
+static void
+SV_RelayPatchLong(sizebuf_t *msg, int pos, int c)
+{
+	msg->data[pos] = c & 0xff;
+	msg->data[pos + 1] = (c >> 8) & 0xff;
+	msg->data[pos + 2] = (c >> 16) & 0xff;
+	msg->data[pos + 3] = (c >> 24) & 0xff;
+}
+
+/*
+ * Answers a gamestate request of a relay with a header
+ * and as many items from start on as fit into a chunk:
+ * spawncount, configstrings version, part, start, next,
+ * total, followed by the items.
+ */
+void
+SVC_RelaySignon(void)
+{
+	sizebuf_t msg;
+	int part, start, next, total, protocol, pos;
+
+	if (!SV_IsRelay(net_from) || (sv.state != ss_game))
+	{
+		return;
+	}
+
+	part = (int)strtol(Cmd_Argv(1), (char **)NULL, 10);
+	start = (int)strtol(Cmd_Argv(2), (char **)NULL, 10);
+
+	if (start < 0)
+	{
+		start = 0;
+	}
+
+	protocol = SV_GetRecomendedProtocol();
+
+	SZ_Init(&msg, sv_relay_buf, sizeof(sv_relay_buf));
+
+	MSG_WriteLong(&msg, -1);
+	SZ_Write(&msg, "relaysignon\n", 12);
+	MSG_WriteLong(&msg, svs.spawncount);
+	MSG_WriteLong(&msg, sv.configstrings_version);
+	MSG_WriteByte(&msg, part);
+	MSG_WriteLong(&msg, start);
+
+	/* next and total are filled in below */
+	pos = msg.cursize;
+	MSG_WriteLong(&msg, 0);
+	MSG_WriteLong(&msg, 0);
+
+	switch (part)
+	{
+		case 0:
+			MSG_WriteLong(&msg, protocol);
+			MSG_WriteString(&msg, (char *)Cvar_VariableString("gamedir"));
+			MSG_WriteString(&msg, sv.configstrings[CS_NAME]);
+			next = total = 1;
+			break;
+
+		case 1:
+			next = SV_WriteConfigstrings(&msg, protocol, start,
+					RELAY_SIGNON_LIMIT);
+			total = MAX_CONFIGSTRINGS;
+			break;
+
+		default:
+			return;
+	}
+
+	SV_RelayPatchLong(&msg, pos, next);
+	SV_RelayPatchLong(&msg, pos + 4, total);
+
+	NET_SendPacket(NS_SERVER, msg.cursize, msg.data, net_from);
+}
+
+/*
+ * Sends the multiview frame to all relays,
+ * called once per server frame.
+ */
+void
+SV_RelayFrame(void)
+{
+	sizebuf_t frame, msg;
+	relay_t *r;
+	int i, now, offset, len;
+
+	if (!sv_numrelays)
+	{
+		return;
+	}
+
+	now = Sys_Milliseconds();
+
+	for (i = 0, r = sv_relays; i < MAX_RELAYS; i++, r++)
+	{
+		if (r->active && (now - r->lastseen > RELAY_TIMEOUT))
+		{
+			Com_Printf("Relay %s timed out\n", NET_AdrToString(r->adr));
+
+			r->active = false;
+			sv_numrelays--;
+		}
+	}
+
+	if (!sv_numrelays || (sv.state != ss_game))
+	{
+		return;
+	}
+
+	SZ_Init(&frame, sv_relay_frame, sizeof(sv_relay_frame));
+	frame.allowoverflow = true;
+
+	SV_WriteRelayFrame(&frame, SV_GetRecomendedProtocol());
+
+	if (frame.overflowed)
+	{
+		if (sv_relay_overflowed != svs.spawncount)
+		{
+			Com_Printf("WARNING: relay frame overflowed, not sent.\n");
+			sv_relay_overflowed = svs.spawncount;
+		}
+
+		return;
+	}
+
+	for (offset = 0; offset < frame.cursize; offset += len)
+	{
+		len = Q_min(frame.cursize - offset, FRAGMENT_SIZE);
+
+		SZ_Init(&msg, sv_relay_buf, sizeof(sv_relay_buf));
+
+		MSG_WriteLong(&msg, -1);
+		SZ_Write(&msg, "relayframe\n", 11);
+		MSG_WriteLong(&msg, svs.spawncount);
+		MSG_WriteLong(&msg, sv.configstrings_version);
+		MSG_WriteLong(&msg, sv.framenum);
+		MSG_WriteLong(&msg, offset);
+		MSG_WriteLong(&msg, frame.cursize);
+		SZ_Write(&msg, frame.data + offset, len);
+
+		for (i = 0, r = sv_relays; i < MAX_RELAYS; i++, r++)
+		{
+			if (r->active)
+			{
+				NET_SendPacket(NS_SERVER, msg.cursize, msg.data, r->adr);
+			}
+		}
+	}
+}
+
+void
+SV_RelayInit(void)
+{
+	sv_relay_password = Cvar_Get("sv_relay_password", "", 0);
+}
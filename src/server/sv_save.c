@@ -239,6 +239,7 @@ SV_ReadLevelFile(void)
 	}
 
 	FS_Read(sv.configstrings, sizeof(sv.configstrings), f);
+	SV_RehashConfigstrings();
 	CM_ReadPortalState(f);
 	FS_FCloseFile(f);
 
@@ -25,6 +25,7 @@
  */
 
 #include "header/server.h"
+#include "../common/unzip/miniz/miniz.h"
 
 /* entnum and channel are sent in the same signed 16-bit value
    3 bits for channel, 13 for entnum, so limit is 4096
@@ -134,37 +135,79 @@ SV_BroadcastCommand(const char *fmt, ...)
 }
 
 /*
- * Sends the contents of sv.multicast to a subset of the clients,
- * then clears sv.multicast.
- *
- * MULTICAST_ALL	same as broadcast (origin can be NULL)
- * MULTICAST_PVS	send to clients potentially visible from org
- * MULTICAST_PHS	send to clients potentially hearable from org
+ * Per source cluster masks of the clients that can see or hear
+ * it. 'clients' has the clients whose origin is in the PVS / PHS,
+ * 'raised' those in water whose origin + 32 units is. The masks
+ * are rebuilt lazily after a client changed its cluster.
  */
-static qboolean
-SV_WereConnected(const vec3_t origin, const byte *mask, int area1)
+typedef struct
 {
-	vec3_t origin2;
-	int leafnum;
-	int cluster;
+	int generation;
+	unsigned clients[MAX_CLIENTS / 32];
+	unsigned raised[MAX_CLIENTS / 32];
+} multicastmask_t;
+
+/* numclusters PVS masks followed by numclusters PHS masks */
+static multicastmask_t *multicast_masks;
+static int multicast_numclusters;
+static int multicast_spawncount;
+static int multicast_map;         /* bumped on map change */
+static int multicast_generation;  /* bumped when a client changes cluster */
 
-	VectorCopy(origin, origin2);
+static void
+SV_MulticastCheckMap(void)
+{
+	if (multicast_masks && (multicast_spawncount == svs.spawncount) &&
+		(multicast_numclusters == CM_NumClusters()))
+	{
+		return;
+	}
+
+	if (multicast_masks)
+	{
+		Z_Free(multicast_masks);
+	}
 
-	leafnum = CM_PointLeafnum(origin2);
-	cluster = CM_LeafCluster(leafnum);
+	multicast_numclusters = CM_NumClusters();
+	multicast_spawncount = svs.spawncount;
+	multicast_masks = Z_Malloc(sizeof(multicastmask_t) * 2 *
+			(multicast_numclusters ? multicast_numclusters : 1));
 
-	// cluster can be -1 if we're in the void (or sometimes just at a wall)
-	// and using a negative index into mask[] would be invalid
-	if (cluster >= 0 && (mask[cluster >> 3] & (1 << (cluster & 7))))
+	/* 0 is the value of a fresh client */
+	if (++multicast_map == 0)
 	{
-		if (CM_AreasConnected(area1, CM_LeafArea(leafnum)))
-		{
-			return true;
-		}
+		multicast_map++;
+	}
+
+	multicast_generation++;
+}
+
+/*
+ * Refreshes the cached leaf data of a client if
+ * it moved since the last multicast.
+ */
+static void
+SV_MulticastUpdateClient(client_t *client)
+{
+	vec3_t origin;
+	int leafnum, cluster[2], area[2];
+
+	VectorCopy(CL_EDICT(client)->s.origin, origin);
+
+	if ((client->multicast_map == multicast_map) &&
+		VectorCompare(origin, client->multicast_origin))
+	{
+		return;
 	}
 
+	leafnum = CM_PointLeafnum(origin);
+	cluster[0] = CM_LeafCluster(leafnum);
+	area[0] = CM_LeafArea(leafnum);
+	cluster[1] = -1;
+	area[1] = 0;
+
 	// if the client is currently in water, do a second check
-	if (CM_PointContents(origin2, 0) & MASK_WATER)
+	if (CM_PointContents(origin, 0) & MASK_WATER)
 	{
 		// if the client is half-submerged in opaque water so its origin
 		// is below the water, but the head/camera is still above the water
@@ -173,30 +216,121 @@ SV_WereConnected(const vec3_t origin, const byte *mask, int area1)
 		// so try again at a slightly higher position
 		// FIXME: OTOH, we have a similar problem if we're over water and shoot under water (near water level) => can't see explosion
 
-		origin2[2] += 32.0f;
+		origin[2] += 32.0f;
+
+		leafnum = CM_PointLeafnum(origin);
+		cluster[1] = CM_LeafCluster(leafnum);
+		area[1] = CM_LeafArea(leafnum);
+	}
+
+	if ((client->multicast_map != multicast_map) ||
+		(client->multicast_cluster[0] != cluster[0]) ||
+		(client->multicast_cluster[1] != cluster[1]))
+	{
+		multicast_generation++;
+	}
+
+	client->multicast_map = multicast_map;
+	VectorCopy(CL_EDICT(client)->s.origin, client->multicast_origin);
+	client->multicast_cluster[0] = cluster[0];
+	client->multicast_cluster[1] = cluster[1];
+	client->multicast_area[0] = area[0];
+	client->multicast_area[1] = area[1];
+}
+
+static void
+SV_MulticastBuildMask(multicastmask_t *m, const byte *vis)
+{
+	int j, cluster;
+	client_t *client;
 
-		leafnum = CM_PointLeafnum(origin2);
-		cluster = CM_LeafCluster(leafnum);
+	memset(m, 0, sizeof(*m));
 
-		if (cluster >= 0 && (mask[cluster >> 3] & (1 << (cluster & 7))))
+	for (j = 0, client = svs.clients; j < maxclients->value; j++, client++)
+	{
+		if (client->multicast_map != multicast_map)
 		{
-			if (CM_AreasConnected(area1, CM_LeafArea(leafnum)))
-			{
-				return true;
-			}
+			continue;
+		}
+
+		// cluster can be -1 if we're in the void (or sometimes just at a wall)
+		// and using a negative index into vis[] would be invalid
+		cluster = client->multicast_cluster[0];
+
+		if ((cluster >= 0) && (vis[cluster >> 3] & (1 << (cluster & 7))))
+		{
+			m->clients[j >> 5] |= 1u << (j & 31);
+		}
+
+		cluster = client->multicast_cluster[1];
+
+		if ((cluster >= 0) && (vis[cluster >> 3] & (1 << (cluster & 7))))
+		{
+			m->raised[j >> 5] |= 1u << (j & 31);
 		}
 	}
 
-	return false;
+	m->generation = multicast_generation;
+}
+
+/*
+ * Returns the mask of clients that can see (PVS) or
+ * hear (PHS) the given cluster.
+ */
+static const multicastmask_t *
+SV_MulticastMask(int cluster, qboolean phs)
+{
+	static multicastmask_t uncached;
+	multicastmask_t *m;
+	int j;
+
+	SV_MulticastCheckMap();
+
+	for (j = 0; j < maxclients->value; j++)
+	{
+		if ((svs.clients[j].state != cs_free) &&
+			(svs.clients[j].state != cs_zombie))
+		{
+			SV_MulticastUpdateClient(&svs.clients[j]);
+		}
+	}
+
+	/* outside of the map, or no vis data */
+	if ((cluster < 0) || (cluster >= multicast_numclusters))
+	{
+		m = &uncached;
+		SV_MulticastBuildMask(m, phs ?
+				CM_ClusterPHS(cluster) : CM_ClusterPVS(cluster));
+		return m;
+	}
+
+	m = &multicast_masks[(phs ? multicast_numclusters : 0) + cluster];
+
+	if (m->generation != multicast_generation)
+	{
+		SV_MulticastBuildMask(m, phs ?
+				CM_ClusterPHS(cluster) : CM_ClusterPVS(cluster));
+	}
+
+	return m;
 }
 
+/*
+ * Sends the contents of sv.multicast to a subset of the clients,
+ * then clears sv.multicast.
+ *
+ * MULTICAST_ALL	same as broadcast (origin can be NULL)
+ * MULTICAST_PVS	send to clients potentially visible from org
+ * MULTICAST_PHS	send to clients potentially hearable from org
+ */
 void
 SV_Multicast(vec3_t origin, multicast_t to)
 {
-	int leafnum, cluster, area1 = 0, j;
+	int leafnum, area1 = 0, j;
 	qboolean reliable;
 	client_t *client;
-	byte *mask;
+	const multicastmask_t *mask;
+	unsigned bit;
 
 	reliable = false;
 
@@ -206,8 +340,8 @@ SV_Multicast(vec3_t origin, multicast_t to)
 		area1 = CM_LeafArea(leafnum);
 	}
 
-	/* if doing a serverrecord, store everything */
-	if (svs.demofile)
+	/* if doing a serverrecord or relaying, store everything */
+	if (svs.demofile || SV_RelayActive())
 	{
 		SZ_Write(&svs.demo_multicast, sv.multicast.data, sv.multicast.cursize);
 	}
@@ -223,17 +357,13 @@ SV_Multicast(vec3_t origin, multicast_t to)
 		case MULTICAST_PHS_R:
 			reliable = true; /* intentional fallthrough */
 		case MULTICAST_PHS:
-			leafnum = CM_PointLeafnum(origin);
-			cluster = CM_LeafCluster(leafnum);
-			mask = CM_ClusterPHS(cluster);
+			mask = SV_MulticastMask(CM_LeafCluster(leafnum), true);
 			break;
 
 		case MULTICAST_PVS_R:
 			reliable = true; /* intentional fallthrough */
 		case MULTICAST_PVS:
-			leafnum = CM_PointLeafnum(origin);
-			cluster = CM_LeafCluster(leafnum);
-			mask = CM_ClusterPVS(cluster);
+			mask = SV_MulticastMask(CM_LeafCluster(leafnum), false);
 			break;
 
 		default:
@@ -245,22 +375,35 @@ SV_Multicast(vec3_t origin, multicast_t to)
 	/* send the data to all relevent clients */
 	for (j = 0, client = svs.clients; j < maxclients->value; j++, client++)
 	{
-		if ((client->state == cs_free) || (client->state == cs_zombie))
+		if (mask)
 		{
-			continue;
+			/* skip the whole word if nobody in it is interested */
+			if (!(j & 31) && !(mask->clients[j >> 5] | mask->raised[j >> 5]))
+			{
+				j += 31;
+				client += 31;
+				continue;
+			}
+
+			bit = 1u << (j & 31);
+
+			if (!((mask->clients[j >> 5] & bit) &&
+					CM_AreasConnected(area1, client->multicast_area[0])) &&
+				!((mask->raised[j >> 5] & bit) &&
+					CM_AreasConnected(area1, client->multicast_area[1])))
+			{
+				continue;
+			}
 		}
 
-		if ((client->state != cs_spawned) && !reliable)
+		if ((client->state == cs_free) || (client->state == cs_zombie))
 		{
 			continue;
 		}
 
-		if (mask)
+		if ((client->state != cs_spawned) && !reliable)
 		{
-			if (!SV_WereConnected(CL_EDICT(client)->s.origin, mask, area1))
-			{
-				continue;
-			}
+			continue;
 		}
 
 		SZ_Write(reliable ? &client->netchan.message : &client->datagram,
@@ -455,6 +598,12 @@ SV_StartSound(vec3_t origin, edict_t *entity, int channel, int soundindex,
 static int msgbuff_size = 0;
 static byte *msgbuff_cache = NULL;
 
+/* svc_zframe, dictframe, size and compressed size */
+#define ZFRAME_HEADER_SIZE 11
+
+static tdefl_compressor *zframe_deflate;
+static byte zframe_buf[MAX_MSGLEN];
+
 static byte *
 SV_SendReallocBuffers(int *num)
 {
@@ -504,6 +653,124 @@ SV_SendFreeBuffers(void)
 		msgbuff_cache = NULL;
 	}
 	msgbuff_size = 0;
+
+	if (zframe_deflate)
+	{
+		free(zframe_deflate);
+		zframe_deflate = NULL;
+	}
+
+	if (multicast_masks)
+	{
+		Z_Free(multicast_masks);
+		multicast_masks = NULL;
+	}
+}
+
+/*
+ * Compressed frames. Every frame is compressed on its own, the
+ * packets may get lost. The deflate window is primed with the tail
+ * of the compressed frame the client acknowledged last instead,
+ * most of the frame is the same as then. The compressor workspace
+ * is shared, only the dictionaries are kept per client.
+ */
+static void
+SV_CompressFrame(client_t *client, sizebuf_t *msg)
+{
+	zframedict_t *zd;
+	size_t inlen, outlen;
+	int dictframe, slot, len;
+	tdefl_status status;
+	mz_uint flags;
+
+	zd = client->zdict;
+	slot = sv.framenum & UPDATE_MASK;
+	zd->dictframe[slot] = -1;
+
+	if ((sv_compressframes->value <= 0) ||
+		(msg->cursize < sv_compressframes->value) ||
+		(msg->cursize > MAX_ZFRAME_SIZE) || msg->overflowed)
+	{
+		return;
+	}
+
+	if (!zframe_deflate)
+	{
+		zframe_deflate = malloc(sizeof(tdefl_compressor));
+		YQ2_COM_CHECK_OOM(zframe_deflate, "malloc()", sizeof(tdefl_compressor))
+
+		if (!zframe_deflate)
+		{
+			return;
+		}
+	}
+
+	SV_ProfileBegin(SVP_COMPRESSFRAMES);
+
+	/* the stale hash entries are harmless,
+	   skip clearing them for every frame */
+	tdefl_init(zframe_deflate, NULL, NULL,
+			tdefl_create_comp_flags_from_zip_params(MZ_BEST_SPEED,
+				-MZ_DEFAULT_WINDOW_BITS, MZ_DEFAULT_STRATEGY) |
+			TDEFL_NONDETERMINISTIC_PARSING_FLAG);
+
+	/* same rules as for the delta frame */
+	dictframe = client->lastframe;
+
+	if ((dictframe <= 0) ||
+		(sv.framenum - dictframe >= (UPDATE_BACKUP - 3)) ||
+		(zd->dictframe[dictframe & UPDATE_MASK] != dictframe))
+	{
+		dictframe = -1;
+	}
+
+	if (dictframe > 0)
+	{
+		/* only the history matters, the output is thrown
+		   away up to the sync flush. Stored blocks spare
+		   the match search and the huffman tables. */
+		flags = zframe_deflate->m_flags;
+		zframe_deflate->m_flags |= TDEFL_FORCE_ALL_RAW_BLOCKS;
+
+		inlen = zd->dictlen[dictframe & UPDATE_MASK];
+		outlen = sizeof(zframe_buf);
+
+		tdefl_compress(zframe_deflate, zd->dict[dictframe & UPDATE_MASK],
+				&inlen, zframe_buf, &outlen, TDEFL_SYNC_FLUSH);
+
+		zframe_deflate->m_flags = flags;
+	}
+
+	inlen = msg->cursize;
+	outlen = sizeof(zframe_buf);
+
+	status = tdefl_compress(zframe_deflate, msg->data, &inlen,
+			zframe_buf, &outlen, TDEFL_FINISH);
+
+	SV_ProfileEnd(SVP_COMPRESSFRAMES);
+
+	/* not worth it or too big for a message */
+	if ((status != TDEFL_STATUS_DONE) ||
+		(outlen + ZFRAME_HEADER_SIZE >= msg->cursize) ||
+		(outlen + ZFRAME_HEADER_SIZE > MAX_MSGLEN - 16))
+	{
+		return;
+	}
+
+	/* keep the tail as dictionary for the next frames */
+	len = msg->cursize < ZFRAME_DICT_SIZE ? msg->cursize : ZFRAME_DICT_SIZE;
+	memcpy(zd->dict[slot], msg->data + msg->cursize - len, len);
+	zd->dictlen[slot] = len;
+	zd->dictframe[slot] = sv.framenum;
+
+	len = msg->cursize;
+	SZ_Clear(msg);
+
+	MSG_WriteByte(msg, svc_zframe);
+	MSG_WriteLong(msg, dictframe);
+	MSG_WriteLong(msg, len);
+	MSG_WriteShort(msg, (int)outlen);
+	SZ_Write(msg, zframe_buf, (int)outlen);
 }
 
 static qboolean
@@ -525,6 +792,11 @@ SV_SendClientDatagram(client_t *client)
 	   and the player_state_t */
 	SV_WriteFrameToClient(client, &msg);
 
+	if (client->zframe)
+	{
+		SV_CompressFrame(client, &msg);
+	}
+
 	/* copy the accumulated multicast datagram
 	   for this client out to the message
 	   it is necessary for this to be after the WriteEntities
@@ -680,6 +952,8 @@ SV_SendClientMessages(void)
 		msglen = 0;
 	}
 
+	SV_BeginClientFrames();
+
 	/* send a message to each spawned client */
 	for (i = 0, c = svs.clients; i < maxclients->value; i++, c++)
 	{
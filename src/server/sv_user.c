@@ -147,6 +147,209 @@ PrintOverflowConfigstrings(void)
 	}
 }
 
+/*
+ * The configstrings and baselines are serialized once per protocol
+ * and shared by all connecting clients. Each client just copies the
+ * next slice of the blob into its message. The item offsets keep
+ * the 'configstrings' and 'baselines' commands index based, like
+ * the clients expect them.
+ */
+#define GAMESTATE_PROTOCOLS 4
+
+typedef struct
+{
+	int protocol;
+	int spawncount;
+	int version;    /* sv.configstrings_version when built */
+	int count;
+	int *offsets;   /* [count + 1] start of each item in data */
+	byte *data;
+} gamestate_t;
+
+static gamestate_t sv_configstrings_blobs[GAMESTATE_PROTOCOLS];
+static gamestate_t sv_baselines_blobs[GAMESTATE_PROTOCOLS];
+
+static void
+SV_WriteConfigstringItem(sizebuf_t *msg, int index, int protocol)
+{
+	const char *cs;
+
+	cs = sv.configstrings[index];
+
+	if (*cs != '\0')
+	{
+		MSG_WriteByte(msg, svc_configstring);
+		/* start in native server range */
+		MSG_WriteConfigString(msg,
+			P_ConvertConfigStringTo(index, protocol), cs);
+	}
+}
+
+static void
+SV_WriteBaselineItem(sizebuf_t *msg, int index, int protocol)
+{
+	entity_xstate_t *base;
+
+	base = &sv.baselines[index];
+
+	if (base->modelindex || base->sound || base->effects)
+	{
+		MSG_WriteByte(msg, svc_spawnbaseline);
+		MSG_WriteDeltaEntity(NULL, base, msg, true, true, protocol);
+	}
+}
+
+static void
+SV_FreeGamestateBlob(gamestate_t *blob)
+{
+	if (blob->offsets)
+	{
+		Z_Free(blob->offsets);
+	}
+
+	if (blob->data)
+	{
+		Z_Free(blob->data);
+	}
+
+	memset(blob, 0, sizeof(*blob));
+}
+
+/*
+ * Returns the blob for the protocol, (re)building it if needed.
+ * Written in two passes, first to get the item sizes, second into
+ * the allocated blob.
+ */
+static const gamestate_t *
+SV_GetGamestateBlob(gamestate_t *blobs, int protocol, int count, int version,
+		void (*write)(sizebuf_t *msg, int index, int protocol))
+{
+	static byte buf[MAX_MSGLEN];
+	gamestate_t *blob;
+	sizebuf_t msg;
+	int i;
+
+	blob = NULL;
+
+	for (i = 0; i < GAMESTATE_PROTOCOLS; i++)
+	{
+		if (blobs[i].offsets && (blobs[i].protocol == protocol))
+		{
+			blob = &blobs[i];
+			break;
+		}
+	}
+
+	if (blob && (blob->spawncount == svs.spawncount) &&
+		(blob->version == version) && (blob->count == count))
+	{
+		return blob;
+	}
+
+	if (!blob)
+	{
+		/* a free slot, or the one with the stalest data */
+		blob = &blobs[0];
+
+		for (i = 0; i < GAMESTATE_PROTOCOLS; i++)
+		{
+			if (!blobs[i].offsets)
+			{
+				blob = &blobs[i];
+				break;
+			}
+
+			if (blobs[i].spawncount != svs.spawncount)
+			{
+				blob = &blobs[i];
+			}
+		}
+	}
+
+	SV_FreeGamestateBlob(blob);
+
+	blob->protocol = protocol;
+	blob->spawncount = svs.spawncount;
+	blob->version = version;
+	blob->count = count;
+	blob->offsets = Z_Malloc((count + 1) * sizeof(int));
+
+	for (i = 0; i < count; i++)
+	{
+		SZ_Init(&msg, buf, sizeof(buf));
+		write(&msg, i, protocol);
+		blob->offsets[i + 1] = blob->offsets[i] + msg.cursize;
+	}
+
+	blob->data = Z_Malloc(blob->offsets[count] ? blob->offsets[count] : 1);
+	SZ_Init(&msg, blob->data, blob->offsets[count] ? blob->offsets[count] : 1);
+
+	for (i = 0; i < count; i++)
+	{
+		write(&msg, i, protocol);
+	}
+
+	return blob;
+}
+
+/*
+ * Copies as many items from start on as fit below
+ * the limit into the message. Returns the next item.
+ */
+static int
+SV_SendGamestateBlob(const gamestate_t *blob, int start, sizebuf_t *msg,
+		int limit)
+{
+	int end;
+
+	if (start > blob->count)
+	{
+		start = blob->count;
+	}
+
+	end = start;
+
+	while ((end < blob->count) &&
+		((msg->cursize + blob->offsets[end + 1] - blob->offsets[start]) <= limit))
+	{
+		end++;
+	}
+
+	if (end > start)
+	{
+		SZ_Write(msg, blob->data + blob->offsets[start],
+				blob->offsets[end] - blob->offsets[start]);
+	}
+
+	return end;
+}
+
+/*
+ * Writes the configstrings from start on into the message,
+ * as far as they fit below the limit. Returns the next one.
+ */
+int
+SV_WriteConfigstrings(sizebuf_t *msg, int protocol, int start, int limit)
+{
+	return SV_SendGamestateBlob(
+		SV_GetGamestateBlob(sv_configstrings_blobs, protocol,
+			MAX_CONFIGSTRINGS, sv.configstrings_version,
+			SV_WriteConfigstringItem),
+		start, msg, limit);
+}
+
+void
+SV_FreeGamestate(void)
+{
+	int i;
+
+	for (i = 0; i < GAMESTATE_PROTOCOLS; i++)
+	{
+		SV_FreeGamestateBlob(&sv_configstrings_blobs[i]);
+		SV_FreeGamestateBlob(&sv_baselines_blobs[i]);
+	}
+}
+
 static void
 SV_Configstrings_f(void)
 {
@@ -181,28 +384,12 @@ SV_Configstrings_f(void)
 		SAFE_MARGIN : 560;
 
 	/* write a packet full of data */
-	while (start < MAX_CONFIGSTRINGS)
-	{
-		const char *cs;
-
-		cs = sv.configstrings[start];
-
-		if (*cs != '\0')
-		{
-			if ((sv_client->netchan.message.cursize + MSG_ConfigString_Size(cs))
-				> (MAX_MSGLEN - (CMD_MARGIN + max_msgutil)))
-			{
-				break;
-			}
-
-			MSG_WriteByte(&sv_client->netchan.message, svc_configstring);
-			/* start in native server range */
-			MSG_WriteConfigString(&sv_client->netchan.message,
-				P_ConvertConfigStringTo(start, sv_client->protocol), cs);
-		}
-
-		start++;
-	}
+	start = SV_SendGamestateBlob(
+		SV_GetGamestateBlob(sv_configstrings_blobs, sv_client->protocol,
+			MAX_CONFIGSTRINGS, sv.configstrings_version,
+			SV_WriteConfigstringItem),
+		start, &sv_client->netchan.message,
+		MAX_MSGLEN - (CMD_MARGIN + max_msgutil));
 
 	/* send next command */
 	if (start == MAX_CONFIGSTRINGS)
@@ -255,29 +442,11 @@ SV_Baselines_f(void)
 		SAFE_MARGIN : 560;
 
 	/* write a packet full of data */
-	while (start < sv.numbaselines)
-	{
-		entity_xstate_t *base;
-
-		base = &sv.baselines[start];
-
-		if (base->modelindex || base->sound || base->effects)
-		{
-			if ((sv_client->netchan.message.cursize +
-				MSG_DeltaEntity_Size(NULL, base, true, true, sv_client->protocol))
-				> (MAX_MSGLEN - (CMD_MARGIN + max_msgutil)))
-			{
-				break;
-			}
-
-			MSG_WriteByte(&sv_client->netchan.message, svc_spawnbaseline);
-			MSG_WriteDeltaEntity(NULL, base,
-					&sv_client->netchan.message,
-					true, true, sv_client->protocol);
-		}
-
-		start++;
-	}
+	start = SV_SendGamestateBlob(
+		SV_GetGamestateBlob(sv_baselines_blobs, sv_client->protocol,
+			sv.numbaselines, 0, SV_WriteBaselineItem),
+		start, &sv_client->netchan.message,
+		MAX_MSGLEN - (CMD_MARGIN + max_msgutil));
 
 	/* send next command */
 	if (start == sv.numbaselines)
@@ -315,6 +484,121 @@ SV_Begin_f(void)
 	Cbuf_InsertFromDefer();
 }
 
+/* files currently being downloaded */
+static svdownload_t *sv_downloads;
+
+/*
+ * Returns the shared copy of a file, loading it
+ * if nobody else is downloading it right now.
+ */
+static svdownload_t *
+SV_OpenDownload(const char *name)
+{
+	extern qboolean file_from_protected_pak;
+	svdownload_t *dl;
+	byte *data;
+	int size;
+
+	for (dl = sv_downloads; dl; dl = dl->next)
+	{
+		if (!strcmp(dl->name, name))
+		{
+			dl->refcount++;
+			return dl;
+		}
+	}
+
+	if (strlen(name) >= sizeof(dl->name))
+	{
+		return NULL;
+	}
+
+	size = FS_LoadFile(name, (void **)&data);
+
+	if (!data)
+	{
+		return NULL;
+	}
+
+	dl = Z_Malloc(sizeof(*dl));
+	Q_strlcpy(dl->name, name, sizeof(dl->name));
+	dl->data = data;
+	dl->size = size;
+	dl->refcount = 1;
+	dl->protectedpak = file_from_protected_pak;
+	dl->next = sv_downloads;
+	sv_downloads = dl;
+
+	return dl;
+}
+
+/*
+ * Stops the download of a client, the file
+ * is freed when the last client is done.
+ */
+void
+SV_CloseDownload(client_t *cl)
+{
+	svdownload_t **prev;
+	svdownload_t *dl;
+
+	dl = cl->download;
+
+	if (!dl)
+	{
+		return;
+	}
+
+	cl->download = NULL;
+
+	if (--dl->refcount > 0)
+	{
+		return;
+	}
+
+	for (prev = &sv_downloads; *prev; prev = &(*prev)->next)
+	{
+		if (*prev == dl)
+		{
+			*prev = dl->next;
+			break;
+		}
+	}
+
+	FS_FreeFile(dl->data);
+	Z_Free(dl);
+}
+
+/*
+ * Stops all downloads and frees the shared files, called
+ * on shutdown. A gamedir change always shuts down first,
+ * so no file survives it. Downloads go on over map
+ * changes, the client keeps asking for the next part.
+ */
+void
+SV_FreeDownloads(void)
+{
+	svdownload_t *dl;
+	int i;
+
+	if (svs.clients)
+	{
+		for (i = 0; i < maxclients->value; i++)
+		{
+			SV_CloseDownload(&svs.clients[i]);
+		}
+	}
+
+	while (sv_downloads)
+	{
+		dl = sv_downloads;
+		sv_downloads = dl->next;
+
+		FS_FreeFile(dl->data);
+		Z_Free(dl);
+	}
+}
+
 static void
 SV_NextDownload_f(void)
 {
@@ -348,15 +632,14 @@ SV_NextDownload_f(void)
 	percent = sv_client->downloadcount * 100 / size;
 	MSG_WriteByte(&sv_client->netchan.message, percent);
 	SZ_Write(&sv_client->netchan.message,
-			sv_client->download + sv_client->downloadcount - r, r);
+			sv_client->download->data + sv_client->downloadcount - r, r);
 
 	if (sv_client->downloadcount != sv_client->downloadsize)
 	{
 		return;
 	}
 
-	FS_FreeFile(sv_client->download);
-	sv_client->download = NULL;
+	SV_CloseDownload(sv_client);
 }
 
 static void
@@ -368,7 +651,6 @@ SV_BeginDownload_f(void)
 	extern cvar_t *allow_download_models;
 	extern cvar_t *allow_download_sounds;
 	extern cvar_t *allow_download_maps;
-	extern qboolean file_from_protected_pak;
 	int offset = 0;
 
 	name = Cmd_Argv(1);
@@ -402,28 +684,16 @@ SV_BeginDownload_f(void)
 		return;
 	}
 
-	if (sv_client->download)
-	{
-		FS_FreeFile(sv_client->download);
-	}
-
-	sv_client->downloadsize = FS_LoadFile(name, (void **)&sv_client->download);
-	sv_client->downloadcount = offset;
+	SV_CloseDownload(sv_client);
 
-	if (offset > sv_client->downloadsize)
-	{
-		sv_client->downloadcount = sv_client->downloadsize;
-	}
+	sv_client->download = SV_OpenDownload(name);
 
-	if (!sv_client->download || ((strncmp(name, "maps/", 5) == 0) && file_from_protected_pak))
+	if (!sv_client->download || ((strncmp(name, "maps/", 5) == 0) &&
+		sv_client->download->protectedpak))
 	{
 		Com_DPrintf("Couldn't download %s to %s\n", name, sv_client->name);
 
-		if (sv_client->download)
-		{
-			FS_FreeFile(sv_client->download);
-			sv_client->download = NULL;
-		}
+		SV_CloseDownload(sv_client);
 
 		MSG_WriteByte(&sv_client->netchan.message, svc_download);
 		MSG_WriteShort(&sv_client->netchan.message, -1);
@@ -431,6 +701,18 @@ SV_BeginDownload_f(void)
 		return;
 	}
 
+	sv_client->downloadsize = sv_client->download->size;
+	sv_client->downloadcount = offset;
+
+	if (offset < 0)
+	{
+		sv_client->downloadcount = 0;
+	}
+	else if (offset > sv_client->downloadsize)
+	{
+		sv_client->downloadcount = sv_client->downloadsize;
+	}
+
 	SV_NextDownload_f();
 	Com_DPrintf("Downloading %s to %s\n", name, sv_client->name);
 }
@@ -638,7 +920,7 @@ SV_ExecuteClientMessage(client_t *cl)
 					if (cl->lastframe > 0)
 					{
 						cl->frame_latency[cl->lastframe & (LATENCY_COUNTS - 1)] =
-							svs.realtime - cl->frames[cl->lastframe & UPDATE_MASK].senttime;
+							NET_PacketTime() - cl->frames[cl->lastframe & UPDATE_MASK].senttime;
 					}
 				}
 
@@ -45,10 +45,19 @@ typedef struct areanode_s
 areanode_t sv_areanodes[AREA_NODES];
 int sv_numareanodes;
 
-float *area_mins, *area_maxs;
-edict_t **area_list;
-int area_count, area_maxcount;
-int area_type;
+/* one SV_AreaEdicts() query, on the stack
+   so that traces can run on several threads */
+typedef struct
+{
+	const float *mins, *maxs;
+	edict_t **list;
+	int count, maxcount;
+	int type;
+	qboolean overflowed;
+} areaquery_t;
+
+/* the box hull is shared, reentrant traces take turns */
+static sys_mutex_t *sv_boxhull_mutex;
 
 static int SV_HullForEntity(edict_t *ent);
 
@@ -126,6 +135,11 @@ SV_CreateAreaNode(int depth, vec3_t mins, vec3_t maxs)
 void
 SV_ClearWorld(void)
 {
+	if (!sv_boxhull_mutex)
+	{
+		sv_boxhull_mutex = Sys_CreateMutex();
+	}
+
 	memset(sv_areanodes, 0, sizeof(sv_areanodes));
 	sv_numareanodes = 0;
 	if (sv.models[1])
@@ -404,13 +418,13 @@ SV_LinkEdict(edict_t *ent)
 }
 
 static void
-SV_AreaEdicts_r(areanode_t *node)
+SV_AreaEdicts_r(areaquery_t *q, areanode_t *node)
 {
 	link_t *l, *next, *start;
 	edict_t *check;
 
 	/* touch linked edicts */
-	if (area_type == AREA_SOLID)
+	if (q->type == AREA_SOLID)
 	{
 		start = &node->solid_edicts;
 	}
@@ -429,24 +443,24 @@ SV_AreaEdicts_r(areanode_t *node)
 			continue; /* deactivated */
 		}
 
-		if ((check->absmin[0] > area_maxs[0]) ||
-			(check->absmin[1] > area_maxs[1]) ||
-			(check->absmin[2] > area_maxs[2]) ||
-			(check->absmax[0] < area_mins[0]) ||
-			(check->absmax[1] < area_mins[1]) ||
-			(check->absmax[2] < area_mins[2]))
+		if ((check->absmin[0] > q->maxs[0]) ||
+			(check->absmin[1] > q->maxs[1]) ||
+			(check->absmin[2] > q->maxs[2]) ||
+			(check->absmax[0] < q->mins[0]) ||
+			(check->absmax[1] < q->mins[1]) ||
+			(check->absmax[2] < q->mins[2]))
 		{
 			continue; /* not touching */
 		}
 
-		if (area_count == area_maxcount)
+		if (q->count == q->maxcount)
 		{
-			Com_Printf("SV_AreaEdicts: MAXCOUNT\n");
+			q->overflowed = true;
 			return;
 		}
 
-		area_list[area_count] = check;
-		area_count++;
+		q->list[q->count] = check;
+		q->count++;
 	}
 
 	if (node->axis == -1)
@@ -455,37 +469,61 @@ SV_AreaEdicts_r(areanode_t *node)
 	}
 
 	/* recurse down both sides */
-	if (area_maxs[node->axis] > node->dist)
+	if (q->maxs[node->axis] > node->dist)
 	{
-		SV_AreaEdicts_r(node->children[0]);
+		SV_AreaEdicts_r(q, node->children[0]);
 	}
 
-	if (area_mins[node->axis] < node->dist)
+	if (q->mins[node->axis] < node->dist)
+	{
+		SV_AreaEdicts_r(q, node->children[1]);
+	}
+}
+
+/*
+ * Fills the caller's list, changes nothing else
+ * and may run on several threads.
+ */
+static int
+SV_AreaEdictsReentrant(const vec3_t mins, const vec3_t maxs, edict_t **list,
+		int maxcount, int areatype, qboolean *overflowed)
+{
+	areaquery_t q;
+
+	q.mins = mins;
+	q.maxs = maxs;
+	q.list = list;
+	q.count = 0;
+	q.maxcount = maxcount;
+	q.type = areatype;
+	q.overflowed = false;
+
+	SV_AreaEdicts_r(&q, sv_areanodes);
+
+	if (overflowed)
 	{
-		SV_AreaEdicts_r(node->children[1]);
+		*overflowed = q.overflowed;
 	}
+
+	return q.count;
 }
 
 int
 SV_AreaEdicts(vec3_t mins, vec3_t maxs, edict_t **list,
 		int maxcount, int areatype)
 {
-	area_mins = mins;
-	area_maxs = maxs;
-	area_list = list;
-	area_maxcount = maxcount;
-	area_type = areatype;
-	area_count = 0;
-
-	SV_AreaEdicts_r(sv_areanodes);
-
-	area_mins = 0;
-	area_maxs = 0;
-	area_list = 0;
-	area_maxcount = 0;
-	area_type = 0;
-
-	return area_count;
+	qboolean overflowed;
+	int count;
+
+	count = SV_AreaEdictsReentrant(mins, maxs, list, maxcount,
+			areatype, &overflowed);
+
+	if (overflowed)
+	{
+		Com_Printf("SV_AreaEdicts: MAXCOUNT\n");
+	}
+
+	return count;
 }
 
 int
@@ -526,6 +564,7 @@ typedef struct
 	trace_t trace;
 	const edict_t *passedict;
 	int contentmask;
+	qboolean reentrant;
 } moveclip_t;
 
 /*
@@ -558,6 +597,49 @@ SV_HullForEntity(edict_t *ent)
 	return CM_HeadnodeForBox(ent->mins, ent->maxs);
 }
 
+/*
+ * The exact clip of SV_ClipMoveToEntities()
+ * for reentrant traces.
+ */
+static trace_t
+SV_ClipMoveToEntityReentrant(const moveclip_t *clip, edict_t *touch)
+{
+	const float *mins, *maxs;
+	trace_t trace;
+	int headnode;
+
+	if (touch->svflags & SVF_MONSTER)
+	{
+		mins = clip->mins2;
+		maxs = clip->maxs2;
+	}
+	else
+	{
+		mins = clip->mins;
+		maxs = clip->maxs;
+	}
+
+	if (touch->solid == SOLID_BSP)
+	{
+		headnode = SV_HullForEntity(touch);
+
+		return CM_TransformedBoxTraceReentrant(clip->start, clip->end,
+				mins, maxs, headnode, clip->contentmask,
+				touch->s.origin, touch->s.angles);
+	}
+
+	Sys_LockMutex(sv_boxhull_mutex);
+
+	headnode = SV_HullForEntity(touch);
+	trace = CM_TransformedBoxTraceReentrant(clip->start, clip->end,
+			mins, maxs, headnode, clip->contentmask,
+			touch->s.origin, vec3_origin);
+
+	Sys_UnlockMutex(sv_boxhull_mutex);
+
+	return trace;
+}
+
 static void
 SV_ClipMoveToEntities(moveclip_t *clip)
 {
@@ -567,8 +649,16 @@ SV_ClipMoveToEntities(moveclip_t *clip)
 	int headnode;
 	float *angles;
 
-	num = SV_AreaEdicts(clip->boxmins, clip->boxmaxs, touchlist,
-			MAX_EDICTS, AREA_SOLID);
+	if (clip->reentrant)
+	{
+		num = SV_AreaEdictsReentrant(clip->boxmins, clip->boxmaxs,
+				touchlist, MAX_EDICTS, AREA_SOLID, NULL);
+	}
+	else
+	{
+		num = SV_AreaEdicts(clip->boxmins, clip->boxmaxs, touchlist,
+				MAX_EDICTS, AREA_SOLID);
+	}
 
 	/* be careful, it is possible to have an entity in this
 	   list removed before we get to it (killtriggered) */
@@ -610,26 +700,41 @@ SV_ClipMoveToEntities(moveclip_t *clip)
 			continue;
 		}
 
-		/* might intersect, so do an exact clip */
-		headnode = SV_HullForEntity(touch);
-		angles = touch->s.angles;
-
-		if (touch->solid != SOLID_BSP)
+		if (clip->reentrant)
 		{
-			angles = vec3_origin; /* boxes don't rotate */
-		}
+			/* box hulls are all CONTENTS_MONSTER, nothing
+			   else can hit them, so only these lock it */
+			if ((touch->solid != SOLID_BSP) &&
+				!(clip->contentmask & CONTENTS_MONSTER))
+			{
+				continue;
+			}
 
-		if (touch->svflags & SVF_MONSTER)
-		{
-			trace = CM_TransformedBoxTrace(clip->start, clip->end,
-					clip->mins2, clip->maxs2, headnode, clip->contentmask,
-					touch->s.origin, angles);
+			trace = SV_ClipMoveToEntityReentrant(clip, touch);
 		}
 		else
 		{
-			trace = CM_TransformedBoxTrace(clip->start, clip->end,
-					clip->mins, clip->maxs, headnode, clip->contentmask,
-					touch->s.origin, angles);
+			/* might intersect, so do an exact clip */
+			headnode = SV_HullForEntity(touch);
+			angles = touch->s.angles;
+
+			if (touch->solid != SOLID_BSP)
+			{
+				angles = vec3_origin; /* boxes don't rotate */
+			}
+
+			if (touch->svflags & SVF_MONSTER)
+			{
+				trace = CM_TransformedBoxTrace(clip->start, clip->end,
+						clip->mins2, clip->maxs2, headnode, clip->contentmask,
+						touch->s.origin, angles);
+			}
+			else
+			{
+				trace = CM_TransformedBoxTrace(clip->start, clip->end,
+						clip->mins, clip->maxs, headnode, clip->contentmask,
+						touch->s.origin, angles);
+			}
 		}
 
 		if (trace.allsolid || trace.startsolid ||
@@ -671,13 +776,10 @@ SV_TraceBounds(const vec3_t start, const vec3_t mins, const vec3_t maxs,
 	}
 }
 
-/*
- * Moves the given mins/maxs volume through the world from start to end.
- * Passedict and edicts owned by passedict are explicitly not checked.
- */
-trace_t
-SV_Trace(const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end,
-		const edict_t *passedict, int contentmask)
+static trace_t
+SV_TraceClip(const vec3_t start, const vec3_t mins, const vec3_t maxs,
+		const vec3_t end, const edict_t *passedict, int contentmask,
+		qboolean reentrant)
 {
 	moveclip_t clip;
 
@@ -694,7 +796,15 @@ SV_Trace(const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t
 	memset(&clip, 0, sizeof(moveclip_t));
 
 	/* clip to world */
-	clip.trace = CM_BoxTrace(start, end, mins, maxs, 0, contentmask);
+	if (reentrant)
+	{
+		clip.trace = CM_BoxTraceReentrant(start, end, mins, maxs, 0, contentmask);
+	}
+	else
+	{
+		clip.trace = CM_BoxTrace(start, end, mins, maxs, 0, contentmask);
+	}
+
 	clip.trace.ent = ge->edicts;
 
 	if (clip.trace.fraction == 0)
@@ -708,6 +818,7 @@ SV_Trace(const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t
 	clip.mins = mins;
 	clip.maxs = maxs;
 	clip.passedict = passedict;
+	clip.reentrant = reentrant;
 
 	VectorCopy(mins, clip.mins2);
 	VectorCopy(maxs, clip.maxs2);
@@ -722,3 +833,27 @@ SV_Trace(const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t
 	return clip.trace;
 }
 
+/*
+ * Moves the given mins/maxs volume through the world from start to end.
+ * Passedict and edicts owned by passedict are explicitly not checked.
+ */
+trace_t
+SV_Trace(const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end,
+		const edict_t *passedict, int contentmask)
+{
+	return SV_TraceClip(start, mins, maxs, end, passedict,
+			contentmask, false);
+}
+
+/*
+ * SV_Trace() for the workers of SV_RunParallel(), the result is
+ * the same. Nothing may link or unlink edicts meanwhile.
+ */
+trace_t
+SV_TraceReentrant(const vec3_t start, const vec3_t mins, const vec3_t maxs,
+		const vec3_t end, const edict_t *passedict, int contentmask)
+{
+	return SV_TraceClip(start, mins, maxs, end, passedict,
+			contentmask, true);
+}
+